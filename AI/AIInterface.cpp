@@ -67,8 +67,22 @@ void AIBase::SetAggression(int aggr)
 namespace {
     // stuff used in AIInterface, but not needed to be visible outside this file
 
+    // discards production locations cached while the AI generates orders,
+    // which may no longer be valid after orders are issued or meters change
+    void ClearProductionLocationCache() {
+        AIClientApp* app = AIClientApp::GetApp();
+        if (const Empire* empire = app->GetEmpire(app->EmpireID()))
+            empire->ClearProductionLocationCache();
+    }
+
+    void IssueOrder(OrderPtr order) {
+        ClearProductionLocationCache();
+        AIClientApp::GetApp()->Orders().IssueOrder(order);
+    }
+
     // start of turn initialization for meters
     void InitMeterEstimatesAndDiscrepancies() {
+        ClearProductionLocationCache();
         Universe& universe = AIClientApp::GetApp()->GetUniverse();
         universe.InitMeterEstimatesAndDiscrepancies();
     }
@@ -173,40 +187,50 @@ namespace AIInterface {
     }
 
     void UpdateMeterEstimates(bool pretend_unowned_planets_owned_by_this_ai_empire) {
-        std::vector<TemporaryPtr<Planet> > unowned_planets;
-        int player_id = -1;
+        ClearProductionLocationCache();
         Universe& universe = AIClientApp::GetApp()->GetUniverse();
-        if (pretend_unowned_planets_owned_by_this_ai_empire) {
-            // add this player ownership to all planets that the player can see but which aren't currently colonized.
-            // this way, any effects the player knows about that would act on those planets if the player colonized them
-            // include those planets in their scope.  This lets effects from techs the player knows alter the max
-            // population of planet that is displayed to the player, even if those effects have a condition that causes
-            // them to only act on planets the player owns (so as to not improve enemy planets if a player reseraches a
-            // tech that should only benefit him/herself)
-            player_id = AIInterface::PlayerID();
+        if (!pretend_unowned_planets_owned_by_this_ai_empire) {
+            universe.UpdateMeterEstimates();
+            return;
+        }
+
+        // add this player ownership to all planets that the player can see but which aren't currently colonized.
+        // this way, any effects the player knows about that would act on those planets if the player colonized them
+        // include those planets in their scope.  This lets effects from techs the player knows alter the max
+        // population of planet that is displayed to the player, even if those effects have a condition that causes
+        // them to only act on planets the player owns (so as to not improve enemy planets if a player reseraches a
+        // tech that should only benefit him/herself)
+        int player_id = AIInterface::PlayerID();
+
+        // the snapshot records which planets had ownership added, and
+        // removes it again when it goes out of scope.  meters estimated
+        // meanwhile are kept.
+        universe.InhibitUniverseObjectSignals(true);
+        {
+            UniverseSnapshot pretend_ownership(universe, false);
 
             // get all planets the player knows about that aren't yet colonized (aren't owned by anyone).  Add this
-            // the current player's ownership to all, while remembering which planets this is done to
+            // the current player's ownership to all
+            std::vector<int> unowned_object_ids;
             std::vector<TemporaryPtr<Planet> > all_planets = universe.Objects().FindObjects<Planet>();
-            universe.InhibitUniverseObjectSignals(true);
             for (std::vector<TemporaryPtr<Planet> >::iterator it = all_planets.begin(); it != all_planets.end(); ++it) {
                  TemporaryPtr<Planet> planet = *it;
                  if (planet->Unowned()) {
-                     unowned_planets.push_back(planet);
-                     planet->SetOwner(player_id);
+                     pretend_ownership.SetOwner(planet, player_id);
+                     unowned_object_ids.push_back(planet->ID());
+                     const std::set<int>& buildings = planet->ContainedObjectIDs();
+                     std::copy(buildings.begin(), buildings.end(), std::back_inserter(unowned_object_ids));
                  }
             }
-        }
-
-        // update meter estimates with temporary ownership
-        universe.UpdateMeterEstimates();
 
-        if (pretend_unowned_planets_owned_by_this_ai_empire) {
-            // remove temporary ownership added above
-            for (std::vector<TemporaryPtr<Planet> >::iterator it = unowned_planets.begin(); it != unowned_planets.end(); ++it)
-                (*it)->SetOwner(ALL_EMPIRES);
-            universe.InhibitUniverseObjectSignals(false);
+            // update meter estimates with temporary ownership.  only the
+            // planets given temporary ownership and their contents are
+            // re-estimated, rather than the whole universe; other objects
+            // keep the estimates they had.
+            if (!unowned_object_ids.empty())
+                universe.UpdateMeterEstimates(unowned_object_ids);
         }
+        universe.InhibitUniverseObjectSignals(false);
     }
 
     void UpdateResourcePools() {
@@ -255,7 +279,7 @@ namespace AIInterface {
         if (destination_id != INVALID_OBJECT_ID && destination_id == start_id)
             DebugLogger() << "AIInterface::IssueFleetMoveOrder : pass destination system id (" << destination_id << ") that fleet is already in";
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(new FleetMoveOrder(empire_id, fleet_id, start_id, destination_id)));
+        IssueOrder(OrderPtr(new FleetMoveOrder(empire_id, fleet_id, start_id, destination_id)));
 
         return 1;
     }
@@ -278,7 +302,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(new RenameOrder(empire_id, object_id, new_name)));
+        IssueOrder(OrderPtr(new RenameOrder(empire_id, object_id, new_name)));
 
         return 1;
     }
@@ -305,7 +329,7 @@ namespace AIInterface {
                     return 0;
                 }
 
-                AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(new ScrapOrder(empire_id, *it)));
+                IssueOrder(OrderPtr(new ScrapOrder(empire_id, *it)));
             }
 
             return 1;
@@ -362,7 +386,7 @@ namespace AIInterface {
 
         int new_fleet_id = ClientApp::GetApp()->GetNewObjectID();
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(new NewFleetOrder(empire_id, fleet_name, new_fleet_id, system_id, ship_ids)));
+        IssueOrder(OrderPtr(new NewFleetOrder(empire_id, fleet_name, new_fleet_id, system_id, ship_ids)));
 
         return new_fleet_id;
     }
@@ -413,7 +437,7 @@ namespace AIInterface {
 
         std::vector<int> ship_ids;
         ship_ids.push_back(ship_id);
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(new FleetTransferOrder(empire_id, new_fleet_id, ship_ids)));
+        IssueOrder(OrderPtr(new FleetTransferOrder(empire_id, new_fleet_id, ship_ids)));
 
         return 1;
     }
@@ -466,7 +490,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(new ColonizeOrder(empire_id, ship_id, planet_id)));
+        IssueOrder(OrderPtr(new ColonizeOrder(empire_id, ship_id, planet_id)));
 
         return 1;
     }
@@ -536,7 +560,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(new InvadeOrder(empire_id, ship_id, planet_id)));
+        IssueOrder(OrderPtr(new InvadeOrder(empire_id, ship_id, planet_id)));
 
         return 1;
     }
@@ -591,7 +615,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(new BombardOrder(empire_id, ship_id, planet_id)));
+        IssueOrder(OrderPtr(new BombardOrder(empire_id, ship_id, planet_id)));
 
         return 1;
     }
@@ -613,7 +637,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(
+        IssueOrder(OrderPtr(
             new AggressiveOrder(empire_id, object_id, aggressive)));
 
         return 1;
@@ -672,7 +696,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(
+        IssueOrder(OrderPtr(
             new GiveObjectToEmpireOrder(empire_id, object_id, recipient_id)));
 
         return 1;
@@ -695,7 +719,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(
+        IssueOrder(OrderPtr(
             new ChangeFocusOrder(empire_id, planet_id, focus)));
 
         return 1;
@@ -710,7 +734,7 @@ namespace AIInterface {
 
         int empire_id = AIClientApp::GetApp()->EmpireID();
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(
+        IssueOrder(OrderPtr(
             new ResearchQueueOrder(empire_id, tech_name, position)));
 
         return 1;
@@ -725,7 +749,7 @@ namespace AIInterface {
 
         int empire_id = AIClientApp::GetApp()->EmpireID();
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(new ResearchQueueOrder(empire_id, tech_name)));
+        IssueOrder(OrderPtr(new ResearchQueueOrder(empire_id, tech_name)));
 
         return 1;
     }
@@ -739,7 +763,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(
+        IssueOrder(OrderPtr(
             new ProductionQueueOrder(empire_id, BT_BUILDING, item_name, 1, location_id)));
 
         return 1;
@@ -754,7 +778,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(
+        IssueOrder(OrderPtr(
             new ProductionQueueOrder(empire_id, BT_SHIP, design_id, 1, location_id)));
 
         return 1;
@@ -774,7 +798,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(
+        IssueOrder(OrderPtr(
             new ProductionQueueOrder(empire_id, queue_index, new_quantity, new_blocksize)));
 
         return 1;
@@ -807,7 +831,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(
+        IssueOrder(OrderPtr(
             new ProductionQueueOrder(empire_id, old_queue_index, new_queue_index)));
 
         return 1;
@@ -823,7 +847,7 @@ namespace AIInterface {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(
+        IssueOrder(OrderPtr(
             new ProductionQueueOrder(empire_id, queue_index)));
 
         return 1;
@@ -855,7 +879,7 @@ namespace AIInterface {
         }
 
         int new_design_id = AIClientApp::GetApp()->GetNewDesignID();
-        AIClientApp::GetApp()->Orders().IssueOrder(OrderPtr(new ShipDesignOrder(empire_id, new_design_id, *design)));
+        IssueOrder(OrderPtr(new ShipDesignOrder(empire_id, new_design_id, *design)));
         delete design;
 
         return 1;
@@ -18,6 +18,7 @@
 #include <boost/mpl/vector.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/timer.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/python/list.hpp>
 #include <boost/python/extract.hpp>
 #include <boost/python/scope.hpp>
@@ -172,7 +173,7 @@ BOOST_PYTHON_MODULE(freeOrionAIInterface)
     def("getSaveStateString",       GetStaticSaveStateString,       return_value_policy<copy_const_reference>());
 
     def("doneTurn",                 AIInterface::DoneTurn);
-    def("userString",               make_function(&UserString,          return_value_policy<copy_const_reference>()));
+    def("userString",               make_function(static_cast<const std::string& (*)(const std::string&)>(&UserString), return_value_policy<copy_const_reference>()));
     def("userStringExists",         make_function(&UserStringExists,    return_value_policy<return_by_value>()));
     def("userStringList",           &GetUserStringList);
 
@@ -329,6 +330,13 @@ void PythonAI::GenerateOrders() {
     DebugLogger() << "PythonAI::GenerateOrders : initializing turn";
     AIInterface::InitTurn();
 
+    // the AI checks where many items can be produced while planning.  the
+    // cached locations are discarded whenever the AI issues an order or
+    // updates meter estimates.
+    boost::scoped_ptr<ScopedProductionLocationCaching> production_location_caching;
+    if (const Empire* empire = AIInterface::GetEmpire())
+        production_location_caching.reset(new ScopedProductionLocationCaching(*empire));
+
     boost::timer order_timer;
     try {
         // call Python function that generates orders for current turn
@@ -10,6 +10,7 @@
 #include "../util/OptionsDB.h"
 #include "../util/SitRepEntry.h"
 #include "../universe/Building.h"
+#include "../universe/Condition.h"
 #include "../universe/Fleet.h"
 #include "../universe/Ship.h"
 #include "../universe/Predicates.h"
@@ -19,6 +20,7 @@
 #include "../universe/Universe.h"
 #include "../universe/Enums.h"
 #include "../universe/UniverseObject.h"
+#include "../universe/ValueRef.h"
 #include "ResourcePool.h"
 #include "EmpireManager.h"
 
@@ -1168,7 +1170,8 @@ Empire::Empire() :
     m_id(ALL_EMPIRES),
     m_capital_id(INVALID_OBJECT_ID),
     m_research_queue(m_id),
-    m_production_queue(m_id)
+    m_production_queue(m_id),
+    m_production_location_caching(0)
 { Init(); }
 
 Empire::Empire(const std::string& name, const std::string& player_name,
@@ -1179,7 +1182,8 @@ Empire::Empire(const std::string& name, const std::string& player_name,
     m_color(color),
     m_capital_id(INVALID_OBJECT_ID),
     m_research_queue(m_id),
-    m_production_queue(m_id)
+    m_production_queue(m_id),
+    m_production_location_caching(0)
 {
     DebugLogger() << "Empire::Empire(" << name << ", " << player_name << ", " << empire_id << ", colour)";
     Init();
@@ -1527,6 +1531,64 @@ std::pair<float, int> Empire::ProductionCostAndTime(const ProductionQueue::Produ
 bool Empire::HasExploredSystem(int ID) const
 { return (m_explored_systems.find(ID) != m_explored_systems.end()); }
 
+namespace {
+    /** Number of locations at which a production location condition is
+      * checked individually before it is evaluated for all objects at once. */
+    const unsigned int LOCATIONS_BEFORE_CACHING_ALL = 8;
+}
+
+void Empire::BeginProductionLocationCaching() const
+{ ++m_production_location_caching; }
+
+void Empire::EndProductionLocationCaching() const {
+    if (m_production_location_caching == 0 || --m_production_location_caching == 0)
+        m_production_location_matches.clear();
+}
+
+void Empire::ClearProductionLocationCache() const
+{ m_production_location_matches.clear(); }
+
+bool Empire::MatchesProductionLocation(const Condition::ConditionBase* location_condition, int location_id) const {
+    if (!location_condition)
+        return true;
+
+    TemporaryPtr<const UniverseObject> location = GetUniverseObject(location_id);
+    if (!location)
+        return false;
+
+    TemporaryPtr<const UniverseObject> source = ProductionSourceForEmpire(m_id);
+    if (!source)
+        return false;
+
+    // objects known to be destroyed are not among the objects that are
+    // evaluated all at once, so are always checked individually
+    if (m_production_location_caching == 0 || !Objects().ExistingObject(location_id))
+        return location_condition->Eval(ScriptingContext(source), location);
+
+    ProductionLocationMatches& matches = m_production_location_matches[location_condition];
+    if (matches.all_checked || matches.location_ids.find(location_id) != matches.location_ids.end())
+        return matches.location_ids.find(location_id) != matches.location_ids.end();
+
+    if (matches.locations_checked < LOCATIONS_BEFORE_CACHING_ALL) {
+        ++matches.locations_checked;
+        bool retval = location_condition->Eval(ScriptingContext(source), location);
+        if (retval)
+            matches.location_ids.insert(location_id);
+        return retval;
+    }
+
+    // condition is being checked at many locations, so evaluate it for all
+    // objects in one pass
+    Condition::ObjectSet condition_matches;
+    location_condition->Eval(ScriptingContext(source), condition_matches);
+    matches.location_ids.clear();
+    for (Condition::ObjectSet::const_iterator it = condition_matches.begin(); it != condition_matches.end(); ++it)
+        matches.location_ids.insert((*it)->ID());
+    matches.all_checked = true;
+
+    return matches.location_ids.find(location_id) != matches.location_ids.end();
+}
+
 bool Empire::ProducibleItem(BuildType build_type, const std::string& name, int location) const {
     // special case to check for ships being passed with names, not design ids
     if (build_type == BT_SHIP)
@@ -1545,6 +1607,8 @@ bool Empire::ProducibleItem(BuildType build_type, const std::string& name, int l
 
     if (build_type == BT_BUILDING) {
         // specified location must be a valid production location for that building type
+        if (m_production_location_caching)
+            return MatchesProductionLocation(building_type->Location(), location);
         return building_type->ProductionLocation(m_id, location);
 
     } else {
@@ -1571,7 +1635,25 @@ bool Empire::ProducibleItem(BuildType build_type, int design_id, int location) c
 
     if (build_type == BT_SHIP) {
         // specified location must be a valid production location for this design
-        return ship_design->ProductionLocation(m_id, location);
+        if (!m_production_location_caching)
+            return ship_design->ProductionLocation(m_id, location);
+
+        if (!ship_design->SpeciesCanProduceAt(location))
+            return false;
+
+        const HullType* hull = ship_design->GetHull();
+        if (!hull || !MatchesProductionLocation(hull->Location(), location))
+            return false;
+
+        const std::vector<std::string>& parts = ship_design->Parts();
+        for (std::vector<std::string>::const_iterator part_it = parts.begin(); part_it != parts.end(); ++part_it) {
+            if (part_it->empty())
+                continue;       // empty slots don't limit build location
+            const PartType* part = GetPartType(*part_it);
+            if (!part || !MatchesProductionLocation(part->Location(), location))
+                return false;
+        }
+        return true;
 
     } else {
         ErrorLogger() << "Empire::ProducibleItem was passed an invalid BuildType";
@@ -3108,6 +3190,7 @@ void Empire::UpdateResearchQueue() {
 
 void Empire::UpdateProductionQueue() {
     DebugLogger() << "========= Production Update for empire: " << EmpireID() << " ========";
+    ScopedProductionLocationCaching production_location_caching(*this);
 
     m_resource_pools[RE_INDUSTRY]->Update();
     m_production_queue.Update();
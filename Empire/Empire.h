@@ -14,6 +14,9 @@
 struct ItemSpec;
 class ShipDesign;
 class SitRepEntry;
+namespace Condition {
+    struct ConditionBase;
+}
 extern const int INVALID_GAME_TURN;
 
 class Alignment {
@@ -350,6 +353,18 @@ public:
 
     bool                    EnqueuableItem(BuildType build_type, const std::string& name, int location) const;  ///< Returns true iff this empire can enqueue the specified item at the specified location.
 
+    /** While caching is enabled, ProducibleItem() remembers which objects
+      * match the location conditions of building types, hulls and parts, and
+      * once a condition has been checked at several locations, evaluates it
+      * for all objects at once instead of once per location.  Calls may be
+      * nested; the cached matches are discarded when the outermost caching
+      * ends.  After objects are changed in ways that may affect production
+      * locations, such as by issuing orders or estimating meters,
+      * ClearProductionLocationCache() must be called. */
+    void                    BeginProductionLocationCaching() const;
+    void                    EndProductionLocationCaching() const;
+    void                    ClearProductionLocationCache() const;       ///< discards cached production location matches, without ending caching
+
     bool                    HasExploredSystem(int ID) const;                            ///< returns  true if the given item is in the appropriate list, false if it is not.
 
     int                     NumSitRepEntries(int turn = INVALID_GAME_TURN) const;       ///< number of entries in the SitRep.
@@ -603,6 +618,19 @@ public:
 private:
     void        Init();
 
+    /** Returns true iff the object with id \a location_id matches
+      * \a location_condition, with an object owned by this empire as the
+      * source, using cached matches while production location caching is
+      * enabled. */
+    bool        MatchesProductionLocation(const Condition::ConditionBase* location_condition, int location_id) const;
+
+    struct ProductionLocationMatches {
+        ProductionLocationMatches() : locations_checked(0), all_checked(false) {}
+        unsigned int    locations_checked;  ///< number of locations at which the condition was checked individually
+        bool            all_checked;        ///< true if the condition has been evaluated for all objects
+        std::set<int>   location_ids;       ///< ids of locations known to match the condition
+    };
+
     int                             m_id;                       ///< Empire's unique numeric id
     std::string                     m_name;                     ///< Empire's name
     std::string                     m_player_name;              ///< Empire's Player's name
@@ -665,10 +693,29 @@ private:
     std::set<int>                   m_fleet_supplyable_system_ids;          ///< ids of systems where fleets can remain for a turn to be resupplied.
     std::set<std::set<int> >        m_resource_supply_groups;               ///< sets of system ids that are connected by supply lines and are able to share resources between systems or between objects in systems
 
+    mutable unsigned int            m_production_location_caching;          ///< number of nested BeginProductionLocationCaching calls
+    mutable std::map<const Condition::ConditionBase*, ProductionLocationMatches>
+                                    m_production_location_matches;          ///< cached matches of production location conditions
+
     friend class boost::serialization::access;
     Empire();
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
 };
 
+/** Enables production location caching for an empire during the lifetime
+  * of this object.  See Empire::BeginProductionLocationCaching(). */
+class ScopedProductionLocationCaching {
+public:
+    explicit ScopedProductionLocationCaching(const Empire& empire) :
+        m_empire(empire)
+    { m_empire.BeginProductionLocationCaching(); }
+
+    ~ScopedProductionLocationCaching()
+    { m_empire.EndProductionLocationCaching(); }
+
+private:
+    const Empire& m_empire;
+};
+
 #endif // _Empire_h_
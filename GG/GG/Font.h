@@ -451,6 +451,23 @@ public:
                        RenderState& render_state, std::size_t begin_line, CPSize begin_char,
                        std::size_t end_line, CPSize end_char, RenderCache& cache) const;
 
+    /** Appends the glyphs of \a text, as RenderText() would render them, to
+        \a cache.  Unlike PreRenderText(), the contents of \a cache are not
+        copied to the video card, so text may be stored in the same \a cache
+        repeatedly, with different RenderStates (and hence colors), and then
+        drawn with a single call to RenderCachedText(). */
+    void StoreText(const Pt& ul, const Pt& lr, const std::string& text, Flags<TextFormat>& format,
+                   RenderCache& cache, const std::vector<LineData>* line_data = 0,
+                   RenderState* render_state = 0) const;
+
+    /** Appends the glyphs in the given range of \a text to \a cache, as
+        StoreText() does.  The range is as for the ranged overload of
+        RenderText(). */
+    void StoreText(const Pt& pt1, const Pt& pt2, const std::string& text,
+                   Flags<TextFormat>& format, const std::vector<LineData>& line_data,
+                   RenderState& render_state, std::size_t begin_line, CPSize begin_char,
+                   std::size_t end_line, CPSize end_char, RenderCache& cache) const;
+
     void RenderCachedText(RenderCache& cache) const;
 
     /** Sets \a render_state as if all the text before (<i>begin_line</i>,
@@ -561,8 +578,16 @@ private:
     Pt DetermineLinesImpl(const std::string& text,
                           Flags<TextFormat>& format,
                           X box_width,
-                          std::vector<LineData>& line_data,
+                          std::vector<LineData>* line_data_ptr,
                           std::vector<boost::shared_ptr<TextElement> >* text_elements_ptr) const;
+    void TokenizeText(const std::string& text,
+                      bool ignore_tags,
+                      std::vector<boost::shared_ptr<TextElement> >& text_elements) const;
+    Pt LayOutLines(const std::string& text,
+                   Flags<TextFormat> format,
+                   X box_width,
+                   const std::vector<boost::shared_ptr<TextElement> >& text_elements,
+                   std::vector<LineData>& line_data) const;
 
     FT_Error          GetFace(FT_Face& face);
     FT_Error          GetFace(const std::vector<unsigned char>& file_contents, FT_Face& face);
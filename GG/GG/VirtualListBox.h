@@ -0,0 +1,256 @@
+// -*- C++ -*-
+/* GG is a GUI for SDL and OpenGL.
+   Copyright (C) 2003-2008 T. Zachary Laine
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public License
+   as published by the Free Software Foundation; either version 2.1
+   of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free
+   Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307 USA
+
+   If you do not wish to comply with the terms of the LGPL please
+   contact the author as other terms are available for a fee.
+
+   Zach Laine
+   whatwasthataddress@gmail.com */
+
+/** \file VirtualListBox.h \brief Contains the VirtualListBox class, a list
+    control whose rows are supplied on demand by a data model. */
+
+#ifndef _GG_VirtualListBox_h_
+#define _GG_VirtualListBox_h_
+
+#include <GG/ListBox.h>
+
+#include <set>
+#include <vector>
+
+
+namespace GG {
+
+class Scroll;
+
+/** \brief A list control that only creates widgets for the rows it shows.
+
+    A VirtualListBox does not own its rows.  Instead, it is driven by a Model,
+    which reports how many rows there are, provides the sort key of each, and
+    binds a recyclable Row widget to a particular model row on request.  Only
+    enough Row widgets to fill the client area are ever created; when the list
+    is scrolled, the existing widgets are rebound to the newly visible model
+    rows.  This makes the cost of filling, sorting and scrolling the list
+    independent of the cost of building the widgets of a row, which matters
+    for lists with thousands of entries.
+
+    <br>All rows have the same height, and are identified by their index in
+    the model, which is independent of the order in which they are shown.
+    Whenever the model's contents change, call ModelChanged(); this resorts
+    the rows, clears the selection and rebinds the visible rows.  If only the
+    contents of some rows changed, RowsChanged() rebinds the visible rows
+    without resorting.
+
+    <br>VirtualListBox uses the same ListBoxStyle flags as ListBox, though
+    only the sorting and selection flags (LIST_NOSORT, LIST_SORTDESCENDING,
+    LIST_NOSEL, LIST_SINGLESEL and LIST_QUICKSEL) have any effect.
+    Drag-and-drop and horizontal scrolling are not supported. */
+class GG_API VirtualListBox : public Control
+{
+public:
+    /** \brief The source of the rows shown by a VirtualListBox. */
+    class GG_API Model
+    {
+    public:
+        virtual ~Model();
+
+        /** Returns the number of rows in the model. */
+        virtual std::size_t         NumRows() const = 0;
+
+        /** Returns the key by which row \a row is sorted on column \a
+            column. */
+        virtual ListBox::Row::SortKeyType
+                                    SortKey(std::size_t row, std::size_t column) const = 0;
+
+        /** Returns true iff row \a lhs sorts before row \a rhs on column \a
+            column.  The default compares the rows' SortKey()s. */
+        virtual bool                SortLess(std::size_t lhs, std::size_t rhs, std::size_t column) const;
+
+        /** Returns a new Row widget of size (\a w, \a h).  The widget will be
+            owned by the VirtualListBox, and will be bound to different model
+            rows over its lifetime via UpdateRow(). */
+        virtual ListBox::Row*       CreateRow(X w, Y h) = 0;
+
+        /** Sets the contents of \a row_wnd to show row \a row of the model. */
+        virtual void                UpdateRow(ListBox::Row& row_wnd, std::size_t row) = 0;
+    };
+
+    /** the set of selected model row indices */
+    typedef std::set<std::size_t> SelectionSet;
+
+    /** \name Signal Types */ ///@{
+    /** emitted when one or more rows are selected or deselected */
+    typedef boost::signals2::signal<void (const SelectionSet&)>    SelChangedSignalType;
+    /** the signature of row-notification signals; provides the model row */
+    typedef boost::signals2::signal<void (std::size_t)>             RowSignalType;
+    /** the signature of row-click-notification signals; provides the model row and the clicked point */
+    typedef boost::signals2::signal<void (std::size_t, const Pt&)>  RowClickSignalType;
+
+    typedef RowClickSignalType LeftClickedSignalType;    ///< emitted when a row in the listbox is left-clicked
+    typedef RowClickSignalType RightClickedSignalType;   ///< emitted when a row in the listbox is right-clicked
+    typedef RowSignalType      DoubleClickedSignalType;  ///< emitted when a row in the listbox is left-double-clicked
+    //@}
+
+    /** the value returned for "no row" by functions that return a row */
+    static const std::size_t NO_ROW;
+
+    /** \name Structors */ ///@{
+    /** basic ctor */
+    VirtualListBox(Clr color, Clr interior = CLR_ZERO);
+
+    virtual ~VirtualListBox(); ///< virtual dtor
+    //@}
+
+    /** \name Accessors */ ///@{
+    virtual Pt          MinUsableSize() const;
+    virtual Pt          ClientUpperLeft() const;
+    virtual Pt          ClientLowerRight() const;
+
+    Model*              GetModel() const;       ///< returns the model that supplies the rows of this list, if any
+    bool                Empty() const;          ///< returns true when the list has no rows
+    std::size_t         NumRows() const;        ///< returns the total number of rows in the list
+    const SelectionSet& Selections() const;     ///< returns the set of model rows that are currently selected
+    bool                Selected(std::size_t row) const; ///< returns true if model row \a row is selected
+    std::size_t         Caret() const;          ///< returns the model row that has the caret, or NO_ROW
+    Clr                 InteriorColor() const;  ///< returns the color painted into the client area of the control
+    Clr                 HiliteColor() const;    ///< returns the color behind selected rows
+    Y                   RowHeight() const;      ///< returns the height of every row
+
+    /** Returns the style flags of the listbox \see GG::ListBoxStyle */
+    Flags<ListBoxStyle> Style() const;
+
+    /** Returns the index of the column used to sort rows, when sorting is
+        enabled. */
+    std::size_t         SortCol() const;
+
+    const ListBox::Row& ColHeaders() const;     ///< returns the row containing the headings for the columns, if any
+
+    /** Returns the display position of the first row shown. */
+    std::size_t         FirstRowShown() const;
+
+    /** Returns the model row shown at display position \a position, or
+        NO_ROW if \a position is out of range. */
+    std::size_t         RowAtPosition(std::size_t position) const;
+
+    /** Returns the model row under \a pt, or NO_ROW if there is none. */
+    std::size_t         RowUnderPt(const Pt& pt) const;
+
+    /** Returns the Row widget currently bound to model row \a row, or 0 if
+        that row is not shown. */
+    ListBox::Row*       RowWnd(std::size_t row) const;
+
+    mutable SelChangedSignalType    SelChangedSignal;       ///< the selection change signal object for this VirtualListBox
+    mutable LeftClickedSignalType   LeftClickedSignal;      ///< the left click signal object for this VirtualListBox
+    mutable RightClickedSignalType  RightClickedSignal;     ///< the right click signal object for this VirtualListBox
+    mutable DoubleClickedSignalType DoubleClickedSignal;    ///< the double click signal object for this VirtualListBox
+    //@}
+
+    /** \name Mutators */ ///@{
+    virtual void    Render();
+    virtual void    SizeMove(const Pt& ul, const Pt& lr);
+    virtual void    KeyPress(Key key, boost::uint32_t key_code_point, Flags<ModKey> mod_keys);
+    virtual void    MouseWheel(const Pt& pt, int move, Flags<ModKey> mod_keys);
+    virtual void    Disable(bool b = true);
+    virtual void    SetColor(Clr c);
+
+    /** Sets the model that supplies the rows of this list.  The model is not
+        owned by the VirtualListBox, and must outlive it or be replaced.  Any
+        existing Row widgets are deleted, since they were created by the old
+        model. */
+    void            SetModel(Model* model);
+
+    /** Notifies the list that the number, order or contents of the model's
+        rows have changed.  The rows are resorted, the selection and caret
+        are cleared, and the visible Row widgets are rebound.  The first row
+        shown is preserved if it is still in range. */
+    void            ModelChanged();
+
+    /** Rebinds the visible Row widgets to their model rows, without
+        resorting.  Use this when the contents, but not the number, of rows
+        have changed. */
+    void            RowsChanged();
+
+    /** Rebinds the Row widget for model row \a row, if that row is shown. */
+    void            RowChanged(std::size_t row);
+
+    void            SetRowHeight(Y h);              ///< sets the height of every row
+    void            SetStyle(Flags<ListBoxStyle> s);///< sets the style flags for the listbox to \a s, resorting if needed
+    void            SetSortCol(std::size_t n);      ///< sets the index of the column used to sort rows, resorting if needed
+    void            SetColHeaders(ListBox::Row* r); ///< sets the row used as headings for the columns; this Row becomes property of the VirtualListBox
+    void            SetInteriorColor(Clr c);        ///< sets the color painted into the client area of the control
+    void            SetHiliteColor(Clr c);          ///< sets the color behind selected rows
+
+    void            SelectRow(std::size_t row, bool signal = false);   ///< selects model row \a row
+    void            DeselectRow(std::size_t row, bool signal = false); ///< deselects model row \a row
+    void            DeselectAll(bool signal = false);                  ///< deselects all currently-selected rows
+    void            SetSelections(const SelectionSet& s, bool signal = false); ///< sets the set of selected rows to \a s
+
+    void            SetFirstRowShown(std::size_t position); ///< sets the display position of the first row shown
+    void            BringRowIntoView(std::size_t row);      ///< moves the scrollbar so that model row \a row is visible
+
+    /** Sets the amount (in pixels) by which the vertical scroll moves on
+        each mouse wheel step.  If zero, the row height is used. */
+    void            SetVScrollWheelIncrement(unsigned int increment);
+    //@}
+
+    static const unsigned int BORDER_THICK; ///< the thickness with which to render the border of the control
+
+protected:
+    /** \name Mutators */ ///@{
+    virtual bool    EventFilter(Wnd* w, const WndEvent& event);
+    //@}
+
+private:
+    struct SortLessFunctor;
+
+    std::size_t     NumRowSlots() const;
+    std::size_t     MaxFirstRowShown() const;
+    std::size_t     PositionOfRow(std::size_t row) const;
+    void            Resort();
+    void            LayoutRows();
+    void            AdjustScrolls(bool adjust_for_resize);
+    void            VScrolled(int tab_low, int tab_high, int low, int high);
+    void            ClickAtRow(std::size_t row, Flags<ModKey> mod_keys);
+    void            DeleteRowWnds();
+
+    Model*                      m_model;
+    std::vector<std::size_t>    m_order;            ///< model row shown at each display position
+    std::vector<std::size_t>    m_positions;        ///< display position of each model row
+    std::vector<ListBox::Row*>  m_row_wnds;         ///< recycled Row widgets, one per visible slot
+    std::vector<std::size_t>    m_row_wnd_rows;     ///< model row bound to each Row widget, or NO_ROW
+    Scroll*                     m_vscroll;
+    unsigned int                m_vscroll_wheel_scroll_increment;
+    std::size_t                 m_first_row_shown;  ///< display position of the first row shown
+    Y                           m_row_height;
+    SelectionSet                m_selections;
+    std::size_t                 m_caret;
+    std::size_t                 m_old_sel_row;
+    bool                        m_old_sel_row_selected;
+    std::size_t                 m_old_rdown_row;
+    std::size_t                 m_lclick_row;
+    Clr                         m_int_color;
+    Clr                         m_hilite_color;
+    Flags<ListBoxStyle>         m_style;
+    ListBox::Row*               m_header_row;
+    std::size_t                 m_sort_col;
+};
+
+} // namespace GG
+
+#endif
@@ -39,9 +39,12 @@
 #include <boost/xpressive/xpressive.hpp>
 #include <boost/xpressive/regex_actions.hpp>
 #include <boost/assign/list_of.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <cmath>
 #include <cctype>
+#include <list>
 #include <numeric>
 #include <sstream>
 
@@ -277,6 +280,208 @@ namespace {
         }
     }
 
+    /** A process-wide, least-recently-used cache of the results of
+        Font::DetermineLines().  Each entry is keyed on a Font, a string and
+        whether tags are ignored, and keeps a private copy of the string, the
+        TextElements parsed from it, and the line layouts computed from those
+        elements for the last few (format, box width) pairs requested.
+
+        The TextElements and FormattingTags handed out to callers share
+        ownership of the whole entry, so their Substrings remain valid after
+        the entry has been evicted. */
+    class LayoutCache
+    {
+    public:
+        struct Layout
+        {
+            Layout() : format(FORMAT_NONE), box_width(X0) {}
+            Flags<TextFormat>           format;
+            X                           box_width;
+            std::vector<Font::LineData> line_data;
+            Pt                          extent;
+        };
+
+        struct ParsedText
+        {
+            explicit ParsedText(const std::string& text_) : text(text_) {}
+            const std::string                               text;
+            std::vector<boost::shared_ptr<Font::TextElement> > elements;
+            std::list<Layout>                               layouts;    ///< most recently used first
+        };
+
+        typedef boost::shared_ptr<ParsedText> ParsedTextPtr;
+
+        LayoutCache() :
+            m_text_bytes(0)
+        {}
+
+        /** Returns the cached parse of \a text in \a font, or a null pointer
+            if there is none. */
+        ParsedTextPtr FindParse(const Font* font, const std::string& text, bool ignore_tags)
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            Index::iterator it = m_index.find(Key(font, text, ignore_tags));
+            if (it == m_index.end())
+                return ParsedTextPtr();
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return it->second->second;
+        }
+
+        /** Adds \a parsed to the cache, evicting the least recently used
+            entries if the cache is over budget. */
+        void InsertParse(const Font* font, bool ignore_tags, const ParsedTextPtr& parsed)
+        {
+            if (MAX_TEXT_BYTES < parsed->text.size())
+                return;
+            boost::mutex::scoped_lock lock(m_mutex);
+            Key key(font, parsed->text, ignore_tags);
+            if (m_index.find(key) != m_index.end())
+                return;
+            m_entries.push_front(std::make_pair(key, parsed));
+            m_index[key] = m_entries.begin();
+            m_text_bytes += parsed->text.size();
+            while (MAX_ENTRIES < m_entries.size() || MAX_TEXT_BYTES < m_text_bytes)
+                EraseEntry(boost::prior(m_entries.end()));
+        }
+
+        /** Returns true and fills in \a extent and, if non-null, \a
+            line_data, if a layout of \a parsed for \a format and \a box_width
+            is cached. */
+        bool FindLayout(const ParsedTextPtr& parsed, Flags<TextFormat> format, X box_width,
+                        std::vector<Font::LineData>* line_data, Pt& extent)
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            for (std::list<Layout>::iterator it = parsed->layouts.begin(); it != parsed->layouts.end(); ++it) {
+                if (it->format != format || it->box_width != box_width)
+                    continue;
+                parsed->layouts.splice(parsed->layouts.begin(), parsed->layouts, it);
+                extent = it->extent;
+                if (line_data) {
+                    *line_data = it->line_data;
+                    ShareOwnership(*line_data, parsed);
+                }
+                return true;
+            }
+            return false;
+        }
+
+        /** Records \a line_data, which must have been laid out from the
+            elements of \a parsed, as the layout for \a format and \a
+            box_width. */
+        void InsertLayout(const ParsedTextPtr& parsed, Flags<TextFormat> format, X box_width,
+                          const std::vector<Font::LineData>& line_data, const Pt& extent)
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            parsed->layouts.push_front(Layout());
+            Layout& layout = parsed->layouts.front();
+            layout.format = format;
+            layout.box_width = box_width;
+            layout.line_data = line_data;
+            layout.extent = extent;
+            if (MAX_LAYOUTS_PER_TEXT < parsed->layouts.size())
+                parsed->layouts.pop_back();
+        }
+
+        /** Removes all entries for \a font. */
+        void Purge(const Font* font)
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            for (EntryList::iterator it = m_entries.begin(); it != m_entries.end();) {
+                if (it->first.font == font)
+                    EraseEntry(it++);
+                else
+                    ++it;
+            }
+        }
+
+        /** Removes all entries. */
+        void Clear()
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            m_index.clear();
+            m_entries.clear();
+            m_text_bytes = 0;
+        }
+
+        /** Replaces each TextElement pointer in \a elements with one that
+            shares ownership of \a parsed, so that the elements' Substrings
+            stay valid as long as any of the elements are in use. */
+        static void ShareOwnership(std::vector<boost::shared_ptr<Font::TextElement> >& elements,
+                                   const ParsedTextPtr& parsed)
+        {
+            for (std::size_t i = 0; i < elements.size(); ++i) {
+                elements[i] = boost::shared_ptr<Font::TextElement>(parsed, elements[i].get());
+            }
+        }
+
+        /** Replaces each FormattingTag pointer in \a line_data with one that
+            shares ownership of \a parsed. */
+        static void ShareOwnership(std::vector<Font::LineData>& line_data, const ParsedTextPtr& parsed)
+        {
+            for (std::size_t i = 0; i < line_data.size(); ++i) {
+                std::vector<Font::LineData::CharData>& char_data = line_data[i].char_data;
+                for (std::size_t j = 0; j < char_data.size(); ++j) {
+                    std::vector<boost::shared_ptr<Font::FormattingTag> >& tags = char_data[j].tags;
+                    for (std::size_t k = 0; k < tags.size(); ++k) {
+                        tags[k] = boost::shared_ptr<Font::FormattingTag>(parsed, tags[k].get());
+                    }
+                }
+            }
+        }
+
+    private:
+        struct Key
+        {
+            Key(const Font* font_, const std::string& text_, bool ignore_tags_) :
+                font(font_), text(text_), ignore_tags(ignore_tags_)
+            {}
+            bool operator==(const Key& rhs) const
+            { return font == rhs.font && ignore_tags == rhs.ignore_tags && text == rhs.text; }
+
+            const Font* font;
+            std::string text;
+            bool        ignore_tags;
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(const Key& key) const
+            {
+                std::size_t seed = boost::hash_value(key.text);
+                boost::hash_combine(seed, key.font);
+                boost::hash_combine(seed, key.ignore_tags);
+                return seed;
+            }
+        };
+
+        typedef std::list<std::pair<Key, ParsedTextPtr> >                   EntryList;
+        typedef boost::unordered_map<Key, EntryList::iterator, KeyHash>     Index;
+
+        void EraseEntry(EntryList::iterator it)
+        {
+            m_text_bytes -= it->second->text.size();
+            m_index.erase(it->first);
+            m_entries.erase(it);
+        }
+
+        static const std::size_t MAX_ENTRIES = 2048;
+        static const std::size_t MAX_TEXT_BYTES = 4 * 1024 * 1024;
+        static const std::size_t MAX_LAYOUTS_PER_TEXT = 4;
+
+        EntryList       m_entries;      ///< most recently used first
+        Index           m_index;
+        std::size_t     m_text_bytes;   ///< total size of the cached strings
+        boost::mutex    m_mutex;
+    };
+
+    // Never destroyed, since Fonts with static storage duration (such as
+    // FontManager::EMPTY_FONT) purge their entries when they are destroyed.
+    LayoutCache& GetLayoutCache()
+    {
+        static LayoutCache* cache = new LayoutCache();
+        return *cache;
+    }
+
     const double ITALICS_SLANT_ANGLE = 12; // degrees
     const double ITALICS_FACTOR = 1.0 / tan((90 - ITALICS_SLANT_ANGLE) * 3.1415926 / 180.0); // factor used to shear glyphs ITALICS_SLANT_ANGLE degrees CW from straight up
 
@@ -742,7 +947,7 @@ Font::Font(const std::string& font_filename, unsigned int pts,
 }
 
 Font::~Font()
-{}
+{ GetLayoutCache().Purge(this); }
 
 const std::string& Font::FontName() const
 { return m_font_filename; }
@@ -790,9 +995,6 @@ X Font::RenderText(const Pt& pt_, const std::string& text) const
         }
     }
 
-    cache.vertices->createServerBuffer();
-    cache.coordinates->createServerBuffer();
-    cache.colors->createServerBuffer();
     RenderCachedText(cache);
 
     return pt.x - orig_x;
@@ -821,8 +1023,10 @@ void Font::RenderText(const Pt& ul, const Pt& lr, const std::string& text, Flags
                      std::size_t begin_line, CPSize begin_char,
                      std::size_t end_line, CPSize end_char) const
  {
+    // the glyphs are drawn once, so there is no point in copying them to a
+    // server-side buffer first
     RenderCache cache;
-    PreRenderText(ul, lr, text, format, line_data, render_state, begin_line, begin_char, end_line, end_char, cache);
+    StoreText(ul, lr, text, format, line_data, render_state, begin_line, begin_char, end_line, end_char, cache);
     RenderCachedText(cache);
 }
 
@@ -849,6 +1053,38 @@ void Font::PreRenderText(const Pt& ul, const Pt& lr, const std::string& text, Fl
                       std::size_t begin_line, CPSize begin_char,
                       std::size_t end_line, CPSize end_char,
                       RenderCache& cache) const
+{
+    StoreText(ul, lr, text, format, line_data, render_state, begin_line, begin_char, end_line, end_char, cache);
+
+    cache.vertices->createServerBuffer();
+    cache.coordinates->createServerBuffer();
+    cache.colors->createServerBuffer();
+}
+
+void Font::StoreText(const Pt& ul, const Pt& lr, const std::string& text, Flags<TextFormat>& format,
+                     RenderCache& cache, const std::vector<LineData>* line_data/* = 0*/,
+                     RenderState* render_state/* = 0*/) const
+{
+    RenderState state;
+    if (!render_state)
+        render_state = &state;
+
+    // get breakdown of how text is divided into lines
+    std::vector<LineData> lines;
+    if (!line_data) {
+        DetermineLines(text, format, lr.x - ul.x, lines);
+        line_data = &lines;
+    }
+
+    StoreText(ul, lr, text, format, *line_data, *render_state,
+              0, CP0, line_data->size(), CPSize(line_data->back().char_data.size()), cache);
+}
+
+void Font::StoreText(const Pt& ul, const Pt& lr, const std::string& text, Flags<TextFormat>& format,
+                     const std::vector<LineData>& line_data, RenderState& render_state,
+                     std::size_t begin_line, CPSize begin_char,
+                     std::size_t end_line, CPSize end_char,
+                     RenderCache& cache) const
 {
     double orig_color[4];
     glGetDoublev(GL_CURRENT_COLOR, orig_color);
@@ -895,10 +1131,6 @@ void Font::PreRenderText(const Pt& ul, const Pt& lr, const std::string& text, Fl
             }
         }
     }
-
-    cache.vertices->createServerBuffer();
-    cache.coordinates->createServerBuffer();
-    cache.colors->createServerBuffer();
 }
 
 void Font::RenderCachedText(RenderCache& cache) const
@@ -950,14 +1182,14 @@ void Font::ProcessTagsBefore(const std::vector<LineData>& line_data, RenderState
 
 Pt Font::DetermineLines(const std::string& text, Flags<TextFormat>& format, X box_width,
                         std::vector<LineData>& line_data) const
-{ return DetermineLinesImpl(text, format, box_width, line_data, 0); }
+{ return DetermineLinesImpl(text, format, box_width, &line_data, 0); }
 
 Pt Font::DetermineLines(const std::string& text, Flags<TextFormat>& format, X box_width,
                         std::vector<LineData>& line_data,
                         std::vector<boost::shared_ptr<TextElement> >& text_elements) const
 {
     assert(text_elements.empty());
-    return DetermineLinesImpl(text, format, box_width, line_data, &text_elements);
+    return DetermineLinesImpl(text, format, box_width, &line_data, &text_elements);
 }
 
 Pt Font::DetermineLines(const std::string& text, Flags<TextFormat>& format, X box_width,
@@ -968,15 +1200,12 @@ Pt Font::DetermineLines(const std::string& text, Flags<TextFormat>& format, X bo
     return DetermineLinesImpl(text,
                               format,
                               box_width,
-                              line_data,
+                              &line_data,
                               const_cast<std::vector<boost::shared_ptr<TextElement> >*>(&text_elements));
 }
 
 Pt Font::TextExtent(const std::string& text, Flags<TextFormat> format/* = FORMAT_NONE*/, X box_width/* = X0*/) const
-{
-    std::vector<LineData> lines;
-    return DetermineLines(text, format, box_width ? box_width : X(1 << 15), lines);
-}
+{ return DetermineLinesImpl(text, format, box_width ? box_width : X(1 << 15), 0, 0); }
 
 Pt Font::TextExtent(const std::string& text, const std::vector<LineData>& line_data) const
 {
@@ -990,16 +1219,22 @@ Pt Font::TextExtent(const std::string& text, const std::vector<LineData>& line_d
 }
 
 void Font::RegisterKnownTag(const std::string& tag)
-{ s_known_tags.insert(tag); }
+{
+    s_known_tags.insert(tag);
+    GetLayoutCache().Clear();
+}
 
 void Font::RemoveKnownTag(const std::string& tag)
 {
-    if (s_action_tags.find(tag) == s_action_tags.end())
+    if (s_action_tags.find(tag) == s_action_tags.end()) {
         s_known_tags.erase(tag);
+        GetLayoutCache().Clear();
+    }
 }
 
 void Font::ClearKnownTags()
 {
+    GetLayoutCache().Clear();
     s_action_tags.clear();
     s_action_tags.insert("i");
     s_action_tags.insert("u");
@@ -1020,7 +1255,7 @@ void Font::ThrowBadGlyph(const std::string& format_str, boost::uint32_t c)
 Pt Font::DetermineLinesImpl(const std::string& text,
                             Flags<TextFormat>& format,
                             X box_width,
-                            std::vector<LineData>& line_data,
+                            std::vector<LineData>* line_data_ptr,
                             std::vector<boost::shared_ptr<TextElement> >* text_elements_ptr) const
 {
     ValidateFormat(format);
@@ -1031,151 +1266,190 @@ Pt Font::DetermineLinesImpl(const std::string& text,
               << format << " box_width=" << box_width << ")" << std::endl;
 #endif
 
-    std::vector<boost::shared_ptr<TextElement> > local_text_elements;
-
-    std::vector<boost::shared_ptr<TextElement> >& text_elements =
-        text_elements_ptr ? *text_elements_ptr : local_text_elements;
-
-    if (text_elements.empty()) {
-        using namespace boost::xpressive;
-
-        std::stack<Substring> tag_stack;
-        bool ignore_tags = format & FORMAT_IGNORETAGS;
-        MatchesKnownTag matches_known_tag(s_known_tags, ignore_tags);
-        MatchesTopOfStack matches_tag_stack(tag_stack, ignore_tags);
-
-        mark_tag tag_name_tag(1);
-        mark_tag open_bracket_tag(2);
-        mark_tag close_bracket_tag(3);
-        mark_tag whitespace_tag(4);
-        mark_tag text_tag(5);
-
-        const sregex TAG_PARAM =
-            -+~set[_s | '<'];
-        const sregex OPEN_TAG_NAME =
-            (+_w)[check(matches_known_tag)];
-        const sregex CLOSE_TAG_NAME =
-            (+_w)[check(matches_tag_stack)];
-        const sregex WHITESPACE =
-            (*blank >> (_ln | (set = '\n', '\r', '\f'))) | +blank;
-        const sregex TEXT =
-            ('<' >> *~set[_s | '<']) | (+~set[_s | '<']);
-        const sregex EVERYTHING =
-            ('<' >> (tag_name_tag = OPEN_TAG_NAME) >> repeat<0, 9>(+blank >> TAG_PARAM) >> (open_bracket_tag.proto_base() = '>'))
-            [Push(boost::xpressive::ref(text), boost::xpressive::ref(tag_stack), ref(ignore_tags), tag_name_tag)] |
-            ("</" >> (tag_name_tag = CLOSE_TAG_NAME) >> (close_bracket_tag.proto_base() = '>')) |
-            (whitespace_tag = WHITESPACE) |
-            (text_tag = TEXT);
-
-        sregex_iterator it(text.begin(), text.end(), EVERYTHING);
-        sregex_iterator end_it;
-        while (it != end_it)
-        {
-            // consolidate adjacent blocks of text
-            bool need_increment = false;
-            Substring combined_text;
-            if ((*it)[text_tag].matched) {
-                while (it != end_it && (*it)[text_tag].matched) {
-                    if (combined_text.empty())
-                        combined_text = Substring(text, (*it)[text_tag]);
-                    else
-                        combined_text += (*it)[text_tag];
-                    ++it;
-                }
-            } else {
-                need_increment = true;
+    LayoutCache& cache = GetLayoutCache();
+    bool ignore_tags = format & FORMAT_IGNORETAGS;
+    bool have_text_elements = text_elements_ptr && !text_elements_ptr->empty();
+
+    std::vector<LineData> local_line_data;
+    std::vector<LineData>& line_data = line_data_ptr ? *line_data_ptr : local_line_data;
+
+    LayoutCache::ParsedTextPtr parsed = cache.FindParse(this, text, ignore_tags);
+    if (!parsed) {
+        // the caller has already done the parsing, so there is nothing worth
+        // caching
+        if (have_text_elements)
+            return LayOutLines(text, format, box_width, *text_elements_ptr, line_data);
+
+        // parse a private copy of the text, so that the cached elements do
+        // not refer to the caller's string
+        parsed.reset(new LayoutCache::ParsedText(text));
+        TokenizeText(parsed->text, ignore_tags, parsed->elements);
+        cache.InsertParse(this, ignore_tags, parsed);
+    }
+
+    if (text_elements_ptr && !have_text_elements) {
+        *text_elements_ptr = parsed->elements;
+        LayoutCache::ShareOwnership(*text_elements_ptr, parsed);
+    }
+
+    Pt retval;
+    if (cache.FindLayout(parsed, format, box_width, line_data_ptr, retval))
+        return retval;
+
+    retval = LayOutLines(parsed->text, format, box_width, parsed->elements, line_data);
+    cache.InsertLayout(parsed, format, box_width, line_data, retval);
+    LayoutCache::ShareOwnership(line_data, parsed);
+    return retval;
+}
+
+void Font::TokenizeText(const std::string& text,
+                        bool ignore_tags,
+                        std::vector<boost::shared_ptr<TextElement> >& text_elements) const
+{
+    using namespace boost::xpressive;
+
+    std::stack<Substring> tag_stack;
+    MatchesKnownTag matches_known_tag(s_known_tags, ignore_tags);
+    MatchesTopOfStack matches_tag_stack(tag_stack, ignore_tags);
+
+    mark_tag tag_name_tag(1);
+    mark_tag open_bracket_tag(2);
+    mark_tag close_bracket_tag(3);
+    mark_tag whitespace_tag(4);
+    mark_tag text_tag(5);
+
+    const sregex TAG_PARAM =
+        -+~set[_s | '<'];
+    const sregex OPEN_TAG_NAME =
+        (+_w)[check(matches_known_tag)];
+    const sregex CLOSE_TAG_NAME =
+        (+_w)[check(matches_tag_stack)];
+    const sregex WHITESPACE =
+        (*blank >> (_ln | (set = '\n', '\r', '\f'))) | +blank;
+    const sregex TEXT =
+        ('<' >> *~set[_s | '<']) | (+~set[_s | '<']);
+    const sregex EVERYTHING =
+        ('<' >> (tag_name_tag = OPEN_TAG_NAME) >> repeat<0, 9>(+blank >> TAG_PARAM) >> (open_bracket_tag.proto_base() = '>'))
+        [Push(boost::xpressive::ref(text), boost::xpressive::ref(tag_stack), ref(ignore_tags), tag_name_tag)] |
+        ("</" >> (tag_name_tag = CLOSE_TAG_NAME) >> (close_bracket_tag.proto_base() = '>')) |
+        (whitespace_tag = WHITESPACE) |
+        (text_tag = TEXT);
+
+    sregex_iterator it(text.begin(), text.end(), EVERYTHING);
+    sregex_iterator end_it;
+    while (it != end_it)
+    {
+        // consolidate adjacent blocks of text
+        bool need_increment = false;
+        Substring combined_text;
+        if ((*it)[text_tag].matched) {
+            while (it != end_it && (*it)[text_tag].matched) {
+                if (combined_text.empty())
+                    combined_text = Substring(text, (*it)[text_tag]);
+                else
+                    combined_text += (*it)[text_tag];
+                ++it;
             }
+        } else {
+            need_increment = true;
+        }
 
-            if (combined_text.empty()) {
-                if ((*it)[open_bracket_tag].matched) {
-                    boost::shared_ptr<Font::FormattingTag> element(new Font::FormattingTag(false));
-                    element->text = Substring(text, (*it)[0]);
-                    if (1 < (*it).nested_results().size()) {
-                        element->params.reserve((*it).nested_results().size() - 1);
-                        for (smatch::nested_results_type::const_iterator nested_it =
-                                 ++(*it).nested_results().begin();
-                             nested_it != (*it).nested_results().end();
-                             ++nested_it) {
-                            element->params.push_back(
-                                Substring(text, (*nested_it)[0]));
-                        }
-                    }
-                    element->tag_name = Substring(text, (*it)[tag_name_tag]);
-                    text_elements.push_back(element);
-                } else if ((*it)[close_bracket_tag].matched) {
-                    boost::shared_ptr<Font::FormattingTag> element(new Font::FormattingTag(true));
-                    element->text = Substring(text, (*it)[0]);
-                    element->tag_name = Substring(text, (*it)[tag_name_tag]);
-                    text_elements.push_back(element);
-                } else if ((*it)[whitespace_tag].matched) {
-                    boost::shared_ptr<Font::TextElement> element(new Font::TextElement(true, false));
-                    element->text = Substring(text, (*it)[whitespace_tag]);
-                    text_elements.push_back(element);
-                    char last_char = *boost::prior(element->text.end());
-                    if (last_char == '\n' || last_char == '\f' || last_char == '\r') {
-                        boost::shared_ptr<Font::TextElement> element(new Font::TextElement(false, true));
-                        text_elements.push_back(element);
+        if (combined_text.empty()) {
+            if ((*it)[open_bracket_tag].matched) {
+                boost::shared_ptr<Font::FormattingTag> element(new Font::FormattingTag(false));
+                element->text = Substring(text, (*it)[0]);
+                if (1 < (*it).nested_results().size()) {
+                    element->params.reserve((*it).nested_results().size() - 1);
+                    for (smatch::nested_results_type::const_iterator nested_it =
+                             ++(*it).nested_results().begin();
+                         nested_it != (*it).nested_results().end();
+                         ++nested_it) {
+                        element->params.push_back(
+                            Substring(text, (*nested_it)[0]));
                     }
                 }
-            } else {
-                boost::shared_ptr<Font::TextElement> element(new Font::TextElement(false, false));
-                element->text = combined_text;
+                element->tag_name = Substring(text, (*it)[tag_name_tag]);
+                text_elements.push_back(element);
+            } else if ((*it)[close_bracket_tag].matched) {
+                boost::shared_ptr<Font::FormattingTag> element(new Font::FormattingTag(true));
+                element->text = Substring(text, (*it)[0]);
+                element->tag_name = Substring(text, (*it)[tag_name_tag]);
                 text_elements.push_back(element);
+            } else if ((*it)[whitespace_tag].matched) {
+                boost::shared_ptr<Font::TextElement> element(new Font::TextElement(true, false));
+                element->text = Substring(text, (*it)[whitespace_tag]);
+                text_elements.push_back(element);
+                char last_char = *boost::prior(element->text.end());
+                if (last_char == '\n' || last_char == '\f' || last_char == '\r') {
+                    boost::shared_ptr<Font::TextElement> element(new Font::TextElement(false, true));
+                    text_elements.push_back(element);
+                }
             }
-
-            if (need_increment)
-                ++it;
+        } else {
+            boost::shared_ptr<Font::TextElement> element(new Font::TextElement(false, false));
+            element->text = combined_text;
+            text_elements.push_back(element);
         }
 
-        // fill in the widths of code points in each TextElement
-        const GlyphMap::const_iterator WIDE_SPACE_IT = m_glyphs.find(WIDE_SPACE);
-        for (std::size_t i = 0; i < text_elements.size(); ++i) {
-            std::string::const_iterator it = text_elements[i]->text.begin();
-            std::string::const_iterator end_it = text_elements[i]->text.end();
-            while (it != end_it) {
-                text_elements[i]->widths.push_back(X0);
-                boost::uint32_t c = utf8::next(it, end_it);
-                if (c != WIDE_NEWLINE) {
-                    GlyphMap::const_iterator it = m_glyphs.find(c);
-                    // use a space when an unrendered glyph is requested (the
-                    // space chararacter is always renderable)
-                    if (it == m_glyphs.end())
-                        it = WIDE_SPACE_IT;
-                    text_elements[i]->widths.back() = it->second.advance;
-                }
+        if (need_increment)
+            ++it;
+    }
+
+    // fill in the widths of code points in each TextElement
+    const GlyphMap::const_iterator WIDE_SPACE_IT = m_glyphs.find(WIDE_SPACE);
+    for (std::size_t i = 0; i < text_elements.size(); ++i) {
+        std::string::const_iterator it = text_elements[i]->text.begin();
+        std::string::const_iterator end_it = text_elements[i]->text.end();
+        while (it != end_it) {
+            text_elements[i]->widths.push_back(X0);
+            boost::uint32_t c = utf8::next(it, end_it);
+            if (c != WIDE_NEWLINE) {
+                GlyphMap::const_iterator it = m_glyphs.find(c);
+                // use a space when an unrendered glyph is requested (the
+                // space chararacter is always renderable)
+                if (it == m_glyphs.end())
+                    it = WIDE_SPACE_IT;
+                text_elements[i]->widths.back() = it->second.advance;
             }
         }
+    }
 
 #if DEBUG_DETERMINELINES
-        std::cout << "results of parse:\n";
-        for (std::size_t i = 0; i < text_elements.size(); ++i) {
-            if (boost::shared_ptr<FormattingTag> tag_elem = boost::dynamic_pointer_cast<FormattingTag>(text_elements[i])) {
-                std::cout << "FormattingTag\n    text=\"" << tag_elem->text << "\" (@ "
-                          << static_cast<const void*>(&*tag_elem->text.begin()) << ")\n    widths=";
-                for (std::size_t j = 0; j < tag_elem->widths.size(); ++j) {
-                    std::cout << tag_elem->widths[j] << " ";
-                }
-                std::cout << "\n    whitespace=" << tag_elem->whitespace << "\n    newline=" << tag_elem->newline << "\n    params=\n";
-                for (std::size_t j = 0; j < tag_elem->params.size(); ++j) {
-                    std::cout << "        \"" << tag_elem->params[j] << "\"\n";
-                }
-                std::cout << "    tag_name=\"" << tag_elem->tag_name << "\"\n    close_tag=" << tag_elem->close_tag << "\n";
-            } else {
-                boost::shared_ptr<TextElement> elem = text_elements[i];
-                std::cout << "TextElement\n    text=\"" << elem->text << "\" (@ "
-                          << static_cast<const void*>(&*elem->text.begin()) << ")\n    widths=";
-                for (std::size_t j = 0; j < elem->widths.size(); ++j) {
-                    std::cout << elem->widths[j] << " ";
-                }
-                std::cout << "\n    whitespace=" << elem->whitespace << "\n    newline=" << elem->newline << "\n";
+    std::cout << "results of parse:\n";
+    for (std::size_t i = 0; i < text_elements.size(); ++i) {
+        if (boost::shared_ptr<FormattingTag> tag_elem = boost::dynamic_pointer_cast<FormattingTag>(text_elements[i])) {
+            std::cout << "FormattingTag\n    text=\"" << tag_elem->text << "\" (@ "
+                      << static_cast<const void*>(&*tag_elem->text.begin()) << ")\n    widths=";
+            for (std::size_t j = 0; j < tag_elem->widths.size(); ++j) {
+                std::cout << tag_elem->widths[j] << " ";
+            }
+            std::cout << "\n    whitespace=" << tag_elem->whitespace << "\n    newline=" << tag_elem->newline << "\n    params=\n";
+            for (std::size_t j = 0; j < tag_elem->params.size(); ++j) {
+                std::cout << "        \"" << tag_elem->params[j] << "\"\n";
+            }
+            std::cout << "    tag_name=\"" << tag_elem->tag_name << "\"\n    close_tag=" << tag_elem->close_tag << "\n";
+        } else {
+            boost::shared_ptr<TextElement> elem = text_elements[i];
+            std::cout << "TextElement\n    text=\"" << elem->text << "\" (@ "
+                      << static_cast<const void*>(&*elem->text.begin()) << ")\n    widths=";
+            for (std::size_t j = 0; j < elem->widths.size(); ++j) {
+                std::cout << elem->widths[j] << " ";
             }
-            std::cout << "    string_size=" << text_elements[i]->StringSize() << "\n";
-            std::cout << "\n";
+            std::cout << "\n    whitespace=" << elem->whitespace << "\n    newline=" << elem->newline << "\n";
         }
-        std::cout << std::endl;
-#endif
+        std::cout << "    string_size=" << text_elements[i]->StringSize() << "\n";
+        std::cout << "\n";
     }
+    std::cout << std::endl;
+#endif
+}
 
+Pt Font::LayOutLines(const std::string& text,
+                     Flags<TextFormat> format,
+                     X box_width,
+                     const std::vector<boost::shared_ptr<TextElement> >& text_elements,
+                     std::vector<LineData>& line_data) const
+{
     RenderState render_state;
     int tab_width = 8; // default tab width
     X tab_pixel_width = tab_width * m_space_width; // get the length of a tab stop
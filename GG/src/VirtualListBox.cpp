@@ -0,0 +1,737 @@
+/* GG is a GUI for SDL and OpenGL.
+   Copyright (C) 2003-2008 T. Zachary Laine
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public License
+   as published by the Free Software Foundation; either version 2.1
+   of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free
+   Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307 USA
+
+   If you do not wish to comply with the terms of the LGPL please
+   contact the author as other terms are available for a fee.
+
+   Zach Laine
+   whatwasthataddress@gmail.com */
+
+#include <GG/VirtualListBox.h>
+
+#include <GG/GUI.h>
+#include <GG/DrawUtil.h>
+#include <GG/Scroll.h>
+#include <GG/StyleFactory.h>
+#include <GG/WndEvent.h>
+
+#include <algorithm>
+
+
+using namespace GG;
+
+namespace {
+    const int SCROLL_WIDTH = 14;
+    const Y DEFAULT_ROW_HEIGHT(22);
+}
+
+////////////////////////////////////////////////
+// GG::VirtualListBox::Model
+////////////////////////////////////////////////
+VirtualListBox::Model::~Model()
+{}
+
+bool VirtualListBox::Model::SortLess(std::size_t lhs, std::size_t rhs, std::size_t column) const
+{ return SortKey(lhs, column) < SortKey(rhs, column); }
+
+
+////////////////////////////////////////////////
+// GG::VirtualListBox::SortLessFunctor
+////////////////////////////////////////////////
+struct VirtualListBox::SortLessFunctor
+{
+    SortLessFunctor(const Model& model, std::size_t col, bool invert) :
+        m_model(model),
+        m_sort_col(col),
+        m_invert(invert)
+    {}
+
+    bool operator()(std::size_t lhs, std::size_t rhs) const
+    { return m_invert ? m_model.SortLess(rhs, lhs, m_sort_col) : m_model.SortLess(lhs, rhs, m_sort_col); }
+
+    const Model&    m_model;
+    std::size_t     m_sort_col;
+    bool            m_invert;
+};
+
+
+////////////////////////////////////////////////
+// GG::VirtualListBox
+////////////////////////////////////////////////
+// static(s)
+const std::size_t VirtualListBox::NO_ROW = static_cast<std::size_t>(-1);
+const unsigned int VirtualListBox::BORDER_THICK = 2;
+
+VirtualListBox::VirtualListBox(Clr color, Clr interior/* = CLR_ZERO*/) :
+    Control(X0, Y0, X1, Y1, INTERACTIVE),
+    m_model(0),
+    m_order(),
+    m_positions(),
+    m_row_wnds(),
+    m_row_wnd_rows(),
+    m_vscroll(0),
+    m_vscroll_wheel_scroll_increment(0),
+    m_first_row_shown(0),
+    m_row_height(DEFAULT_ROW_HEIGHT),
+    m_selections(),
+    m_caret(NO_ROW),
+    m_old_sel_row(NO_ROW),
+    m_old_sel_row_selected(false),
+    m_old_rdown_row(NO_ROW),
+    m_lclick_row(NO_ROW),
+    m_int_color(interior),
+    m_hilite_color(CLR_SHADOW),
+    m_style(LIST_NONE),
+    m_header_row(new ListBox::Row()),
+    m_sort_col(0)
+{
+    Control::SetColor(color);
+    SetChildClippingMode(ClipToClient);
+    InstallEventFilter(this);
+}
+
+VirtualListBox::~VirtualListBox()
+{ delete m_header_row; }
+
+Pt VirtualListBox::MinUsableSize() const
+{
+    return Pt(X(5 * SCROLL_WIDTH + 2 * BORDER_THICK),
+              Y(5 * SCROLL_WIDTH + 2 * BORDER_THICK));
+}
+
+Pt VirtualListBox::ClientUpperLeft() const
+{
+    return UpperLeft() +
+        Pt(X(BORDER_THICK), static_cast<int>(BORDER_THICK) + (m_header_row->empty() ? Y0 : m_header_row->Height()));
+}
+
+Pt VirtualListBox::ClientLowerRight() const
+{ return LowerRight() - Pt(X(static_cast<int>(BORDER_THICK) + (m_vscroll ? SCROLL_WIDTH : 0)), Y(BORDER_THICK)); }
+
+VirtualListBox::Model* VirtualListBox::GetModel() const
+{ return m_model; }
+
+bool VirtualListBox::Empty() const
+{ return m_order.empty(); }
+
+std::size_t VirtualListBox::NumRows() const
+{ return m_order.size(); }
+
+const VirtualListBox::SelectionSet& VirtualListBox::Selections() const
+{ return m_selections; }
+
+bool VirtualListBox::Selected(std::size_t row) const
+{ return m_selections.find(row) != m_selections.end(); }
+
+std::size_t VirtualListBox::Caret() const
+{ return m_caret; }
+
+Clr VirtualListBox::InteriorColor() const
+{ return m_int_color; }
+
+Clr VirtualListBox::HiliteColor() const
+{ return m_hilite_color; }
+
+Y VirtualListBox::RowHeight() const
+{ return m_row_height; }
+
+Flags<ListBoxStyle> VirtualListBox::Style() const
+{ return m_style; }
+
+std::size_t VirtualListBox::SortCol() const
+{ return m_sort_col; }
+
+const ListBox::Row& VirtualListBox::ColHeaders() const
+{ return *m_header_row; }
+
+std::size_t VirtualListBox::FirstRowShown() const
+{ return m_first_row_shown; }
+
+std::size_t VirtualListBox::RowAtPosition(std::size_t position) const
+{ return position < m_order.size() ? m_order[position] : NO_ROW; }
+
+std::size_t VirtualListBox::RowUnderPt(const Pt& pt) const
+{
+    if (!InClient(pt))
+        return NO_ROW;
+    std::size_t slot = Value(pt.y - ClientUpperLeft().y) / Value(m_row_height);
+    return RowAtPosition(m_first_row_shown + slot);
+}
+
+ListBox::Row* VirtualListBox::RowWnd(std::size_t row) const
+{
+    if (row == NO_ROW)
+        return 0;
+    for (std::size_t i = 0; i < m_row_wnds.size(); ++i) {
+        if (m_row_wnd_rows[i] == row)
+            return m_row_wnds[i];
+    }
+    return 0;
+}
+
+void VirtualListBox::Render()
+{
+    // draw beveled rectangle around client area
+    Pt ul = UpperLeft(), lr = LowerRight();
+    Pt cl_ul = ClientUpperLeft(), cl_lr = ClientLowerRight();
+    Clr color_to_use = Disabled() ? DisabledColor(Color()) : Color();
+    Clr int_color_to_use = Disabled() ? DisabledColor(m_int_color) : m_int_color;
+    Clr hilite_color_to_use = Disabled() ? DisabledColor(m_hilite_color) : m_hilite_color;
+
+    BeveledRectangle(ul, lr, int_color_to_use, color_to_use, false, BORDER_THICK);
+
+    BeginClipping();
+
+    // draw selection hiliting and caret; only the shown slots need be checked
+    bool has_focus = MatchesOrContains(this, GUI::GetGUI()->FocusWnd());
+    for (std::size_t i = 0; i < m_row_wnd_rows.size(); ++i) {
+        std::size_t row = m_row_wnd_rows[i];
+        if (row == NO_ROW)
+            continue;
+        Y top = cl_ul.y + m_row_height * static_cast<int>(i);
+        if (cl_lr.y <= top)
+            break;
+        Y bottom = std::min(top + m_row_height, cl_lr.y);
+        if (Selected(row))
+            FlatRectangle(Pt(cl_ul.x, top), Pt(cl_lr.x, bottom), hilite_color_to_use, CLR_ZERO, 0);
+        if (row == m_caret && has_focus)
+            FlatRectangle(Pt(cl_ul.x, top), Pt(cl_lr.x, bottom), CLR_ZERO, CLR_SHADOW, 2);
+    }
+
+    EndClipping();
+
+    // As in ListBox, the headers and scroll do not fall within the client
+    // area, so they are rendered explicitly here.
+    if (!m_header_row->empty()) {
+        Rect header_area(Pt(ul.x + static_cast<int>(BORDER_THICK), m_header_row->Top()),
+                         Pt(lr.x - static_cast<int>(BORDER_THICK), m_header_row->Bottom()));
+        BeginScissorClipping(header_area.ul, header_area.lr);
+        GUI::GetGUI()->RenderWindow(m_header_row);
+        EndScissorClipping();
+    }
+    if (m_vscroll)
+        GUI::GetGUI()->RenderWindow(m_vscroll);
+}
+
+void VirtualListBox::SizeMove(const Pt& ul, const Pt& lr)
+{
+    Wnd::SizeMove(ul, lr);
+    AdjustScrolls(true);
+    LayoutRows();
+}
+
+void VirtualListBox::KeyPress(Key key, boost::uint32_t key_code_point, Flags<ModKey> mod_keys)
+{
+    if (Disabled()) {
+        Control::KeyPress(key, key_code_point, mod_keys);
+        return;
+    }
+
+    // the caret moves by display position, not by model row
+    std::size_t caret_position = PositionOfRow(m_caret);
+    std::size_t last_position = m_order.empty() ? 0 : m_order.size() - 1;
+    std::size_t page_rows = std::max(1, Value(ClientSize().y) / Value(m_row_height));
+
+    switch (key) {
+    case GGK_SPACE: // space bar (selects item under caret like a mouse click)
+        if (caret_position != NO_ROW && !(m_style & LIST_NOSEL)) {
+            m_old_sel_row_selected = Selected(m_caret);
+            ClickAtRow(m_caret, mod_keys);
+        }
+        return;
+
+    // vertical scrolling keys
+    case GGK_UP: // arrow-up (not numpad arrow)
+        if (caret_position != NO_ROW && caret_position != 0)
+            --caret_position;
+        break;
+    case GGK_DOWN: // arrow-down (not numpad arrow)
+        if (caret_position != NO_ROW && caret_position != last_position)
+            ++caret_position;
+        break;
+    case GGK_PAGEUP: // page up key (not numpad key)
+        if (caret_position != NO_ROW)
+            caret_position -= std::min(caret_position, page_rows);
+        break;
+    case GGK_PAGEDOWN: // page down key (not numpad key)
+        if (caret_position != NO_ROW)
+            caret_position = std::min(caret_position + page_rows, last_position);
+        break;
+    case GGK_HOME: // home key (not numpad)
+        if (caret_position != NO_ROW)
+            caret_position = 0;
+        break;
+    case GGK_END: // end key (not numpad)
+        if (caret_position != NO_ROW)
+            caret_position = last_position;
+        break;
+
+    // any other key, including delete and horizontal scrolling keys, which
+    // are not supported, gets passed along to the parent
+    default:
+        Control::KeyPress(key, key_code_point, mod_keys);
+        return;
+    }
+
+    if (caret_position != NO_ROW) {
+        m_caret = m_order[caret_position];
+        BringRowIntoView(m_caret);
+    }
+}
+
+void VirtualListBox::MouseWheel(const Pt& pt, int move, Flags<ModKey> mod_keys)
+{
+    if (Disabled() || !m_vscroll)
+        return;
+    m_vscroll->ScrollLineIncr(-move);
+    SignalScroll(*m_vscroll, true);
+}
+
+void VirtualListBox::Disable(bool b/* = true*/)
+{
+    Control::Disable(b);
+    if (m_vscroll)
+        m_vscroll->Disable(b);
+}
+
+void VirtualListBox::SetColor(Clr c)
+{
+    Control::SetColor(c);
+    if (m_vscroll)
+        m_vscroll->SetColor(c);
+}
+
+void VirtualListBox::SetModel(Model* model)
+{
+    DeleteRowWnds();
+    m_model = model;
+    m_first_row_shown = 0;
+    ModelChanged();
+}
+
+void VirtualListBox::ModelChanged()
+{
+    m_selections.clear();
+    m_caret = NO_ROW;
+    m_old_sel_row = NO_ROW;
+    m_old_rdown_row = NO_ROW;
+    m_lclick_row = NO_ROW;
+
+    Resort();
+    m_first_row_shown = std::min(m_first_row_shown, MaxFirstRowShown());
+    std::fill(m_row_wnd_rows.begin(), m_row_wnd_rows.end(), NO_ROW);
+
+    AdjustScrolls(false);
+    LayoutRows();
+}
+
+void VirtualListBox::RowsChanged()
+{
+    std::fill(m_row_wnd_rows.begin(), m_row_wnd_rows.end(), NO_ROW);
+    LayoutRows();
+}
+
+void VirtualListBox::RowChanged(std::size_t row)
+{
+    if (!m_model)
+        return;
+    if (ListBox::Row* row_wnd = RowWnd(row))
+        m_model->UpdateRow(*row_wnd, row);
+}
+
+void VirtualListBox::SetRowHeight(Y h)
+{
+    if (h < Y1)
+        h = Y1;
+    if (h == m_row_height)
+        return;
+    m_row_height = h;
+    m_first_row_shown = std::min(m_first_row_shown, MaxFirstRowShown());
+    AdjustScrolls(false);
+    LayoutRows();
+}
+
+void VirtualListBox::SetStyle(Flags<ListBoxStyle> s)
+{
+    // at most one of the selection styles may be used
+    int dup_ct = 0;
+    if (s & LIST_NOSEL) ++dup_ct;
+    if (s & LIST_SINGLESEL) ++dup_ct;
+    if (s & LIST_QUICKSEL) ++dup_ct;
+    if (1 < dup_ct)
+        s &= ~(LIST_NOSEL | LIST_SINGLESEL | LIST_QUICKSEL);
+
+    Flags<ListBoxStyle> old_style = m_style;
+    m_style = s;
+
+    if ((old_style & (LIST_NOSORT | LIST_SORTDESCENDING)) != (m_style & (LIST_NOSORT | LIST_SORTDESCENDING))) {
+        Resort();
+        RowsChanged();
+    }
+}
+
+void VirtualListBox::SetSortCol(std::size_t n)
+{
+    bool needs_resort = !(m_style & LIST_NOSORT) && m_sort_col != n;
+    m_sort_col = n;
+    if (needs_resort) {
+        Resort();
+        RowsChanged();
+    }
+}
+
+void VirtualListBox::SetColHeaders(ListBox::Row* r)
+{
+    delete m_header_row;
+    if (r) {
+        m_header_row = r;
+        m_header_row->MoveTo(Pt(X0, -m_header_row->Height()));
+        AttachChild(m_header_row);
+    } else {
+        m_header_row = new ListBox::Row();
+    }
+    AdjustScrolls(true);
+    LayoutRows();
+}
+
+void VirtualListBox::SetInteriorColor(Clr c)
+{ m_int_color = c; }
+
+void VirtualListBox::SetHiliteColor(Clr c)
+{ m_hilite_color = c; }
+
+void VirtualListBox::SelectRow(std::size_t row, bool signal/* = false*/)
+{
+    if (row >= m_order.size() || Selected(row))
+        return;
+    if (m_style & LIST_SINGLESEL)
+        m_selections.clear();
+    m_selections.insert(row);
+    if (signal)
+        SelChangedSignal(m_selections);
+}
+
+void VirtualListBox::DeselectRow(std::size_t row, bool signal/* = false*/)
+{
+    if (m_selections.erase(row) && signal)
+        SelChangedSignal(m_selections);
+}
+
+void VirtualListBox::DeselectAll(bool signal/* = false*/)
+{
+    if (m_selections.empty())
+        return;
+    m_selections.clear();
+    if (signal)
+        SelChangedSignal(m_selections);
+}
+
+void VirtualListBox::SetSelections(const SelectionSet& s, bool signal/* = false*/)
+{
+    SelectionSet new_selections;
+    for (SelectionSet::const_iterator it = s.begin(); it != s.end(); ++it) {
+        if (*it < m_order.size())
+            new_selections.insert(*it);
+    }
+    if (new_selections == m_selections)
+        return;
+    m_selections.swap(new_selections);
+    if (signal)
+        SelChangedSignal(m_selections);
+}
+
+void VirtualListBox::SetFirstRowShown(std::size_t position)
+{
+    m_first_row_shown = std::min(position, MaxFirstRowShown());
+    if (m_vscroll)
+        m_vscroll->ScrollTo(Value(m_row_height) * static_cast<int>(m_first_row_shown));
+    LayoutRows();
+}
+
+void VirtualListBox::BringRowIntoView(std::size_t row)
+{
+    std::size_t position = PositionOfRow(row);
+    if (position == NO_ROW)
+        return;
+    std::size_t full_rows = std::max(1, Value(ClientSize().y) / Value(m_row_height));
+    if (position < m_first_row_shown)
+        SetFirstRowShown(position);
+    else if (m_first_row_shown + full_rows <= position)
+        SetFirstRowShown(position + 1 - full_rows);
+}
+
+void VirtualListBox::SetVScrollWheelIncrement(unsigned int increment)
+{
+    m_vscroll_wheel_scroll_increment = increment;
+    AdjustScrolls(false);
+}
+
+bool VirtualListBox::EventFilter(Wnd* w, const WndEvent& event)
+{
+    if (Disabled())
+        return true;
+
+    Pt pt = event.Point();
+    Flags<ModKey> mod_keys = event.ModKeys();
+
+    switch (event.Type()) {
+    case WndEvent::LButtonDown: {
+        m_old_sel_row = RowUnderPt(pt);
+        if (m_old_sel_row != NO_ROW) {
+            m_old_sel_row_selected = Selected(m_old_sel_row);
+            if (!(m_style & LIST_NOSEL) && !m_old_sel_row_selected)
+                ClickAtRow(m_old_sel_row, mod_keys);
+        }
+        break;
+    }
+
+    case WndEvent::LButtonUp: {
+        m_old_sel_row = NO_ROW;
+        break;
+    }
+
+    case WndEvent::LClick: {
+        if (m_old_sel_row != NO_ROW) {
+            std::size_t sel_row = RowUnderPt(pt);
+            if (sel_row == m_old_sel_row) {
+                if (m_style & LIST_NOSEL)
+                    m_caret = sel_row;
+                else
+                    ClickAtRow(sel_row, mod_keys);
+                m_lclick_row = sel_row;
+                LeftClickedSignal(sel_row, pt);
+            }
+        }
+        break;
+    }
+
+    case WndEvent::LDoubleClick: {
+        std::size_t row = RowUnderPt(pt);
+        if (row != NO_ROW && row == m_lclick_row) {
+            DoubleClickedSignal(row);
+            m_old_sel_row = NO_ROW;
+        } else {
+            LClick(pt, mod_keys);
+        }
+        break;
+    }
+
+    case WndEvent::RButtonDown: {
+        m_old_rdown_row = RowUnderPt(pt);
+        break;
+    }
+
+    case WndEvent::RClick: {
+        std::size_t row = RowUnderPt(pt);
+        if (row != NO_ROW && row == m_old_rdown_row)
+            RightClickedSignal(row, pt);
+        m_old_rdown_row = NO_ROW;
+        break;
+    }
+
+    case WndEvent::GainingFocus: {
+        if (w == this)
+            return false;
+        GUI::GetGUI()->SetFocusWnd(this);
+        break;
+    }
+
+    case WndEvent::MouseWheel:
+    case WndEvent::KeyPress:
+    case WndEvent::KeyRelease:
+    case WndEvent::TimerFiring:
+        return false;
+
+    default:
+        break;
+    }
+
+    return true;
+}
+
+std::size_t VirtualListBox::NumRowSlots() const
+{
+    // one more than the number of rows that fit entirely, for a partially
+    // shown row at the bottom
+    std::size_t slots = std::max(0, Value(ClientSize().y)) / Value(m_row_height) + 1;
+    return std::min(slots, m_order.size());
+}
+
+std::size_t VirtualListBox::MaxFirstRowShown() const
+{
+    std::size_t full_rows = std::max(1, Value(ClientSize().y) / Value(m_row_height));
+    return full_rows < m_order.size() ? m_order.size() - full_rows : 0;
+}
+
+std::size_t VirtualListBox::PositionOfRow(std::size_t row) const
+{ return row < m_positions.size() ? m_positions[row] : NO_ROW; }
+
+void VirtualListBox::Resort()
+{
+    std::size_t num_rows = m_model ? m_model->NumRows() : 0;
+    m_order.resize(num_rows);
+    for (std::size_t i = 0; i < num_rows; ++i)
+        m_order[i] = i;
+
+    if (m_model && !(m_style & LIST_NOSORT))
+        std::stable_sort(m_order.begin(), m_order.end(),
+                         SortLessFunctor(*m_model, m_sort_col, m_style & LIST_SORTDESCENDING));
+
+    m_positions.resize(num_rows);
+    for (std::size_t i = 0; i < num_rows; ++i)
+        m_positions[m_order[i]] = i;
+}
+
+void VirtualListBox::LayoutRows()
+{
+    if (!m_model)
+        return;
+
+    const std::size_t slots = NumRowSlots();
+    const Pt row_size(ClientSize().x, m_row_height);
+
+    // only create as many Row widgets as can be shown at once; these are
+    // rebound to different model rows as the list scrolls
+    while (m_row_wnds.size() < slots) {
+        ListBox::Row* row_wnd = m_model->CreateRow(row_size.x, row_size.y);
+        row_wnd->InstallEventFilter(this);
+        AttachChild(row_wnd);
+        m_row_wnds.push_back(row_wnd);
+        m_row_wnd_rows.push_back(NO_ROW);
+    }
+
+    for (std::size_t i = 0; i < m_row_wnds.size(); ++i) {
+        ListBox::Row* row_wnd = m_row_wnds[i];
+        std::size_t row = i < slots ? RowAtPosition(m_first_row_shown + i) : NO_ROW;
+        if (row == NO_ROW) {
+            m_row_wnd_rows[i] = NO_ROW;
+            row_wnd->Hide();
+            continue;
+        }
+        if (row_wnd->Size() != row_size)
+            row_wnd->Resize(row_size);
+        row_wnd->MoveTo(Pt(X0, m_row_height * static_cast<int>(i)));
+        if (m_row_wnd_rows[i] != row) {
+            m_model->UpdateRow(*row_wnd, row);
+            m_row_wnd_rows[i] = row;
+        }
+        row_wnd->Show();
+    }
+}
+
+void VirtualListBox::AdjustScrolls(bool adjust_for_resize)
+{
+    // this client area calculation disregards the thickness of scrolls
+    Pt cl_sz = (LowerRight() - Pt(X(BORDER_THICK), Y(BORDER_THICK))) -
+        (UpperLeft() + Pt(X(BORDER_THICK), static_cast<int>(BORDER_THICK)
+            + (m_header_row->empty()
+               ? Y0
+               : m_header_row->Height())));
+
+    Y total_y_extent = m_row_height * static_cast<int>(m_order.size());
+    bool vertical_needed = cl_sz.y < total_y_extent;
+
+    if (!vertical_needed) {
+        if (m_vscroll) {
+            DeleteChild(m_vscroll);
+            m_vscroll = 0;
+        }
+        m_first_row_shown = 0;
+        return;
+    }
+
+    if (!m_vscroll) {
+        m_vscroll = GetStyleFactory()->NewListBoxVScroll(m_color, CLR_SHADOW);
+        AttachChild(m_vscroll);
+        Connect(m_vscroll->ScrolledSignal, &VirtualListBox::VScrolled, this);
+        adjust_for_resize = true;
+    }
+
+    if (adjust_for_resize)
+        m_vscroll->SizeMove(Pt(cl_sz.x - SCROLL_WIDTH, Y0), Pt(cl_sz.x, cl_sz.y));
+
+    unsigned int line_size = m_vscroll_wheel_scroll_increment;
+    if (line_size == 0)
+        line_size = Value(m_row_height);
+    unsigned int page_size = std::abs(Value(cl_sz.y));
+
+    m_vscroll->SizeScroll(0, Value(total_y_extent - 1), line_size, std::max(line_size, page_size));
+    m_vscroll->ScrollTo(Value(m_row_height) * static_cast<int>(m_first_row_shown));
+    MoveChildUp(m_vscroll);
+}
+
+void VirtualListBox::VScrolled(int tab_low, int tab_high, int low, int high)
+{
+    std::size_t position = std::max(0, tab_low + Value(m_row_height) / 2) / Value(m_row_height);
+    m_first_row_shown = std::min(position, MaxFirstRowShown());
+    LayoutRows();
+}
+
+void VirtualListBox::ClickAtRow(std::size_t row, Flags<ModKey> mod_keys)
+{
+    if (row >= m_order.size())
+        return;
+
+    SelectionSet previous_selections = m_selections;
+
+    if (m_style & LIST_SINGLESEL) {
+        m_selections.clear();
+        m_selections.insert(row);
+        m_caret = row;
+    } else if (mod_keys & MOD_KEY_SHIFT) {
+        // select or deselect all rows shown between the caret and this row
+        // (inclusive), depending on whether the caret is selected
+        bool erase = false;
+        if (mod_keys & MOD_KEY_CTRL)
+            erase = m_caret != NO_ROW && !Selected(m_caret);
+        else if (!(m_style & LIST_QUICKSEL))
+            m_selections.clear();
+        if (m_caret == NO_ROW)
+            m_caret = m_order.front();
+        std::size_t low = std::min(PositionOfRow(m_caret), PositionOfRow(row));
+        std::size_t high = std::max(PositionOfRow(m_caret), PositionOfRow(row));
+        for (std::size_t position = low; position <= high; ++position) {
+            if (erase)
+                m_selections.erase(m_order[position]);
+            else
+                m_selections.insert(m_order[position]);
+        }
+    } else if (mod_keys & MOD_KEY_CTRL || m_style & LIST_QUICKSEL) {
+        // toggle the clicked row, and move the caret to it
+        if (m_old_sel_row_selected)
+            m_selections.erase(row);
+        else
+            m_selections.insert(row);
+        m_caret = row;
+    } else {
+        m_selections.clear();
+        m_selections.insert(row);
+        m_caret = row;
+    }
+
+    if (previous_selections != m_selections)
+        SelChangedSignal(m_selections);
+}
+
+void VirtualListBox::DeleteRowWnds()
+{
+    for (std::size_t i = 0; i < m_row_wnds.size(); ++i)
+        DeleteChild(m_row_wnds[i]);
+    m_row_wnds.clear();
+    m_row_wnd_rows.clear();
+}
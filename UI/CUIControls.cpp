@@ -37,6 +37,9 @@ namespace {
     void PlayListSelectSound(const GG::ListBox::SelectionSet&)
     { Sound::GetSound().PlaySound(GetOptionsDB().Get<std::string>("UI.sound.list-select"), true); }
 
+    void PlayVirtualListSelectSound(const GG::VirtualListBox::SelectionSet&)
+    { Sound::GetSound().PlaySound(GetOptionsDB().Get<std::string>("UI.sound.list-select"), true); }
+
     void PlayDropDownListOpenSound()
     { Sound::GetSound().PlaySound(GetOptionsDB().Get<std::string>("UI.sound.list-pulldown"), true); }
 
@@ -614,6 +617,24 @@ void CUIListBox::Render() {
 }
 
 
+///////////////////////////////////////
+// class CUIVirtualListBox
+///////////////////////////////////////
+CUIVirtualListBox::CUIVirtualListBox(void):
+    VirtualListBox(ClientUI::CtrlBorderColor(), ClientUI::CtrlColor())
+{ GG::Connect(SelChangedSignal, &PlayVirtualListSelectSound, -1); }
+
+void CUIVirtualListBox::Render() {
+    GG::Pt ul = UpperLeft(), lr = LowerRight();
+    GG::Clr color = Color(); // save color
+    GG::Clr color_to_use = Disabled() ? DisabledColor(color) : color;
+    FlatRectangle(ul, lr, InteriorColor(), color_to_use, 1);
+    SetColor(GG::CLR_ZERO); // disable the default border by rendering it transparently
+    VirtualListBox::Render();
+    SetColor(color); // restore color
+}
+
+
 ///////////////////////////////////////
 // class CUIDropDownList
 ///////////////////////////////////////
@@ -1519,7 +1540,8 @@ FPSIndicator::FPSIndicator(void) :
 
 void FPSIndicator::Render() {
     if (m_enabled) {
-        SetText(boost::io::str(FlexibleFormat(UserString("MAP_INDICATOR_FPS")) % static_cast<int>(GG::GUI::GetGUI()->FPS())));
+        static const UserStringKey MAP_INDICATOR_FPS_KEY("MAP_INDICATOR_FPS");
+        SetText(boost::io::str(FlexibleFormat(UserString(MAP_INDICATOR_FPS_KEY)) % static_cast<int>(GG::GUI::GetGUI()->FPS())));
         TextControl::Render();
     }
 }
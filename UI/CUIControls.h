@@ -14,6 +14,7 @@
 #include <GG/Slider.h>
 #include <GG/StaticGraphic.h>
 #include <GG/TabWnd.h>
+#include <GG/VirtualListBox.h>
 #include <GG/dialogs/FileDlg.h>
 
 #include <boost/function.hpp>
@@ -194,6 +195,18 @@ public:
     //@}
 };
 
+/** a FreeOrion VirtualListBox control */
+class CUIVirtualListBox : public GG::VirtualListBox {
+public:
+    /** \name Structors */ //@{
+    CUIVirtualListBox(void); ///< basic ctor
+    //@}
+
+    /** \name Mutators */ //@{
+    virtual void Render();
+    //@}
+};
+
 /** a FreeOrion DropDownList control */
 class CUIDropDownList : public GG::DropDownList {
 public:
@@ -629,6 +629,8 @@ bool ClientUI::ZoomToField(int id) {
 
 bool ClientUI::ZoomToCombatLog(int id) {
     if (GetCombatLogManager().LogAvailable(id)) {
+        // turn updates carry only log ids; get the contents when first shown
+        HumanClientApp::GetApp()->RequestCombatLogs(std::vector<int>(1, id));
         m_map_wnd->ShowCombatLog(id);
         return true;
     }
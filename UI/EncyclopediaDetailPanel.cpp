@@ -2170,8 +2170,6 @@ namespace {
         TemporaryPtr<Planet> planet = GetPlanet(planet_id);
 
         std::string original_planet_species = planet->SpeciesName();
-        int original_owner_id = planet->Owner();
-        float orig_initial_target_pop = planet->GetMeter(METER_TARGET_POPULATION)->Initial();
         name = planet->PublicName(planet_id);
 
         int empire_id = HumanClientApp::GetApp()->EmpireID();
@@ -2221,6 +2219,10 @@ namespace {
         GG::X max_species_name_column1_width(0);
 
         GetUniverse().InhibitUniverseObjectSignals(true);
+        // records the planet's owner and meters before they are changed
+        // below, so they can be put back without another estimate pass
+        UniverseSnapshot speculation(GetUniverse());
+        speculation.RecordMeters(planet_id);
 
         for (std::set<std::string>::const_iterator it = species_names.begin();
              it != species_names.end(); it++)
@@ -2235,7 +2237,7 @@ namespace {
             // preferences and tech.
             // @see also: MapWnd::UpdateMeterEstimates()
             planet->SetSpecies(species_name);
-            planet->SetOwner(empire_id);
+            speculation.SetOwner(planet, empire_id);
             planet->GetMeter(METER_TARGET_POPULATION)->Set(0.0, 0.0);
             GetUniverse().UpdateMeterEstimates(planet_id);
 
@@ -2300,12 +2302,9 @@ namespace {
         }
 
         planet->SetSpecies(original_planet_species);
-        planet->SetOwner(original_owner_id);
-        planet->GetMeter(METER_TARGET_POPULATION)->Set(orig_initial_target_pop, orig_initial_target_pop);
+        speculation.Restore();
 
         GetUniverse().InhibitUniverseObjectSignals(false);
-
-        GetUniverse().UpdateMeterEstimates(planet_id);
     }
 
     void GetRefreshDetailPanelInfo(         const std::string& item_type, const std::string& item_name,
@@ -653,6 +653,7 @@ MapWnd::MapWnd() :
     m_star_halo_quad_vertices(),
     m_galaxy_gas_quad_vertices(),
     m_star_texture_coords(),
+    m_system_quad_data(),
     m_starlane_vertices(),
     m_starlane_colors(),
     m_RC_starlane_vertices(),
@@ -1108,11 +1109,11 @@ MapWnd::MapWnd() :
     // not strictly necessary, as in principle whenever any ResourceCenter
     // changes, all meter estimates and resource pools should / could be
     // updated.  however, this is a convenience to limit the updates to
-    // what is actually being shown in the sidepanel right now, which is
+    // the changed planet and the objects its effects act on, which is
     // useful since most ResourceCenter changes will be due to focus
-    // changes on the sidepanel, and most differences in meter estimates
-    // and resource pools due to this will be in the same system
-    GG::Connect(SidePanel::ResourceCenterChangedSignal,     &MapWnd::UpdateSidePanelSystemObjectMetersAndResourcePools, this);
+    // changes on the sidepanel, and updating all estimates for each of
+    // them is slow in large universes
+    GG::Connect(SidePanel::ResourceCenterChangedSignal,     &MapWnd::UpdateMetersAndResourcePoolsForChangedPlanet, this);
 
     // situation report window
     m_sitrep_panel = new SitRepPanel(GG::X0, GG::Y0, SITREP_PANEL_WIDTH, SITREP_PANEL_HEIGHT);
@@ -1838,17 +1839,22 @@ void MapWnd::RenderMovementLineETAIndicators(const MapWnd::MovementLineData& mov
         glEnable(GL_TEXTURE_2D);
 
 
-        // render ETA number in white with black shadows
+        // render ETA number in white with black shadows, all in one draw call
         std::string text = boost::lexical_cast<std::string>(vert.eta);
+        std::vector<GG::Font::LineData> lines;
+        font->DetermineLines(text, flags, lr.x - ul.x, lines);
+        GG::Font::RenderCache cache;
 
-        glColor(GG::CLR_BLACK);
-        font->RenderText(ul + GG::Pt(-GG::X1,  GG::Y0), lr + GG::Pt(-GG::X1,  GG::Y0), text, flags);
-        font->RenderText(ul + GG::Pt( GG::X1,  GG::Y0), lr + GG::Pt( GG::X1,  GG::Y0), text, flags);
-        font->RenderText(ul + GG::Pt( GG::X0, -GG::Y1), lr + GG::Pt( GG::X0, -GG::Y1), text, flags);
-        font->RenderText(ul + GG::Pt( GG::X0,  GG::Y1), lr + GG::Pt( GG::X0,  GG::Y1), text, flags);
+        GG::Font::RenderState shadow_state(GG::CLR_BLACK);
+        font->StoreText(ul + GG::Pt(-GG::X1,  GG::Y0), lr + GG::Pt(-GG::X1,  GG::Y0), text, flags, cache, &lines, &shadow_state);
+        font->StoreText(ul + GG::Pt( GG::X1,  GG::Y0), lr + GG::Pt( GG::X1,  GG::Y0), text, flags, cache, &lines, &shadow_state);
+        font->StoreText(ul + GG::Pt( GG::X0, -GG::Y1), lr + GG::Pt( GG::X0, -GG::Y1), text, flags, cache, &lines, &shadow_state);
+        font->StoreText(ul + GG::Pt( GG::X0,  GG::Y1), lr + GG::Pt( GG::X0,  GG::Y1), text, flags, cache, &lines, &shadow_state);
 
-        glColor(GG::CLR_WHITE);
-        font->RenderText(ul, lr, text, flags);
+        GG::Font::RenderState text_state(GG::CLR_WHITE);
+        font->StoreText(ul, lr, text, flags, cache, &lines, &text_state);
+
+        font->RenderCachedText(cache);
     }
     glPopMatrix();
 }
@@ -2352,12 +2358,11 @@ void MapWnd::InitTurnRendering() {
     const std::set<int>& this_client_stale_object_info = GetUniverse().EmpireStaleKnowledgeObjectIDs(client_empire_id);
     const ObjectMap& objects = Objects();
 
-    // remove old system icons
-    for (std::map<int, SystemIcon*>::iterator it = m_system_icons.begin(); it != m_system_icons.end(); ++it)
-        DeleteChild(it->second);
-    m_system_icons.clear();
+    // keep the icons of systems that still exist and whose stars haven't
+    // changed, and create icons only for the other systems
+    std::map<int, SystemIcon*> old_system_icons;
+    old_system_icons.swap(m_system_icons);
 
-    // create system icons
     std::vector<TemporaryPtr<const System> > systems = objects.FindObjects<System>();
     for (std::vector<TemporaryPtr<const System> >::const_iterator sys_it = systems.begin();
          sys_it != systems.end(); ++sys_it)
@@ -2369,6 +2374,20 @@ void MapWnd::InitTurnRendering() {
         if (this_client_known_destroyed_objects.find(sys_id) != this_client_known_destroyed_objects.end())
             continue;
 
+        // reuse existing system icon
+        std::map<int, SystemIcon*>::iterator old_icon_it = old_system_icons.find(sys_id);
+        std::map<int, SystemQuadData>::const_iterator quad_data_it = m_system_quad_data.find(sys_id);
+        if (old_icon_it != old_system_icons.end() && quad_data_it != m_system_quad_data.end() &&
+            quad_data_it->second.star_type == sys->GetStarType())
+        {
+            SystemIcon* icon = old_icon_it->second;
+            old_system_icons.erase(old_icon_it);
+            m_system_icons[sys_id] = icon;
+            icon->SetSelected(SidePanel::SystemID() == sys_id);
+            icon->Refresh();
+            continue;
+        }
+
         // create new system icon
         SystemIcon* icon = new SystemIcon(GG::X0, GG::Y0, GG::X(10), sys_id);
         m_system_icons[sys_id] = icon;
@@ -2385,6 +2404,10 @@ void MapWnd::InitTurnRendering() {
         GG::Connect(icon->MouseLeavingSignal,       &MapWnd::MouseLeavingSystem,        this);
     }
 
+    // remove system icons that weren't reused
+    for (std::map<int, SystemIcon*>::iterator it = old_system_icons.begin(); it != old_system_icons.end(); ++it)
+        DeleteChild(it->second);
+
     // create buffers for system icon and galaxy gas rendering, and starlane rendering
     InitSystemRenderingBuffers();
     InitStarlaneRenderingBuffers();
@@ -2393,12 +2416,11 @@ void MapWnd::InitTurnRendering() {
     DoSystemIconsLayout();
 
 
-    // remove old field icons
-    for (std::map<int, FieldIcon*>::iterator it = m_field_icons.begin(); it != m_field_icons.end(); ++it)
-        DeleteChild(it->second);
-    m_field_icons.clear();
+    // keep the icons of fields that are still known, and create icons only
+    // for new fields
+    std::map<int, FieldIcon*> old_field_icons;
+    old_field_icons.swap(m_field_icons);
 
-    // create field icons
     std::vector<TemporaryPtr<const Field> > fields = objects.FindObjects<Field>();
     for (std::vector<TemporaryPtr<const Field> >::const_iterator fld_it = fields.begin(); fld_it != fields.end(); ++fld_it) {
         TemporaryPtr<const Field> field = *fld_it;
@@ -2413,6 +2435,16 @@ void MapWnd::InitTurnRendering() {
         //if (field->GetVisibility(client_empire_id) <= VIS_NO_VISIBILITY)
         //    continue;
 
+        // reuse existing field icon
+        std::map<int, FieldIcon*>::iterator old_icon_it = old_field_icons.find(fld_id);
+        if (old_icon_it != old_field_icons.end()) {
+            FieldIcon* icon = old_icon_it->second;
+            old_field_icons.erase(old_icon_it);
+            m_field_icons[fld_id] = icon;
+            icon->Refresh();
+            continue;
+        }
+
         // create new system icon
         FieldIcon* icon = new FieldIcon(fld_id);
         m_field_icons[fld_id] = icon;
@@ -2423,6 +2455,10 @@ void MapWnd::InitTurnRendering() {
         GG::Connect(icon->RightClickedSignal,   &MapWnd::FieldRightClicked, this);
     }
 
+    // remove field icons that weren't reused
+    for (std::map<int, FieldIcon*>::iterator it = old_field_icons.begin(); it != old_field_icons.end(); ++it)
+        DeleteChild(it->second);
+
     // position field icons
     DoFieldIconsLayout();
 
@@ -2436,59 +2472,117 @@ void MapWnd::InitTurnRendering() {
         MoveChildDown(it->second);
 }
 
+MapWnd::SystemQuadData::SystemQuadData() :
+    star_type(INVALID_STAR_TYPE),
+    x(0.0),
+    y(0.0),
+    icon_size(0.0)
+{}
+
+bool MapWnd::SystemQuadData::operator==(const SystemQuadData& rhs) const {
+    return star_type == rhs.star_type && x == rhs.x && y == rhs.y && icon_size == rhs.icon_size &&
+           disc_texture == rhs.disc_texture && halo_texture == rhs.halo_texture && gas_texture == rhs.gas_texture;
+}
+
 void MapWnd::InitSystemRenderingBuffers() {
     DebugLogger() << "MapWnd::InitSystemRenderingBuffers";
     ScopedTimer timer("MapWnd::InitSystemRenderingBuffers", true);
 
-    // clear out all the old buffers
-    ClearSystemRenderingBuffers();
+    // determine what each system's quads should be made from
+    std::map<int, SystemQuadData> quad_data;
+    const double icon_size = ClientUI::SystemIconSize();
+    for (std::map<int, SystemIcon*>::const_iterator it = m_system_icons.begin(); it != m_system_icons.end(); ++it) {
+        const SystemIcon* icon = it->second;
+        int system_id = it->first;
+        TemporaryPtr<const System> system = GetSystem(system_id);
+        if (!system) {
+            ErrorLogger() << "MapWnd::InitSystemRenderingBuffers couldn't get system with id " << system_id;
+            continue;
+        }
+
+        SystemQuadData& data = quad_data[system_id];
+        data.star_type = system->GetStarType();
+        data.x = system->X();
+        data.y = system->Y();
+        data.icon_size = icon_size;
+        data.disc_texture = icon->DiscTexture();
+        data.halo_texture = icon->HaloTexture();
+        data.gas_texture = ClientUI::GetClientUI()->GetModuloTexture(ClientUI::ArtDir() / "galaxy_decoration", "gaseous", system_id);
+    }
+
+    // find the textures whose buffers hold quads of systems that were added,
+    // removed or changed since the buffers were last made.  only those
+    // buffers need to be remade.
+    std::set<boost::shared_ptr<GG::Texture> > changed_textures;
+    for (std::map<int, SystemQuadData>::const_iterator it = m_system_quad_data.begin(); it != m_system_quad_data.end(); ++it) {
+        std::map<int, SystemQuadData>::const_iterator new_it = quad_data.find(it->first);
+        if (new_it != quad_data.end() && new_it->second == it->second)
+            continue;
+        changed_textures.insert(it->second.disc_texture);
+        changed_textures.insert(it->second.halo_texture);
+        changed_textures.insert(it->second.gas_texture);
+    }
+    for (std::map<int, SystemQuadData>::const_iterator it = quad_data.begin(); it != quad_data.end(); ++it) {
+        std::map<int, SystemQuadData>::const_iterator old_it = m_system_quad_data.find(it->first);
+        if (old_it != m_system_quad_data.end() && old_it->second == it->second)
+            continue;
+        changed_textures.insert(it->second.disc_texture);
+        changed_textures.insert(it->second.halo_texture);
+        changed_textures.insert(it->second.gas_texture);
+    }
+    changed_textures.erase(boost::shared_ptr<GG::Texture>());
+
+    m_system_quad_data.swap(quad_data);
 
     // Generate texture coordinates to be used for subsequent vertex buffer creation.
     // Note these coordinates assume the texture is twice as large as it should
     // be.  This allows us to use one set of texture coords for everything, even
     // though the star-halo textures must be rendered at sizes as much as twice
     // as large as the star-disc textures.
-    for (std::size_t i = 0; i < m_system_icons.size(); ++i) {
-        m_star_texture_coords.store(1.5,-0.5);
-        m_star_texture_coords.store(-0.5,-0.5);
-        m_star_texture_coords.store(-0.5,1.5);
-        m_star_texture_coords.store(1.5,1.5);
+    if (m_star_texture_coords.size() != 4 * m_system_icons.size()) {
+        m_star_texture_coords.clear();
+        for (std::size_t i = 0; i < m_system_icons.size(); ++i) {
+            m_star_texture_coords.store(1.5,-0.5);
+            m_star_texture_coords.store(-0.5,-0.5);
+            m_star_texture_coords.store(-0.5,1.5);
+            m_star_texture_coords.store(1.5,1.5);
+        }
+        m_star_texture_coords.createServerBuffer();
     }
 
+    if (changed_textures.empty())
+        return;
+    DebugLogger() << "MapWnd::InitSystemRenderingBuffers remaking buffers for " << changed_textures.size() << " textures";
 
-    for (std::map<int, SystemIcon*>::const_iterator it = m_system_icons.begin(); it != m_system_icons.end(); ++it) {
-        const SystemIcon* icon = it->second;
+    for (std::set<boost::shared_ptr<GG::Texture> >::const_iterator it = changed_textures.begin();
+         it != changed_textures.end(); ++it)
+    {
+        m_star_core_quad_vertices.erase(*it);
+        m_star_halo_quad_vertices.erase(*it);
+        m_galaxy_gas_quad_vertices.erase(*it);
+    }
+
+    for (std::map<int, SystemQuadData>::const_iterator it = m_system_quad_data.begin(); it != m_system_quad_data.end(); ++it) {
         int system_id = it->first;
-        TemporaryPtr<const System> system = GetSystem(system_id);
-        if (!system) {
-            ErrorLogger() << "MapWnd::InitSystemRenderingBuffers couldn't get system with id " << system_id;
-            continue;
-        }
+        const SystemQuadData& data = it->second;
 
         // Add disc and halo textures for system icon
         // See note above texture coords for why we're making coordinate sets that are 2x too big.
-        double icon_size = ClientUI::SystemIconSize();
-        float icon_ul_x = static_cast<float>(system->X() - icon_size);
-        float icon_ul_y = static_cast<float>(system->Y() - icon_size);
-        float icon_lr_x = static_cast<float>(system->X() + icon_size);
-        float icon_lr_y = static_cast<float>(system->Y() + icon_size);
-
-        if (icon->DiscTexture()) {
-            glBindTexture(GL_TEXTURE_2D, icon->DiscTexture()->OpenGLId());
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-            GG::GL2DVertexBuffer& core_vertices = m_star_core_quad_vertices[icon->DiscTexture()];
+        float icon_ul_x = static_cast<float>(data.x - data.icon_size);
+        float icon_ul_y = static_cast<float>(data.y - data.icon_size);
+        float icon_lr_x = static_cast<float>(data.x + data.icon_size);
+        float icon_lr_y = static_cast<float>(data.y + data.icon_size);
+
+        if (data.disc_texture && changed_textures.find(data.disc_texture) != changed_textures.end()) {
+            GG::GL2DVertexBuffer& core_vertices = m_star_core_quad_vertices[data.disc_texture];
             core_vertices.store(icon_lr_x,icon_ul_y);
             core_vertices.store(icon_ul_x,icon_ul_y);
             core_vertices.store(icon_ul_x,icon_lr_y);
             core_vertices.store(icon_lr_x,icon_lr_y);
         }
 
-        if (icon->HaloTexture()) {
-            glBindTexture(GL_TEXTURE_2D, icon->HaloTexture()->OpenGLId());
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-            GG::GL2DVertexBuffer& halo_vertices = m_star_halo_quad_vertices[icon->HaloTexture()];
+        if (data.halo_texture && changed_textures.find(data.halo_texture) != changed_textures.end()) {
+            GG::GL2DVertexBuffer& halo_vertices = m_star_halo_quad_vertices[data.halo_texture];
             halo_vertices.store(icon_lr_x,icon_ul_y);
             halo_vertices.store(icon_ul_x,icon_ul_y);
             halo_vertices.store(icon_ul_x,icon_lr_y);
@@ -2497,11 +2591,8 @@ void MapWnd::InitSystemRenderingBuffers() {
 
 
         // add (rotated) gaseous substance around system
-        if (boost::shared_ptr<GG::Texture> gaseous_texture = ClientUI::GetClientUI()->GetModuloTexture(ClientUI::ArtDir() / "galaxy_decoration", "gaseous", system_id)) {
-            glBindTexture(GL_TEXTURE_2D, gaseous_texture->OpenGLId());
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-            const double GAS_SIZE = ClientUI::SystemIconSize() * 12.0;
+        if (data.gas_texture && changed_textures.find(data.gas_texture) != changed_textures.end()) {
+            const double GAS_SIZE = data.icon_size * 12.0;
             const double ROTATION = system_id * 27.0; // arbitrary rotation in radians ("27.0" is just a number that produces pleasing results)
             const double COS_THETA = std::cos(ROTATION);
             const double SIN_THETA = std::sin(ROTATION);
@@ -2526,16 +2617,16 @@ void MapWnd::InitSystemRenderingBuffers() {
             // See note above texture coords for why we're making coordinate sets that are 2x too big.
 
             // add to system position to get translated scaled rotated quad corner
-            const float GAS_X1 = static_cast<float>(system->X() + (X1r * GAS_SIZE));
-            const float GAS_Y1 = static_cast<float>(system->Y() + (Y1r * GAS_SIZE));
-            const float GAS_X2 = static_cast<float>(system->X() + (X2r * GAS_SIZE));
-            const float GAS_Y2 = static_cast<float>(system->Y() + (Y2r * GAS_SIZE));
-            const float GAS_X3 = static_cast<float>(system->X() + (X3r * GAS_SIZE));
-            const float GAS_Y3 = static_cast<float>(system->Y() + (Y3r * GAS_SIZE));
-            const float GAS_X4 = static_cast<float>(system->X() + (X4r * GAS_SIZE));
-            const float GAS_Y4 = static_cast<float>(system->Y() + (Y4r * GAS_SIZE));
+            const float GAS_X1 = static_cast<float>(data.x + (X1r * GAS_SIZE));
+            const float GAS_Y1 = static_cast<float>(data.y + (Y1r * GAS_SIZE));
+            const float GAS_X2 = static_cast<float>(data.x + (X2r * GAS_SIZE));
+            const float GAS_Y2 = static_cast<float>(data.y + (Y2r * GAS_SIZE));
+            const float GAS_X3 = static_cast<float>(data.x + (X3r * GAS_SIZE));
+            const float GAS_Y3 = static_cast<float>(data.y + (Y3r * GAS_SIZE));
+            const float GAS_X4 = static_cast<float>(data.x + (X4r * GAS_SIZE));
+            const float GAS_Y4 = static_cast<float>(data.y + (Y4r * GAS_SIZE));
 
-            GG::GL2DVertexBuffer& gas_vertices = m_galaxy_gas_quad_vertices[gaseous_texture];
+            GG::GL2DVertexBuffer& gas_vertices = m_galaxy_gas_quad_vertices[data.gas_texture];
 
             gas_vertices.store(GAS_X1,GAS_Y1); // rotated upper right
             gas_vertices.store(GAS_X2,GAS_Y2); // rotated upper left
@@ -2544,25 +2635,30 @@ void MapWnd::InitSystemRenderingBuffers() {
         }
     }
 
-    // create new buffers
-
-    // star cores
-    for (std::map<boost::shared_ptr<GG::Texture>, GG::GL2DVertexBuffer>::const_iterator it =
-             m_star_core_quad_vertices.begin(); it != m_star_core_quad_vertices.end(); ++it)
-    { m_star_core_quad_vertices[it->first].createServerBuffer(); }
+    // create new buffers for the changed textures
+    for (std::set<boost::shared_ptr<GG::Texture> >::const_iterator it = changed_textures.begin();
+         it != changed_textures.end(); ++it)
+    {
+        glBindTexture(GL_TEXTURE_2D, (*it)->OpenGLId());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
 
-    // star halos
-    for (std::map<boost::shared_ptr<GG::Texture>, GG::GL2DVertexBuffer>::const_iterator it = m_star_halo_quad_vertices.begin();
-         it != m_star_halo_quad_vertices.end(); ++it)
-    { m_star_halo_quad_vertices[it->first].createServerBuffer(); }
+        // star cores
+        std::map<boost::shared_ptr<GG::Texture>, GG::GL2DVertexBuffer>::iterator buffer_it =
+            m_star_core_quad_vertices.find(*it);
+        if (buffer_it != m_star_core_quad_vertices.end())
+            buffer_it->second.createServerBuffer();
 
-    // galaxy gas
-    for (std::map<boost::shared_ptr<GG::Texture>, GG::GL2DVertexBuffer>::const_iterator it = m_galaxy_gas_quad_vertices.begin();
-         it != m_galaxy_gas_quad_vertices.end(); ++it)
-    { m_galaxy_gas_quad_vertices[it->first].createServerBuffer(); }
+        // star halos
+        buffer_it = m_star_halo_quad_vertices.find(*it);
+        if (buffer_it != m_star_halo_quad_vertices.end())
+            buffer_it->second.createServerBuffer();
 
-    // fill buffers with star textures
-    m_star_texture_coords.createServerBuffer();
+        // galaxy gas
+        buffer_it = m_galaxy_gas_quad_vertices.find(*it);
+        if (buffer_it != m_galaxy_gas_quad_vertices.end())
+            buffer_it->second.createServerBuffer();
+    }
 }
 
 void MapWnd::ClearSystemRenderingBuffers() {
@@ -2570,6 +2666,7 @@ void MapWnd::ClearSystemRenderingBuffers() {
     m_star_halo_quad_vertices.clear();
     m_galaxy_gas_quad_vertices.clear();
     m_star_texture_coords.clear();
+    m_system_quad_data.clear();
 }
 
 std::vector<int> MapWnd::GetLeastJumps(int startSys, int endSys, const std::set<int>& resGroup,
@@ -4623,6 +4720,10 @@ void MapWnd::Sanitize() {
         delete it->second;
     m_system_icons.clear();
 
+    for (std::map<int, FieldIcon*>::iterator it = m_field_icons.begin(); it != m_field_icons.end(); ++it)
+        delete it->second;
+    m_field_icons.clear();
+
     m_scanline_shader.reset();
 
     m_fleets_exploring.clear();
@@ -5255,8 +5356,8 @@ void MapWnd::RefreshPopulationIndicator() {
         new CensusBrowseWnd(UserString("MAP_POPULATION_DISTRIBUTION"), population_counts, tag_counts)));
 }
 
-void MapWnd::UpdateSidePanelSystemObjectMetersAndResourcePools() {
-    GetUniverse().UpdateMeterEstimates(SidePanel::SystemID(), true);
+void MapWnd::UpdateMetersAndResourcePoolsForChangedPlanet(int planet_id) {
+    GetUniverse().UpdateMeterEstimatesForChangedObject(planet_id);
     UpdateEmpireResourcePools();
 }
 
@@ -176,7 +176,7 @@ private:
     void            RefreshPopulationIndicator();
     void            RefreshDetectionIndicator();
 
-    void            UpdateSidePanelSystemObjectMetersAndResourcePools();                                ///< update meter estimates for objects contained within the current system shown in the sidepanel, or all objects if there is no system shown
+    void            UpdateMetersAndResourcePoolsForChangedPlanet(int planet_id);                        ///< update meter estimates for planet with id \a planet_id, which has had its resourcecenter changed, and for objects affected by it
     void            UpdateEmpireResourcePools();                                                        ///< recalculates production and predicted changes of player's empire's resource and population pools
 
     /** contains information necessary to render a single fleet movement line on the main map. also
@@ -390,10 +390,27 @@ private:
 
     std::pair<int, int>                 m_line_between_systems;                             //!< set when map should render line connecting 2 systems
 
+    /** The inputs from which a system's icon and its star and galaxy gas
+      * quads are made.  Kept from turn to turn so that only the icons and
+      * vertex buffers of systems that actually changed are recreated. */
+    struct SystemQuadData {
+        SystemQuadData();
+        bool operator==(const SystemQuadData& rhs) const;
+
+        StarType                        star_type;
+        double                          x;
+        double                          y;
+        double                          icon_size;
+        boost::shared_ptr<GG::Texture>  disc_texture;
+        boost::shared_ptr<GG::Texture>  halo_texture;
+        boost::shared_ptr<GG::Texture>  gas_texture;
+    };
+
     std::map<boost::shared_ptr<GG::Texture>, GG::GL2DVertexBuffer>  m_star_core_quad_vertices;
     std::map<boost::shared_ptr<GG::Texture>, GG::GL2DVertexBuffer>  m_star_halo_quad_vertices;
     std::map<boost::shared_ptr<GG::Texture>, GG::GL2DVertexBuffer>  m_galaxy_gas_quad_vertices;
     GG::GLTexCoordBuffer                    m_star_texture_coords;
+    std::map<int, SystemQuadData>           m_system_quad_data;     //!< inputs of the quads currently in the star and galaxy gas buffers, indexed by system id
 
     GG::GL2DVertexBuffer                    m_starlane_vertices;
     GG::GLRGBAColorBuffer                   m_starlane_colors;
@@ -1208,14 +1208,16 @@ public:
         m_icon(0),
         m_controls(0),
         m_column_val_cache(),
-        m_selected(false)
+        m_selected(false),
+        m_rc_connection()
     {
         SetChildClippingMode(ClipToClient);
-        TemporaryPtr<const ResourceCenter> rcobj = boost::dynamic_pointer_cast<const ResourceCenter>(obj);
-        if (rcobj)
-            GG::Connect(rcobj->ResourceCenterChangedSignal, &ObjectPanel::RCChanged, this);
+        ConnectRCChanged(obj);
     }
 
+    virtual ~ObjectPanel()
+    { m_rc_connection.disconnect(); }
+
     void RCChanged() {
         RefreshCache();
         Refresh();
@@ -1231,6 +1233,20 @@ public:
 
     int                 ObjectID() const { return m_object_id; }
 
+    /** Rebinds this panel to show \a obj, so that panels can be reused for
+      * different objects as the list they are in scrolls. */
+    void                SetObject(TemporaryPtr<const UniverseObject> obj, bool expanded,
+                                  bool has_contents, int indent)
+    {
+        m_object_id = obj ? obj->ID() : INVALID_OBJECT_ID;
+        m_expanded = expanded;
+        m_has_contents = has_contents;
+        m_indent = indent;
+        m_column_val_cache.clear();
+        ConnectRCChanged(obj);
+        Refresh();
+    }
+
     virtual void        Render() {
         if (!m_initialized)
             Init();
@@ -1287,24 +1303,33 @@ public:
             AttachChild(m_dot);
         }
 
-        TemporaryPtr<const UniverseObject> obj = GetUniverseObject(m_object_id);
-        std::vector<boost::shared_ptr<GG::Texture> > textures = ObjectTextures(obj);
-
-        m_icon = new MultiTextureStaticGraphic(textures,
-                                               std::vector<GG::Flags<GG::GraphicStyle> >(textures.size(), style));
-        AttachChild(m_icon);
+        if (TemporaryPtr<const UniverseObject> obj = GetUniverseObject(m_object_id)) {
+            std::vector<boost::shared_ptr<GG::Texture> > textures = ObjectTextures(obj);
 
-        for (std::vector<GG::Control*>::iterator it = m_controls.begin();
-             it != m_controls.end(); ++it)
-        { DeleteChild(*it); }
-        m_controls.clear();
+            m_icon = new MultiTextureStaticGraphic(textures,
+                                                   std::vector<GG::Flags<GG::GraphicStyle> >(textures.size(), style));
+            AttachChild(m_icon);
+        }
 
-        std::vector<GG::Control*> controls = GetControls();
-        for (std::vector<GG::Control*>::iterator it = controls.begin();
-             it != controls.end(); ++it)
-        {
-            m_controls.push_back(*it);
-            AttachChild(*it);
+        if (m_controls.size() == NUM_COLUMNS) {
+            // reuse existing labels; only their text depends on the object
+            RefreshCache();
+            for (unsigned int i = 0; i < NUM_COLUMNS; ++i)
+                if (GG::Label* label = dynamic_cast<GG::Label*>(m_controls[i]))
+                    label->SetText(m_column_val_cache[i]);
+        } else {
+            for (std::vector<GG::Control*>::iterator it = m_controls.begin();
+                 it != m_controls.end(); ++it)
+            { DeleteChild(*it); }
+            m_controls.clear();
+
+            std::vector<GG::Control*> controls = GetControls();
+            for (std::vector<GG::Control*>::iterator it = controls.begin();
+                 it != controls.end(); ++it)
+            {
+                m_controls.push_back(*it);
+                AttachChild(*it);
+            }
         }
 
         DoLayout();
@@ -1362,6 +1387,13 @@ private:
         ExpandCollapseSignal();
     }
 
+    void                ConnectRCChanged(TemporaryPtr<const UniverseObject> obj) {
+        m_rc_connection.disconnect();
+        TemporaryPtr<const ResourceCenter> rcobj = boost::dynamic_pointer_cast<const ResourceCenter>(obj);
+        if (rcobj)
+            m_rc_connection = GG::Connect(rcobj->ResourceCenterChangedSignal, &ObjectPanel::RCChanged, this);
+    }
+
     void                Init() {
         if (m_initialized)
             return;
@@ -1414,6 +1446,7 @@ private:
     mutable std::vector<std::string>m_column_val_cache;
 
     bool                            m_selected;
+    boost::signals2::connection     m_rc_connection;
 };
 
 ////////////////////////////////////////////////
@@ -1421,42 +1454,50 @@ private:
 ////////////////////////////////////////////////
 class ObjectRow : public GG::ListBox::Row {
 public:
-    ObjectRow(GG::X w, GG::Y h, TemporaryPtr<const UniverseObject> obj, bool expanded,
-              int container_object_panel, const std::set<int>& contained_object_panels,
-              int indent) :
+    ObjectRow(GG::X w, GG::Y h) :
         GG::ListBox::Row(w, h, "", GG::ALIGN_CENTER, 1),
         m_panel(0),
-        m_container_object_panel(container_object_panel),
-        m_contained_object_panels(contained_object_panels)
+        m_model_row(GG::VirtualListBox::NO_ROW),
+        m_container_object_panel(INVALID_OBJECT_ID),
+        m_contained_object_panels()
     {
         SetName("ObjectRow");
         SetChildClippingMode(ClipToClient);
-        m_panel = new ObjectPanel(w, h, obj, expanded, !m_contained_object_panels.empty(), indent);
+        m_panel = new ObjectPanel(w, h, TemporaryPtr<const UniverseObject>(), true, false, 0);
         push_back(m_panel);
         GG::Connect(m_panel->ExpandCollapseSignal,  &ObjectRow::ExpandCollapseClicked, this);
     }
 
-    virtual GG::ListBox::Row::SortKeyType SortKey(std::size_t column) const
-    { return m_panel ? m_panel->SortKey(column) : ""; }
-
     int                     ObjectID() const {
         if (m_panel)
             return m_panel->ObjectID();
         return INVALID_OBJECT_ID;
     }
 
+    /** Returns the row of the ObjectListBox's model this row is showing. */
+    std::size_t             ModelRow() const
+    { return m_model_row; }
+
     int                     ContainedByPanel() const
     { return m_container_object_panel; }
 
     const std::set<int>&    ContainedPanels() const
     { return m_contained_object_panels; }
 
-    void                    SetContainedPanels(const std::set<int>& contained_object_panels) {
+    /** Rebinds this row to show \a obj, as row \a model_row of the list. */
+    void                    SetObject(std::size_t model_row, TemporaryPtr<const UniverseObject> obj,
+                                      bool expanded, int container_object_panel,
+                                      const std::set<int>& contained_object_panels, int indent)
+    {
+        m_model_row = model_row;
+        m_container_object_panel = container_object_panel;
         m_contained_object_panels = contained_object_panels;
-        m_panel->SetHasContents(!m_contained_object_panels.empty());
-        m_panel->Refresh();
+        m_panel->SetObject(obj, expanded, !m_contained_object_panels.empty(), indent);
     }
 
+    void                    Select(bool b)
+    { m_panel->Select(b); }
+
     void                    Update()
     { m_panel->Refresh(); }
 
@@ -1474,6 +1515,7 @@ public:
     mutable boost::signals2::signal<void (int)>   ExpandCollapseSignal;
 private:
     ObjectPanel*        m_panel;
+    std::size_t         m_model_row;
     int                 m_container_object_panel;
     std::set<int>       m_contained_object_panels;
 };
@@ -1660,43 +1702,62 @@ private:
 };
 
 namespace {
-    struct CustomRowCmp {
-        bool operator()(const GG::ListBox::Row& lhs, const GG::ListBox::Row& rhs, std::size_t column) {
-            const std::string& lhs_key = lhs.SortKey(column);
-            const std::string& rhs_key = rhs.SortKey(column);
-            try {
-                // attempt to cast sort keys to floats, so that number-aware
-                // sorting can be done for columns that contain numbers
-                float lhs_val = lhs_key.empty() ? 0.0f : boost::lexical_cast<float>(lhs_key);
-                float rhs_val = rhs_key.empty() ? 0.0f : boost::lexical_cast<float>(rhs_key);
-                return lhs_val < rhs_val;
-            } catch (...) {
-                return static_cast<const ObjectRow&>(lhs).SortKey(column) < static_cast<const ObjectRow&>(rhs).SortKey(column);
-            }
+    /** Compares column values as numbers if both can be read as numbers, so
+      * that columns containing numbers sort sensibly, and as text otherwise. */
+    bool ColumnValueLess(const std::string& lhs_key, const std::string& rhs_key) {
+        try {
+            float lhs_val = lhs_key.empty() ? 0.0f : boost::lexical_cast<float>(lhs_key);
+            float rhs_val = rhs_key.empty() ? 0.0f : boost::lexical_cast<float>(rhs_key);
+            return lhs_val < rhs_val;
+        } catch (...) {
+            return lhs_key < rhs_key;
         }
-    };
+    }
 }
 
+class ObjectListBox;
+
+////////////////////////////////////////////////
+// ObjectListModel
+////////////////////////////////////////////////
+/** Supplies the rows of an ObjectListBox to the underlying VirtualListBox. */
+class ObjectListModel : public GG::VirtualListBox::Model {
+public:
+    explicit ObjectListModel(ObjectListBox& list_box) :
+        m_list_box(list_box)
+    {}
+
+    virtual std::size_t                         NumRows() const;
+    virtual GG::ListBox::Row::SortKeyType       SortKey(std::size_t row, std::size_t column) const;
+    virtual bool                                SortLess(std::size_t lhs, std::size_t rhs, std::size_t column) const;
+    virtual GG::ListBox::Row*                   CreateRow(GG::X w, GG::Y h);
+    virtual void                                UpdateRow(GG::ListBox::Row& row_wnd, std::size_t row);
+
+private:
+    ObjectListBox& m_list_box;
+};
+
 ////////////////////////////////////////////////
 // ObjectListBox
 ////////////////////////////////////////////////
-class ObjectListBox : public CUIListBox {
+/** Lists objects in a tree of containment, keeping only a flat list of
+  * entries for all objects shown, and creating ObjectRows only for the
+  * entries that are currently scrolled into view. */
+class ObjectListBox : public CUIVirtualListBox {
 public:
     ObjectListBox() :
-        CUIListBox(),
+        CUIVirtualListBox(),
+        m_model(*this),
+        m_entries(),
+        m_entry_rows(),
+        m_object_rows(),
         m_object_change_connections(),
         m_collapsed_objects(),
         m_filter_condition(0),
         m_visibilities(),
         m_header_row(0)
     {
-        // preinitialize listbox/row column widths, because what
-        // ListBox::Insert does on default is not suitable for this case
-        SetNumCols(1);
-        SetColWidth(0, GG::X0);
-        LockColWidths();
-        SetSortCmp(CustomRowCmp());
-
+        SetRowHeight(ListRowHeight());
         SetVScrollWheelIncrement(Value(ListRowHeight())*4);
 
         m_filter_condition = new Condition::All();
@@ -1717,22 +1778,21 @@ public:
         GG::Connect(m_header_row->ColumnsChangedSignal,         &ObjectListBox::Refresh,                this);
         GG::Connect(m_header_row->ColumnHeaderLeftClickSignal,  &ObjectListBox::SortingClicked,         this);
         m_obj_deleted_connection = GG::Connect(GetUniverse().UniverseObjectDeleteSignal,   &ObjectListBox::UniverseObjectDeleted,  this);
+
+        SetModel(&m_model);
     }
 
     virtual ~ObjectListBox() {
+        SetModel(0);
+        DisconnectObjectChanges();
         delete m_filter_condition;
     }
 
     virtual void    SizeMove(const GG::Pt& ul, const GG::Pt& lr) {
         const GG::Pt old_size = Size();
-        Wnd::SizeMove(ul, lr);
-        if (old_size != Size()) {
-            const GG::Pt row_size = ListRowSize();
-            for (GG::ListBox::iterator it = begin(); it != end(); ++it)
-                (*it)->Resize(row_size);
-            m_header_row->Resize(row_size);
-            ListBox::AdjustScrolls(true);
-        }
+        CUIVirtualListBox::SizeMove(ul, lr);
+        if (old_size != Size())
+            m_header_row->Resize(ListRowSize());
     }
 
     GG::Pt          ListRowSize() const
@@ -1747,11 +1807,69 @@ public:
     const std::map<UniverseObjectType, std::set<VIS_DISPLAY> >  Visibilities() const
     { return m_visibilities; }
 
+    /** Returns the number of object entries in the list. */
+    std::size_t     NumEntries() const
+    { return m_entries.size(); }
+
+    /** Returns the ID of the object in model row \a row, or
+      * INVALID_OBJECT_ID if there is no such row. */
+    int             ObjectInRow(std::size_t row) const
+    { return row < m_entries.size() ? m_entries[row].object_id : INVALID_OBJECT_ID; }
+
+    /** Returns the model row of the object with id \a object_id, or
+      * GG::VirtualListBox::NO_ROW if that object is not listed. */
+    std::size_t     RowOfObject(int object_id) const {
+        std::map<int, std::size_t>::const_iterator it = m_entry_rows.find(object_id);
+        return it == m_entry_rows.end() ? GG::VirtualListBox::NO_ROW : it->second;
+    }
+
+    std::string     EntrySortKey(std::size_t row, std::size_t column) const {
+        if (row >= m_entries.size())
+            return "";
+        const ObjectEntry& entry = m_entries[row];
+        if (entry.column_vals.empty()) {
+            // evaluate only when sorting needs it, and then only once per refresh
+            entry.column_vals.reserve(NUM_COLUMNS);
+            TemporaryPtr<const UniverseObject> obj = GetUniverseObject(entry.object_id);
+            ScriptingContext context(obj);
+            for (unsigned int i = 0; i < NUM_COLUMNS; ++i) {
+                const ValueRef::ValueRefBase<std::string>* ref = GetColumnValueRef(static_cast<int>(i));
+                entry.column_vals.push_back(ref ? ref->Eval(context) : "");
+            }
+        }
+        if (column >= entry.column_vals.size())
+            return "";
+        return entry.column_vals[column];
+    }
+
+    ObjectRow*      CreateObjectRow(GG::X w, GG::Y h) {
+        ObjectRow* object_row = new ObjectRow(w, h);
+        GG::Connect(object_row->ExpandCollapseSignal,   &ObjectListBox::ObjectExpandCollapseClicked,
+                    this, boost::signals2::at_front);
+        m_object_rows.push_back(object_row);
+        return object_row;
+    }
+
+    void            UpdateObjectRow(ObjectRow& object_row, std::size_t row) {
+        if (row >= m_entries.size())
+            return;
+        const ObjectEntry& entry = m_entries[row];
+        object_row.SetObject(row, GetUniverseObject(entry.object_id), !ObjectCollapsed(entry.object_id),
+                             entry.container, entry.contents, entry.indent);
+        object_row.Select(Selected(row));
+    }
+
+    /** Marks the shown ObjectRows as selected or not, according to the
+      * current selections. */
+    void            UpdateSelectionHilites() {
+        for (std::vector<ObjectRow*>::iterator it = m_object_rows.begin(); it != m_object_rows.end(); ++it)
+            (*it)->Select(Selected((*it)->ModelRow()));
+    }
+
     void            CollapseObject(int object_id = INVALID_OBJECT_ID) {
         if (object_id == INVALID_OBJECT_ID) {
-            for (GG::ListBox::iterator row_it = this->begin(); row_it != this->end(); ++row_it)
-                if (const ObjectRow* object_row = dynamic_cast<const ObjectRow*>(*row_it))
-                    m_collapsed_objects.insert(object_row->ObjectID());
+            for (std::vector<ObjectEntry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+                m_collapsed_objects.insert(it->object_id);
         } else {
             m_collapsed_objects.insert(object_id);
         }
@@ -1790,11 +1908,9 @@ public:
     }
 
     void            ClearContents() {
-        Clear();
-        for (std::map<int, boost::signals2::connection>::iterator it = m_object_change_connections.begin();
-             it != m_object_change_connections.end(); ++it)
-        { it->second.disconnect(); }
-        m_object_change_connections.clear();
+        m_entries.clear();
+        m_entry_rows.clear();
+        DisconnectObjectChanges();
     }
 
     bool            ObjectShown(TemporaryPtr<const UniverseObject> obj, bool assume_visible_without_checking = false) {
@@ -1818,7 +1934,7 @@ public:
     }
 
     void            Refresh() {
-        std::size_t first_visible_queue_row = std::distance(this->begin(), this->FirstRowShown());
+        std::size_t first_row_shown = FirstRowShown();
         ClearContents();
 
         m_header_row->Update();
@@ -2031,21 +2147,18 @@ public:
             AddObjectRow(*fld_it, INVALID_OBJECT_ID, std::set<int>(), indent);
 
 
-        if (!this->Empty())
-            this->BringRowIntoView(--this->end());
-        if (first_visible_queue_row < this->NumRows())
-            this->BringRowIntoView(boost::next(this->begin(), first_visible_queue_row));
+        ModelChanged();
+        SetFirstRowShown(first_row_shown);
     }
 
     void            UpdateObjectPanel(int object_id = INVALID_OBJECT_ID) {
         if (object_id == INVALID_OBJECT_ID)
             return;
-        for (GG::ListBox::iterator it = this->begin(); it != this->end(); ++it) {
-            if (ObjectRow* row = dynamic_cast<ObjectRow*>(*it)) {
-                row->Update();
-                return;
-            }
-        }
+        std::size_t row = RowOfObject(object_id);
+        if (row == GG::VirtualListBox::NO_ROW)
+            return;
+        m_entries[row].column_vals.clear();
+        RowChanged(row);
     }
 
     void            SortingClicked(int clicked_column) {
@@ -2078,22 +2191,28 @@ public:
     mutable boost::signals2::signal<void ()> ExpandCollapseSignal;
 
 private:
-    void            AddObjectRow(int object_id, int container, const std::set<int>& contents, int indent)
-    { AddObjectRow(object_id, container, contents, indent, this->end()); }
+    /** An object shown in the list, with its place in the containment tree. */
+    struct ObjectEntry {
+        ObjectEntry(int object_id_, int container_, const std::set<int>& contents_, int indent_) :
+            object_id(object_id_),
+            container(container_),
+            contents(contents_),
+            indent(indent_),
+            column_vals()
+        {}
+        int                                 object_id;
+        int                                 container;
+        std::set<int>                       contents;
+        int                                 indent;
+        mutable std::vector<std::string>    column_vals;    ///< cached column values, for sorting
+    };
 
-    void            AddObjectRow(int object_id, int container, const std::set<int>& contents,
-                                 int indent, GG::ListBox::iterator it)
-    {
+    void            AddObjectRow(int object_id, int container, const std::set<int>& contents, int indent) {
         TemporaryPtr<const UniverseObject> obj = GetUniverseObject(object_id);
         if (!obj)
             return;
-        const GG::Pt row_size = ListRowSize();
-        ObjectRow* object_row = new ObjectRow(row_size.x, row_size.y, obj, !ObjectCollapsed(object_id),
-                                              container, contents, indent);
-        this->Insert(object_row, it);
-        object_row->Resize(row_size);
-        GG::Connect(object_row->ExpandCollapseSignal,   &ObjectListBox::ObjectExpandCollapseClicked,
-                    this, boost::signals2::at_front);
+        m_entry_rows[object_id] = m_entries.size();
+        m_entries.push_back(ObjectEntry(object_id, container, contents, indent));
         m_object_change_connections[obj->ID()].disconnect();
         m_object_change_connections[obj->ID()] = GG::Connect(obj->StateChangedSignal,
             boost::bind(&ObjectListBox::ObjectStateChanged, this, obj->ID()), boost::signals2::at_front);
@@ -2102,68 +2221,54 @@ private:
     // Removes row of indicated object, and all contained rows, recursively.
     // Also updates contents tracking of containing row, if any.
     void            RemoveObjectRow(int object_id) {
-        if (object_id == INVALID_OBJECT_ID)
+        std::size_t row = RowOfObject(object_id);
+        if (row == GG::VirtualListBox::NO_ROW)
             return;
-        int container_object_id = INVALID_OBJECT_ID;
-        for (GG::ListBox::iterator it = this->begin(); it != this->end(); ++it) {
-            if (ObjectRow* object_row = dynamic_cast<ObjectRow*>(*it)) {
-                if (object_row->ObjectID() == object_id) {
-                    container_object_id = object_row->ContainedByPanel();
-                    RemoveObjectRow(it);
-                    break;
-                }
-            }
-        }
 
-        if (container_object_id == INVALID_OBJECT_ID)
-            return;
+        // contained rows directly follow their container, further indented
+        std::size_t end_row = row + 1;
+        while (end_row < m_entries.size() && m_entries[end_row].indent > m_entries[row].indent)
+            ++end_row;
+
+        std::set<int> selected_object_ids;
+        for (SelectionSet::const_iterator it = Selections().begin(); it != Selections().end(); ++it)
+            selected_object_ids.insert(ObjectInRow(*it));
+
+        // erase these rows and remove any signals related to them
+        for (std::size_t i = row; i < end_row; ++i) {
+            m_object_change_connections[m_entries[i].object_id].disconnect();
+            m_object_change_connections.erase(m_entries[i].object_id);
+        }
+        int container_object_id = m_entries[row].container;
+        m_entries.erase(m_entries.begin() + row, m_entries.begin() + end_row);
 
         // remove this row from parent row's contents
-        for (GG::ListBox::iterator it = this->begin(); it != this->end(); ++it) {
-            if (ObjectRow* object_row = dynamic_cast<ObjectRow*>(*it)) {
-                if (object_row->ObjectID() == container_object_id) {
-                    const std::set<int>& contents = object_row->ContainedPanels();
-                    std::set<int> new_contents;
-                    for (std::set<int>::const_iterator contents_it = contents.begin();
-                         contents_it != contents.end(); ++contents_it)
-                    {
-                        if (*contents_it != object_id)
-                            new_contents.insert(*contents_it);
-                    }
-                    object_row->SetContainedPanels(new_contents);
-                    object_row->Update();
-                    break;
-                }
-            }
+        m_entry_rows.clear();
+        for (std::size_t i = 0; i < m_entries.size(); ++i) {
+            m_entry_rows[m_entries[i].object_id] = i;
+            if (m_entries[i].object_id == container_object_id)
+                m_entries[i].contents.erase(object_id);
         }
-    }
 
-    // Removes row at indicated iterator location and its contained rows.
-    // Does not adjust containing row.
-    void            RemoveObjectRow(GG::ListBox::iterator it) {
-        if (it == this->end())
-            return;
-        ObjectRow* object_row = dynamic_cast<ObjectRow*>(*it);
+        std::size_t first_row_shown = FirstRowShown();
+        ModelChanged();
+        SetFirstRowShown(first_row_shown);
 
-        // recursively remove contained rows first
-        const std::set<int>& contents = object_row->ContainedPanels();
-        for (unsigned int i = 0; i < contents.size(); ++i) {
-            GG::ListBox::iterator next_it = it; ++next_it;
-            if (next_it == this->end())
-                break;
-            ObjectRow* contained_row = dynamic_cast<ObjectRow*>(*next_it);
-            if (!contained_row)
-                continue;
-            // remove only rows that are contained by this row
-            if (contained_row->ContainedByPanel() != object_row->ObjectID())
-                break;
-            RemoveObjectRow(next_it);
+        SelectionSet selections;
+        for (std::set<int>::const_iterator it = selected_object_ids.begin(); it != selected_object_ids.end(); ++it) {
+            std::size_t selected_row = RowOfObject(*it);
+            if (selected_row != GG::VirtualListBox::NO_ROW)
+                selections.insert(selected_row);
         }
+        SetSelections(selections);
+        UpdateSelectionHilites();
+    }
 
-        // erase this row and remove any signals related to it
-        m_object_change_connections[object_row->ObjectID()].disconnect();
-        m_object_change_connections.erase(object_row->ObjectID());
-        this->Erase(it);
+    void            DisconnectObjectChanges() {
+        for (std::map<int, boost::signals2::connection>::iterator it = m_object_change_connections.begin();
+             it != m_object_change_connections.end(); ++it)
+        { it->second.disconnect(); }
+        m_object_change_connections.clear();
     }
 
     void            ObjectExpandCollapseClicked(int object_id) {
@@ -2194,6 +2299,10 @@ private:
     void            UniverseObjectDeleted(TemporaryPtr<const UniverseObject> obj)
     { if (obj) RemoveObjectRow(obj->ID()); }
 
+    ObjectListModel                                     m_model;
+    std::vector<ObjectEntry>                            m_entries;          ///< objects shown, in tree order
+    std::map<int, std::size_t>                          m_entry_rows;       ///< index in m_entries of each shown object
+    std::vector<ObjectRow*>                             m_object_rows;      ///< the (recycled) row widgets, owned by the list
     std::map<int, boost::signals2::connection>          m_object_change_connections;
     std::set<int>                                       m_collapsed_objects;
     Condition::ConditionBase*                           m_filter_condition;
@@ -2202,6 +2311,26 @@ private:
     boost::signals2::connection m_obj_deleted_connection;
 };
 
+////////////////////////////////////////////////
+// ObjectListModel
+////////////////////////////////////////////////
+std::size_t ObjectListModel::NumRows() const
+{ return m_list_box.NumEntries(); }
+
+GG::ListBox::Row::SortKeyType ObjectListModel::SortKey(std::size_t row, std::size_t column) const
+{ return m_list_box.EntrySortKey(row, column); }
+
+bool ObjectListModel::SortLess(std::size_t lhs, std::size_t rhs, std::size_t column) const
+{ return ColumnValueLess(m_list_box.EntrySortKey(lhs, column), m_list_box.EntrySortKey(rhs, column)); }
+
+GG::ListBox::Row* ObjectListModel::CreateRow(GG::X w, GG::Y h)
+{ return m_list_box.CreateObjectRow(w, h); }
+
+void ObjectListModel::UpdateRow(GG::ListBox::Row& row_wnd, std::size_t row) {
+    if (ObjectRow* object_row = dynamic_cast<ObjectRow*>(&row_wnd))
+        m_list_box.UpdateObjectRow(*object_row, row);
+}
+
 ////////////////////////////////////////////////
 // ObjectListWnd
 ////////////////////////////////////////////////
@@ -2267,39 +2396,16 @@ void ObjectListWnd::SizeMove(const GG::Pt& ul, const GG::Pt& lr) {
 void ObjectListWnd::Refresh()
 { m_list_box->Refresh(); }
 
-void ObjectListWnd::ObjectSelectionChanged(const GG::ListBox::SelectionSet& rows) {
-    // mark as selected all ObjectPanel that are in \a rows and mark as not
-    // selected all ObjectPanel that aren't in \a rows
-    for (GG::ListBox::iterator it = m_list_box->begin(); it != m_list_box->end(); ++it) {
-        bool select_this_row = (rows.find(it) != rows.end());
-
-        GG::ListBox::Row* row = *it;
-        if (!row) {
-            ErrorLogger() << "ObjectListWnd::ObjectSelectionChanged couldn't get row";
-            continue;
-        }
-        if (row->empty()) {
-            ErrorLogger() << "ObjectListWnd::ObjectSelectionChanged got empty row";
-            continue;
-        }
-        GG::Control* control = (*row)[0];
-        if (!control) {
-            ErrorLogger() << "ObjectListWnd::ObjectSelectionChanged couldn't get control from row";
-            continue;
-        }
-        ObjectPanel* data_panel = dynamic_cast<ObjectPanel*>(control);
-        if (!data_panel) {
-            ErrorLogger() << "ObjectListWnd::ObjectSelectionChanged couldn't get ObjectPanel from control";
-            continue;
-        }
-        data_panel->Select(select_this_row);
-    }
+void ObjectListWnd::ObjectSelectionChanged(const GG::VirtualListBox::SelectionSet& rows) {
+    // mark as selected all shown ObjectPanels that are in \a rows and mark
+    // as not selected all shown ObjectPanels that aren't in \a rows
+    m_list_box->UpdateSelectionHilites();
 
     SelectedObjectsChangedSignal();
 }
 
-void ObjectListWnd::ObjectDoubleClicked(GG::ListBox::iterator it) {
-    int object_id = ObjectInRow(it);
+void ObjectListWnd::ObjectDoubleClicked(std::size_t row) {
+    int object_id = ObjectInRow(row);
     if (object_id != INVALID_OBJECT_ID)
         ObjectDoubleClickedSignal(object_id);
     ClientUI::GetClientUI()->ZoomToObject(object_id);
@@ -2307,34 +2413,25 @@ void ObjectListWnd::ObjectDoubleClicked(GG::ListBox::iterator it) {
 
 std::set<int> ObjectListWnd::SelectedObjectIDs() const {
     std::set<int> sel_ids;
-    const GG::ListBox::SelectionSet sel = m_list_box->Selections();
-    for (GG::ListBox::SelectionSet::const_iterator it = sel.begin(); it != sel.end(); ++it) {
-        ObjectRow *row = dynamic_cast<ObjectRow *>(**it);
-        if (row) {
-            int selected_object_id = row->ObjectID();
-            if (selected_object_id != INVALID_OBJECT_ID)
-                sel_ids.insert(selected_object_id);
-        }
+    const GG::VirtualListBox::SelectionSet& sel = m_list_box->Selections();
+    for (GG::VirtualListBox::SelectionSet::const_iterator it = sel.begin(); it != sel.end(); ++it) {
+        int selected_object_id = ObjectInRow(*it);
+        if (selected_object_id != INVALID_OBJECT_ID)
+            sel_ids.insert(selected_object_id);
     }
     return sel_ids;
 }
 
 void ObjectListWnd::SetSelectedObjects(std::set<int> sel_ids) {
-    for (GG::ListBox::iterator it = m_list_box->begin(); it != m_list_box->end(); ++it) {
-        ObjectRow *row = dynamic_cast<ObjectRow *>(*it);
-        if (row) {
-            int selected_object_id = row->ObjectID();
-            if (selected_object_id != INVALID_OBJECT_ID) {
-                if (sel_ids.find(selected_object_id) != sel_ids.end()) {
-                    m_list_box->SelectRow(it);
-                }
-            }
-        }
+    for (std::set<int>::const_iterator it = sel_ids.begin(); it != sel_ids.end(); ++it) {
+        std::size_t row = m_list_box->RowOfObject(*it);
+        if (row != GG::VirtualListBox::NO_ROW)
+            m_list_box->SelectRow(row);
     }
 }
 
-void ObjectListWnd::ObjectRightClicked(GG::ListBox::iterator it, const GG::Pt& pt) {
-    int object_id = ObjectInRow(it);
+void ObjectListWnd::ObjectRightClicked(std::size_t row, const GG::Pt& pt) {
+    int object_id = ObjectInRow(row);
     if (object_id == INVALID_OBJECT_ID)
         return;
     HumanClientApp* app = HumanClientApp::GetApp();
@@ -2344,7 +2441,7 @@ void ObjectListWnd::ObjectRightClicked(GG::ListBox::iterator it, const GG::Pt& p
         moderator = true;
 
     // Right click on an unselected row should automatically select it
-    m_list_box->SelectRow(it);
+    m_list_box->SelectRow(row);
 
     // create popup menu with object commands in it
     GG::MenuItem menu_contents;
@@ -2362,16 +2459,13 @@ void ObjectListWnd::ObjectRightClicked(GG::ListBox::iterator it, const GG::Pt& p
     if (type == OBJ_PLANET) {
         menu_contents.next_level.push_back(GG::MenuItem(UserString("SP_PLANET_SUITABILITY"), 2, false, false));
 
-        const GG::ListBox::SelectionSet sel = m_list_box->Selections();
-        for (GG::ListBox::SelectionSet::const_iterator it = sel.begin(); it != sel.end(); ++it) {
-            ObjectRow *row = dynamic_cast<ObjectRow *>(**it);
-            if (row) {
-                TemporaryPtr<Planet> one_planet = GetPlanet(row->ObjectID());
-                if (one_planet && one_planet->OwnedBy(app->EmpireID())) {
-                    std::vector<std::string> planet_foci = one_planet->AvailableFoci();
-                    for (std::vector<std::string>::iterator it = planet_foci.begin(); it != planet_foci.end(); ++it)
-                        all_foci[*it]++;
-                }
+        const GG::VirtualListBox::SelectionSet& sel = m_list_box->Selections();
+        for (GG::VirtualListBox::SelectionSet::const_iterator it = sel.begin(); it != sel.end(); ++it) {
+            TemporaryPtr<Planet> one_planet = GetPlanet(ObjectInRow(*it));
+            if (one_planet && one_planet->OwnedBy(app->EmpireID())) {
+                std::vector<std::string> planet_foci = one_planet->AvailableFoci();
+                for (std::vector<std::string>::iterator it = planet_foci.begin(); it != planet_foci.end(); ++it)
+                    all_foci[*it]++;
             }
         }
         GG::MenuItem focusMenuItem(UserString("MENUITEM_SET_FOCUS"), 3, false, false);
@@ -2421,15 +2515,12 @@ void ObjectListWnd::ObjectRightClicked(GG::ListBox::iterator it, const GG::Pt& p
                 std::map<std::string, int>::iterator it = all_foci.begin();
                 std::advance(it, id - MENUITEM_SET_FOCUS_BASE - 1);
                 std::string focus = it->first;
-                const GG::ListBox::SelectionSet sel = m_list_box->Selections();
-                for (GG::ListBox::SelectionSet::const_iterator it = sel.begin(); it != sel.end(); ++it) {
-                    ObjectRow *row = dynamic_cast<ObjectRow *>(**it);
-                    if (row) {
-                        TemporaryPtr<Planet> one_planet = GetPlanet(row->ObjectID());
-                        if (one_planet && one_planet->OwnedBy(app->EmpireID())) {
-                            one_planet->SetFocus(focus);
-                            app->Orders().IssueOrder(OrderPtr(new ChangeFocusOrder(app->EmpireID(), one_planet->ID(), focus)));
-                         }
+                const GG::VirtualListBox::SelectionSet& sel = m_list_box->Selections();
+                for (GG::VirtualListBox::SelectionSet::const_iterator it = sel.begin(); it != sel.end(); ++it) {
+                    TemporaryPtr<Planet> one_planet = GetPlanet(ObjectInRow(*it));
+                    if (one_planet && one_planet->OwnedBy(app->EmpireID())) {
+                        one_planet->SetFocus(focus);
+                        app->Orders().IssueOrder(OrderPtr(new ChangeFocusOrder(app->EmpireID(), one_planet->ID(), focus)));
                     }
                 }
             }
@@ -2443,15 +2534,8 @@ void ObjectListWnd::ObjectRightClicked(GG::ListBox::iterator it, const GG::Pt& p
     }
 }
 
-int ObjectListWnd::ObjectInRow(GG::ListBox::iterator it) const {
-    if (it == m_list_box->end())
-        return INVALID_OBJECT_ID;
-
-    if (ObjectRow* obj_row = dynamic_cast<ObjectRow*>(*it))
-        return obj_row->ObjectID();
-
-    return INVALID_OBJECT_ID;
-}
+int ObjectListWnd::ObjectInRow(std::size_t row) const
+{ return m_list_box->ObjectInRow(row); }
 
 void ObjectListWnd::FilterClicked() {
     FilterDialog dlg(GG::X(100), GG::Y(100),
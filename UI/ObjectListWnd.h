@@ -5,7 +5,7 @@
 #include "CUIWnd.h"
 
 #include <GG/GGFwd.h>
-#include <GG/ListBox.h>
+#include <GG/VirtualListBox.h>
 
 class ObjectListBox;
 
@@ -29,10 +29,10 @@ public:
 private:
     void            DoLayout();
 
-    void            ObjectSelectionChanged(const GG::ListBox::SelectionSet& rows);
-    void            ObjectDoubleClicked(GG::ListBox::iterator it);
-    void            ObjectRightClicked(GG::ListBox::iterator it, const GG::Pt& pt);
-    int             ObjectInRow(GG::ListBox::iterator it) const;
+    void            ObjectSelectionChanged(const GG::VirtualListBox::SelectionSet& rows);
+    void            ObjectDoubleClicked(std::size_t row);
+    void            ObjectRightClicked(std::size_t row, const GG::Pt& pt);
+    int             ObjectInRow(std::size_t row) const;
 
     void            SetSelectedObjects(std::set<int> sel_ids);
     std::set<int>   SelectedObjectIDs() const;
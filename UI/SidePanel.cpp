@@ -2556,7 +2556,7 @@ int                                        SidePanel::s_system_id = INVALID_OBJE
 std::set<SidePanel*>                       SidePanel::s_side_panels;
 std::set<boost::signals2::connection>      SidePanel::s_system_connections;
 std::map<int, boost::signals2::connection> SidePanel::s_fleet_state_change_signals;
-boost::signals2::signal<void ()>           SidePanel::ResourceCenterChangedSignal;
+boost::signals2::signal<void (int)>        SidePanel::ResourceCenterChangedSignal;
 boost::signals2::signal<void (int)>        SidePanel::PlanetSelectedSignal;
 boost::signals2::signal<void (int)>        SidePanel::PlanetRightClickedSignal;
 boost::signals2::signal<void (int)>        SidePanel::BuildingRightClickedSignal;
@@ -2714,6 +2714,11 @@ void SidePanel::UpdateImpl() {
     m_planet_panel_container->RefreshAllPlanetPanels();
 }
 
+namespace {
+    void EmitResourceCenterChangedSignal(int planet_id)
+    { SidePanel::ResourceCenterChangedSignal(planet_id); }
+}
+
 void SidePanel::Refresh() {
     // disconnect any existing system and fleet signals
     for (std::set<boost::signals2::connection>::iterator it = s_system_connections.begin(); it != s_system_connections.end(); ++it)
@@ -2750,7 +2755,7 @@ void SidePanel::Refresh() {
     for (std::vector<TemporaryPtr<Planet> >::iterator it = planets.begin(); it != planets.end(); ++it) {
         TemporaryPtr<Planet> planet = *it;
         s_system_connections.insert(GG::Connect(planet->ResourceCenterChangedSignal,
-                                                SidePanel::ResourceCenterChangedSignal));
+                                                boost::bind(&EmitResourceCenterChangedSignal, planet->ID())));
     }
 
     std::vector<TemporaryPtr<Fleet> > fleets = Objects().FindObjects<Fleet>(system->FleetIDs());
@@ -83,9 +83,9 @@ public:
       * system, including the droplist or back/forward arrows */
     static boost::signals2::signal<void (int)>    SystemSelectedSignal;
 
-    /** emitted when a planet's resourcecenter has changed, including when
-      * focus is changed */
-    static boost::signals2::signal<void ()>       ResourceCenterChangedSignal;
+    /** emitted with the id of a planet when its resourcecenter has changed,
+      * including when focus is changed */
+    static boost::signals2::signal<void (int)>    ResourceCenterChangedSignal;
 
     /** emitted when a planet is right clicked */
     static boost::signals2::signal<void (int)>    PlanetRightClickedSignal;
@@ -658,6 +658,29 @@ void HumanClientApp::RequestSavePreviews(const std::string& directory, PreviewIn
     }
 }
 
+void HumanClientApp::RequestCombatLogs(const std::vector<int>& log_ids) {
+    CombatLogManager& log_manager = GetCombatLogManager();
+    std::vector<int> unloaded_log_ids;
+    for (std::vector<int>::const_iterator it = log_ids.begin(); it != log_ids.end(); ++it)
+        if (log_manager.LogAvailable(*it) && !log_manager.LogLoaded(*it))
+            unloaded_log_ids.push_back(*it);
+    if (unloaded_log_ids.empty() || !m_networking.Connected())
+        return;
+
+    DebugLogger() << "HumanClientApp::RequestCombatLogs Requesting " << unloaded_log_ids.size() << " combat logs";
+    Message response;
+    m_networking.SendSynchronousMessage(RequestCombatLogsMessage(PlayerID(), unloaded_log_ids), response);
+    if (response.Type() != Message::DISPATCH_COMBAT_LOGS) {
+        ErrorLogger() << "HumanClientApp::RequestCombatLogs: Wrong response type from server: " << EnumToString(response.Type());
+        return;
+    }
+
+    std::map<int, CombatLog> logs;
+    ExtractMessageData(response, logs);
+    for (std::map<int, CombatLog>::const_iterator it = logs.begin(); it != logs.end(); ++it)
+        log_manager.SetLog(it->first, it->second);
+}
+
 
 std::pair<int, int> HumanClientApp::GetWindowLeftTop() {
     int left(0), top(0);
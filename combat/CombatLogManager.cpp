@@ -1,10 +1,17 @@
 #include "CombatLogManager.h"
 #include "../universe/Meter.h"
 #include "../universe/UniverseObject.h"
+#include "../util/Logger.h"
 #include "../util/Serialize.h"
 #include "../util/Serialize.ipp"
 #include "CombatEvents.h"
 
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <sstream>
+
 
 namespace {
     static float MaxHealth(const UniverseObject& object) {
@@ -146,14 +153,167 @@ template
 void CombatLog::serialize<freeorion_xml_oarchive>(freeorion_xml_oarchive& ar, const unsigned int version);
 
 
+////////////////////////////////////////////////
+// CombatLogManager::Store
+////////////////////////////////////////////////
+/** An append-only file of serialized CombatLogs, with an in-memory index of
+  * where each log is and which empires may see it.  Reads and writes are
+  * serialized by a mutex, since turn updates for several empires are
+  * encoded concurrently. */
+class CombatLogManager::Store {
+public:
+    explicit Store(const boost::filesystem::path& path);
+    ~Store();
+
+    bool                IsOpen() const;
+    bool                Contains(int log_id) const;
+    bool                Visible(int log_id, int empire_id) const;
+    void                GetLogIDs(std::set<int>& log_ids, int empire_id) const;
+    bool                Read(int log_id, CombatLog& log) const;
+
+    bool                Write(int log_id, const CombatLog& log);
+    void                Remove(int log_id);
+    void                Clear();
+
+private:
+    struct Entry {
+        Entry() : offset(0), size(0) {}
+        std::streamoff  offset;
+        std::size_t     size;
+        std::set<int>   empire_ids;
+    };
+
+    boost::filesystem::path         m_path;
+    mutable boost::filesystem::fstream m_file;
+    std::map<int, Entry>            m_index;
+    std::streamoff                  m_end;
+    mutable boost::mutex            m_mutex;
+};
+
+CombatLogManager::Store::Store(const boost::filesystem::path& path) :
+    m_path(path),
+    m_file(path, std::ios_base::in | std::ios_base::out | std::ios_base::binary | std::ios_base::trunc),
+    m_index(),
+    m_end(0)
+{
+    if (!m_file)
+        ErrorLogger() << "CombatLogManager::Store couldn't create combat log store file " << path.string();
+}
+
+CombatLogManager::Store::~Store() {
+    m_file.close();
+    boost::system::error_code ec;
+    boost::filesystem::remove(m_path, ec);
+}
+
+bool CombatLogManager::Store::IsOpen() const
+{ return m_file.is_open(); }
+
+bool CombatLogManager::Store::Contains(int log_id) const {
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_index.find(log_id) != m_index.end();
+}
+
+bool CombatLogManager::Store::Visible(int log_id, int empire_id) const {
+    boost::mutex::scoped_lock lock(m_mutex);
+    std::map<int, Entry>::const_iterator it = m_index.find(log_id);
+    if (it == m_index.end())
+        return false;
+    return empire_id == ALL_EMPIRES || it->second.empire_ids.count(empire_id);
+}
+
+void CombatLogManager::Store::GetLogIDs(std::set<int>& log_ids, int empire_id) const {
+    boost::mutex::scoped_lock lock(m_mutex);
+    for (std::map<int, Entry>::const_iterator it = m_index.begin(); it != m_index.end(); ++it)
+        if (empire_id == ALL_EMPIRES || it->second.empire_ids.count(empire_id))
+            log_ids.insert(log_ids.end(), it->first);
+}
+
+bool CombatLogManager::Store::Read(int log_id, CombatLog& log) const {
+    std::string buffer;
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        std::map<int, Entry>::const_iterator it = m_index.find(log_id);
+        if (it == m_index.end())
+            return false;
+        buffer.resize(it->second.size);
+        m_file.clear();
+        m_file.seekg(it->second.offset);
+        if (!buffer.empty())
+            m_file.read(&buffer[0], buffer.size());
+        if (!m_file) {
+            ErrorLogger() << "CombatLogManager::Store::Read couldn't read combat log " << log_id;
+            return false;
+        }
+    }
+
+    try {
+        std::istringstream is(buffer);
+        freeorion_bin_iarchive ia(is);
+        ia >> BOOST_SERIALIZATION_NVP(log);
+    } catch (const std::exception& e) {
+        ErrorLogger() << "CombatLogManager::Store::Read couldn't deserialize combat log " << log_id << ": " << e.what();
+        return false;
+    }
+    return true;
+}
+
+bool CombatLogManager::Store::Write(int log_id, const CombatLog& log) {
+    std::ostringstream os;
+    {
+        freeorion_bin_oarchive oa(os);
+        oa << BOOST_SERIALIZATION_NVP(log);
+    }
+    const std::string& buffer = os.str();
+
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_file.clear();
+    m_file.seekp(m_end);
+    m_file.write(buffer.data(), buffer.size());
+    m_file.flush();
+    if (!m_file) {
+        ErrorLogger() << "CombatLogManager::Store::Write couldn't write combat log " << log_id;
+        return false;
+    }
+
+    // rewriting a log leaves its old contents unreferenced in the file
+    Entry& entry = m_index[log_id];
+    entry.offset = m_end;
+    entry.size = buffer.size();
+    entry.empire_ids = log.empire_ids;
+    m_end += buffer.size();
+    return true;
+}
+
+void CombatLogManager::Store::Remove(int log_id) {
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_index.erase(log_id);
+}
+
+void CombatLogManager::Store::Clear() {
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_index.clear();
+    m_end = 0;
+    m_file.close();
+    m_file.open(m_path, std::ios_base::in | std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+}
+
+
 ////////////////////////////////////////////////
 // CombatLogManager
 ////////////////////////////////////////////////
 CombatLogManager::CombatLogManager() :
     m_logs(),
+    m_stored_logs(),
+    m_stored_logs_mutex(),
+    m_unloaded_log_ids(),
+    m_store(),
     m_latest_log_id(-1)
 {}
 
+CombatLogManager::~CombatLogManager()
+{}
+
 std::map<int, CombatLog>::const_iterator CombatLogManager::begin() const
 { return m_logs.begin(); }
 
@@ -164,37 +324,142 @@ std::map<int, CombatLog>::const_iterator CombatLogManager::find(int log_id) cons
 { return m_logs.find(log_id); }
 
 bool CombatLogManager::LogAvailable(int log_id) const
-{ return m_logs.begin() != m_logs.end(); }
+{ return LogLoaded(log_id) || m_unloaded_log_ids.count(log_id); }
+
+bool CombatLogManager::LogLoaded(int log_id) const
+{ return m_logs.count(log_id) || (m_store && m_store->Contains(log_id)); }
 
 const CombatLog& CombatLogManager::GetLog(int log_id) const {
     std::map<int, CombatLog>::const_iterator it = m_logs.find(log_id);
     if (it != m_logs.end())
         return it->second;
+
+    // read stored logs back into memory when they are asked for.  logs
+    // already read back are not moved by inserting others, so references
+    // returned earlier stay valid.
+    if (m_store) {
+        boost::mutex::scoped_lock lock(m_stored_logs_mutex);
+        it = m_stored_logs.find(log_id);
+        if (it != m_stored_logs.end())
+            return it->second;
+
+        CombatLog log;
+        if (m_store->Read(log_id, log)) {
+            CombatLog& cached_log = m_stored_logs[log_id];
+            std::swap(cached_log, log);
+            return cached_log;
+        }
+    }
+
     static CombatLog EMPTY_LOG;
     return EMPTY_LOG;
 }
 
+void CombatLogManager::GetLogs(const std::vector<int>& log_ids, int empire_id,
+                               std::map<int, CombatLog>& logs) const
+{
+    for (std::vector<int>::const_iterator id_it = log_ids.begin(); id_it != log_ids.end(); ++id_it) {
+        int log_id = *id_it;
+        std::map<int, CombatLog>::const_iterator it = m_logs.find(log_id);
+        if (it != m_logs.end()) {
+            if (empire_id == ALL_EMPIRES || it->second.empire_ids.count(empire_id))
+                logs[log_id] = it->second;
+        } else if (m_store && m_store->Visible(log_id, empire_id)) {
+            m_store->Read(log_id, logs[log_id]);
+        }
+    }
+}
+
 int CombatLogManager::AddLog(const CombatLog& log) {
     int new_log_id = ++m_latest_log_id;
-    m_logs[new_log_id] = log;
+    SetLog(new_log_id, log);
     return new_log_id;
 }
 
-void CombatLogManager::RemoveLog(int log_id)
-{ m_logs.erase(log_id); }
+void CombatLogManager::SetLog(int log_id, const CombatLog& log) {
+    m_unloaded_log_ids.erase(log_id);
+    {
+        boost::mutex::scoped_lock lock(m_stored_logs_mutex);
+        m_stored_logs.erase(log_id);
+    }
+    if (m_store && m_store->Write(log_id, log)) {
+        m_logs.erase(log_id);
+        return;
+    }
+    m_logs[log_id] = log;
+}
 
-void CombatLogManager::Clear()
-{ m_logs.clear(); }
+void CombatLogManager::RemoveLog(int log_id) {
+    m_logs.erase(log_id);
+    {
+        boost::mutex::scoped_lock lock(m_stored_logs_mutex);
+        m_stored_logs.erase(log_id);
+    }
+    m_unloaded_log_ids.erase(log_id);
+    if (m_store)
+        m_store->Remove(log_id);
+}
 
-void CombatLogManager::GetLogsToSerialize(std::map<int, CombatLog>& logs, int encoding_empire) const {
+void CombatLogManager::Clear() {
+    m_logs.clear();
+    {
+        boost::mutex::scoped_lock lock(m_stored_logs_mutex);
+        m_stored_logs.clear();
+    }
+    m_unloaded_log_ids.clear();
+    if (m_store)
+        m_store->Clear();
+}
+
+bool CombatLogManager::OpenStore(const boost::filesystem::path& path) {
+    m_store.reset(new Store(path));
+    if (!m_store->IsOpen()) {
+        m_store.reset();
+        return false;
+    }
+
+    // move any logs already in memory to the store
+    std::map<int, CombatLog> logs;
+    logs.swap(m_logs);
+    for (std::map<int, CombatLog>::const_iterator it = logs.begin(); it != logs.end(); ++it)
+        SetLog(it->first, it->second);
+    return true;
+}
+
+void CombatLogManager::GetLogsToSerialize(std::map<int, CombatLog>& logs, std::set<int>& log_ids,
+                                          int encoding_empire) const
+{
     if (&logs == &m_logs)
         return;
-    // TODO: filter logs by who should have access to them
-    logs = m_logs;
+
+    if (encoding_empire == ALL_EMPIRES) {
+        // saved games get the complete logs, since the store does not outlive the server
+        logs = m_logs;
+        if (m_store) {
+            std::set<int> stored_log_ids;
+            m_store->GetLogIDs(stored_log_ids, ALL_EMPIRES);
+            for (std::set<int>::const_iterator it = stored_log_ids.begin(); it != stored_log_ids.end(); ++it)
+                if (!logs.count(*it))
+                    m_store->Read(*it, logs[*it]);
+        }
+        log_ids = m_unloaded_log_ids;
+        return;
+    }
+
+    // players get only the ids of the logs of combats their empire was in,
+    // and fetch the contents when they want to see them
+    for (std::map<int, CombatLog>::const_iterator it = m_logs.begin(); it != m_logs.end(); ++it)
+        if (it->second.empire_ids.count(encoding_empire))
+            log_ids.insert(log_ids.end(), it->first);
+    if (m_store)
+        m_store->GetLogIDs(log_ids, encoding_empire);
 }
 
-void CombatLogManager::SetLog(int log_id, const CombatLog& log)
-{ m_logs[log_id] = log; }
+void CombatLogManager::SetLogIDs(const std::set<int>& log_ids) {
+    for (std::set<int>::const_iterator it = log_ids.begin(); it != log_ids.end(); ++it)
+        if (!LogLoaded(*it))
+            m_unloaded_log_ids.insert(*it);
+}
 
 CombatLogManager& CombatLogManager::GetCombatLogManager() {
     static CombatLogManager manager;
@@ -6,6 +6,10 @@
 
 #include "../util/Export.h"
 
+#include <boost/filesystem/path.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
 // A snapshot of the state of a participant of the combat
 // at it's end
 struct FO_COMMON_API CombatParticipantState {
@@ -40,39 +44,70 @@ struct FO_COMMON_API CombatLog {
 
 BOOST_CLASS_VERSION ( CombatLog, 1 );
 
-/** Stores and retreives combat logs. */
+/** Stores and retreives combat logs.
+  *
+  * On the server, logs can be kept in an on-disk store instead of memory;
+  * see OpenStore().  Turn updates then carry only the ids of the logs an
+  * empire may see, and clients fetch the contents of a log from the server
+  * when it is first shown.  Until then, the log is available but not
+  * loaded on the client. */
 class FO_COMMON_API CombatLogManager {
 public:
+    /** \name Structors */ //@{
+    ~CombatLogManager();
+    //@}
+
     /** \name Accessors */ //@{
-    std::map<int, CombatLog>::const_iterator    begin() const;
+    std::map<int, CombatLog>::const_iterator    begin() const;  // iterates over the logs held in memory
     std::map<int, CombatLog>::const_iterator    end() const;
     std::map<int, CombatLog>::const_iterator    find(int log_id) const;
-    bool                                        LogAvailable(int log_id) const; // returns whether a log with the indicated id is available
-    const CombatLog&                            GetLog(int log_id) const;       // returns requested combat log, or an empty default log if no log with the requested id exists
+    bool                                        LogAvailable(int log_id) const; // returns whether a log with the indicated id exists, even if its contents are not loaded
+    bool                                        LogLoaded(int log_id) const;    // returns whether the contents of the indicated log can be returned by GetLog without fetching them from the server
+    const CombatLog&                            GetLog(int log_id) const;       // returns requested combat log, or an empty default log if no log with the requested id is loaded
+
+    /** Inserts into \a logs those of the logs with ids \a log_ids that the
+      * empire with id \a empire_id participated in, or all of them if
+      * \a empire_id is ALL_EMPIRES. */
+    void    GetLogs(const std::vector<int>& log_ids, int empire_id, std::map<int, CombatLog>& logs) const;
     //@}
 
     /** \name Mutators */ //@{
     int     AddLog(const CombatLog& log);   // adds log, returns unique log id
+    void    SetLog(int log_id, const CombatLog& log);   // stores the contents of the log with the indicated id, such as after fetching it
     void    RemoveLog(int log_id);
     void    Clear();
+
+    /** Keeps logs that are added later in an indexed file at \a path,
+      * rather than in memory.  The file is created, replacing any existing
+      * file, and is removed when the store is closed.  Returns false if the
+      * file could not be created, in which case logs stay in memory. */
+    bool    OpenStore(const boost::filesystem::path& path);
     //@}
 
     static CombatLogManager& GetCombatLogManager();
 
 private:
+    class Store;
+
     CombatLogManager();
 
-    void GetLogsToSerialize(std::map<int, CombatLog>& logs, int encoding_empire) const;
-    void SetLog(int log_id, const CombatLog& log);
+    void GetLogsToSerialize(std::map<int, CombatLog>& logs, std::set<int>& log_ids, int encoding_empire) const;
+    void SetLogIDs(const std::set<int>& log_ids);
 
-    std::map<int, CombatLog>    m_logs;
-    int                         m_latest_log_id;
+    std::map<int, CombatLog>            m_logs;             ///< logs held in memory, when no store is open
+    mutable std::map<int, CombatLog>    m_stored_logs;      ///< logs read back from the store by GetLog
+    mutable boost::mutex                m_stored_logs_mutex;///< guards m_stored_logs, as GetLog may be called from several threads
+    std::set<int>                       m_unloaded_log_ids; ///< ids of logs known to exist, whose contents have not been fetched
+    boost::scoped_ptr<Store>            m_store;
+    int                                 m_latest_log_id;
 
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
 };
 
+BOOST_CLASS_VERSION(CombatLogManager, 1);
+
 /** returns the singleton combat log manager */
 FO_COMMON_API CombatLogManager&   GetCombatLogManager();
 
@@ -87,18 +122,22 @@ template <class Archive>
 void CombatLogManager::serialize(Archive& ar, const unsigned int version)
 {
     std::map<int, CombatLog> logs;
+    std::set<int> log_ids;  // logs sent by id only, to be fetched on demand
 
     if (Archive::is_saving::value) {
-        GetLogsToSerialize(logs, GetUniverse().EncodingEmpire());
+        GetLogsToSerialize(logs, log_ids, GetEncodingEmpire());
     }
 
     ar  & BOOST_SERIALIZATION_NVP(logs)
         & BOOST_SERIALIZATION_NVP(m_latest_log_id);
+    if (version >= 1)
+        ar  & BOOST_SERIALIZATION_NVP(log_ids);
 
     if (Archive::is_loading::value) {
         // copy new logs, but don't erase old ones
         for (std::map<int, CombatLog>::const_iterator it = logs.begin(); it != logs.end(); ++it)
             this->SetLog(it->first, it->second);
+        SetLogIDs(log_ids);
     }
 }
 
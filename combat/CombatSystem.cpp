@@ -87,6 +87,9 @@ CombatInfo::CombatInfo(int system_id_, int turn_) :
         int empire_id = *empire_it;
         if (empire_id == ALL_EMPIRES)
             continue;
+        // combat results are copied onto these objects, so they must not be
+        // shared with empires that aren't in the combat
+        GetUniverse().UnshareEmpireLatestKnownObject(system->ID(), empire_id);
         empire_known_objects[empire_id].Insert(GetEmpireKnownSystem(system->ID(), empire_id));
         empire_object_visibility[empire_id][system->ID()] = GetUniverse().GetObjectVisibilityByEmpire(empire_id, system->ID());
         for (std::set< int >::iterator obj_it = local_object_ids.begin(); obj_it != local_object_ids.end(); obj_it++) {
@@ -123,6 +126,7 @@ CombatInfo::CombatInfo(int system_id_, int turn_) :
                         fleet->Unowned() ||
                         Empires().GetDiplomaticStatus(empire_id, fleet->Owner()) == DIPLO_WAR)))
             {
+                GetUniverse().UnshareEmpireLatestKnownObject(ship->ID(), empire_id);
                 empire_known_objects[empire_id].Insert(GetEmpireKnownShip(ship->ID(), empire_id));}
                 ship_known += boost::lexical_cast<std::string>(empire_id) + ", ";
         }
@@ -144,6 +148,7 @@ CombatInfo::CombatInfo(int system_id_, int turn_) :
             if (empire_id == ALL_EMPIRES)
                 continue;
             if (GetUniverse().GetObjectVisibilityByEmpire(planet_id, empire_id) > VIS_BASIC_VISIBILITY) {
+                GetUniverse().UnshareEmpireLatestKnownObject(planet->ID(), empire_id);
                 empire_known_objects[empire_id].Insert(GetEmpireKnownPlanet(planet->ID(), empire_id));
                 planet_known += boost::lexical_cast<std::string>(empire_id) + ", ";
             }
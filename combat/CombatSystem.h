@@ -4,6 +4,7 @@
 
 #include "../universe/Universe.h"
 #include "../util/AppInterface.h"
+#include "../util/Serialize.h"
 #include "CombatEvent.h"
 
 #include <boost/serialization/version.hpp>
@@ -69,15 +70,16 @@ void CombatInfo::save(Archive & ar, const unsigned int version) const
     std::map<int, std::set<int> >       filtered_destroyed_object_knowers;
     Universe::EmpireObjectVisibilityMap filtered_empire_object_visibility;
     std::vector<CombatEventPtr>         filtered_combat_events;
-
-    GetEmpireIdsToSerialize(                filtered_empire_ids,                GetUniverse().EncodingEmpire());
-    GetObjectsToSerialize(                  filtered_objects,                   GetUniverse().EncodingEmpire());
-    GetEmpireKnownObjectsToSerialize(       filtered_empire_known_objects,      GetUniverse().EncodingEmpire());
-    GetDamagedObjectsToSerialize(           filtered_damaged_object_ids,        GetUniverse().EncodingEmpire());
-    GetDestroyedObjectsToSerialize(         filtered_destroyed_object_ids,      GetUniverse().EncodingEmpire());
-    GetDestroyedObjectKnowersToSerialize(   filtered_destroyed_object_knowers,  GetUniverse().EncodingEmpire());
-    GetEmpireObjectVisibilityToSerialize(   filtered_empire_object_visibility,  GetUniverse().EncodingEmpire());
-    GetCombatEventsToSerialize(             filtered_combat_events,             GetUniverse().EncodingEmpire());
+    int                                 encoding_empire = GetEncodingEmpire();
+
+    GetEmpireIdsToSerialize(                filtered_empire_ids,                encoding_empire);
+    GetObjectsToSerialize(                  filtered_objects,                   encoding_empire);
+    GetEmpireKnownObjectsToSerialize(       filtered_empire_known_objects,      encoding_empire);
+    GetDamagedObjectsToSerialize(           filtered_damaged_object_ids,        encoding_empire);
+    GetDestroyedObjectsToSerialize(         filtered_destroyed_object_ids,      encoding_empire);
+    GetDestroyedObjectKnowersToSerialize(   filtered_destroyed_object_knowers,  encoding_empire);
+    GetEmpireObjectVisibilityToSerialize(   filtered_empire_object_visibility,  encoding_empire);
+    GetCombatEventsToSerialize(             filtered_combat_events,             encoding_empire);
 
     ar  & BOOST_SERIALIZATION_NVP(turn)
         & BOOST_SERIALIZATION_NVP(system_id)
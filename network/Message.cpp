@@ -15,6 +15,7 @@
 #include "../util/Serialize.h"
 #include "../util/ScopedTimer.h"
 #include <boost/lexical_cast.hpp>
+#include <boost/iostreams/stream.hpp>
 #include <boost/algorithm/string/erase.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/serialization/deque.hpp>
@@ -36,6 +37,52 @@
 namespace {
     const std::string DUMMY_EMPTY_MESSAGE = "Lathanda";
     const std::string ACKNOWLEDGEMENT = "ACK";
+
+    /** A message body under construction.  The buffer grows geometrically,
+      * and is handed to the finished Message as is, so the serialized data
+      * is never copied out of a stream and then again into the message. */
+    struct MessageBody {
+        MessageBody() :
+            size(0),
+            capacity(0)
+        {}
+
+        boost::shared_array<char>   data;
+        std::size_t                 size;
+        std::size_t                 capacity;
+    };
+
+    /** A boost::iostreams sink that appends to a MessageBody. */
+    class MessageBodySink {
+    public:
+        typedef char                        char_type;
+        typedef boost::iostreams::sink_tag  category;
+
+        explicit MessageBodySink(MessageBody* body) :
+            m_body(body)
+        {}
+
+        std::streamsize write(const char* s, std::streamsize n) {
+            std::size_t required = m_body->size + static_cast<std::size_t>(n);
+            if (m_body->capacity < required) {
+                std::size_t capacity = std::max(required, std::max<std::size_t>(2 * m_body->capacity, 256));
+                boost::shared_array<char> data(new char[capacity]);
+                std::copy(m_body->data.get(), m_body->data.get() + m_body->size, data.get());
+                m_body->data.swap(data);
+                m_body->capacity = capacity;
+            }
+            std::copy(s, s + n, m_body->data.get() + m_body->size);
+            m_body->size = required;
+            return n;
+        }
+
+    private:
+        MessageBody* m_body;
+    };
+
+    /** The stream the named ctors serialize into; it must be destroyed,
+      * which flushes it, before the body is used. */
+    typedef boost::iostreams::stream<MessageBodySink> MessageBodyStream;
 }
 
 ////////////////////////////////////////////////
@@ -87,6 +134,20 @@ Message::Message(MessageType type,
     m_message_text(new char[text.size()])
 { std::copy(text.begin(), text.end(), m_message_text.get()); }
 
+Message::Message(MessageType type,
+                 int sending_player,
+                 int receiving_player,
+                 boost::shared_array<char> text,
+                 std::size_t size,
+                 bool synchronous_response/* = false*/) :
+    m_type(type),
+    m_sending_player(sending_player),
+    m_receiving_player(receiving_player),
+    m_synchronous_response(synchronous_response),
+    m_message_size(size),
+    m_message_text(text)
+{}
+
 Message::MessageType Message::Type() const
 { return m_type; }
 
@@ -125,6 +186,9 @@ void Message::Swap(Message& rhs) {
     std::swap(m_message_text, rhs.m_message_text);
 }
 
+void Message::SetReceivingPlayer(int receiving_player)
+{ m_receiving_player = receiving_player; }
+
 bool operator==(const Message& lhs, const Message& rhs) {
     return
         lhs.Type() == rhs.Type() &&
@@ -159,8 +223,9 @@ void HeaderToBuffer(const Message& message, int* header_buf) {
 // Message named ctors
 ////////////////////////////////////////////////
 Message ErrorMessage(const std::string& problem, bool fatal/* = true*/) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(problem)
@@ -171,12 +236,13 @@ Message ErrorMessage(const std::string& problem, bool fatal/* = true*/) {
                << BOOST_SERIALIZATION_NVP(fatal);
         }
     }
-    return Message(Message::ERROR_MSG, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::ERROR_MSG, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, body.data, body.size);
 }
 
 Message ErrorMessage(int player_id, const std::string& problem, bool fatal/* = true*/) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(problem)
@@ -187,12 +253,13 @@ Message ErrorMessage(int player_id, const std::string& problem, bool fatal/* = t
                << BOOST_SERIALIZATION_NVP(fatal);
         }
     }
-    return Message(Message::ERROR_MSG, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::ERROR_MSG, Networking::INVALID_PLAYER_ID, player_id, body.data, body.size);
 }
 
 Message HostSPGameMessage(const SinglePlayerSetupData& setup_data) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(setup_data);
@@ -201,15 +268,16 @@ Message HostSPGameMessage(const SinglePlayerSetupData& setup_data) {
             oa << BOOST_SERIALIZATION_NVP(setup_data);
         }
     }
-    return Message(Message::HOST_SP_GAME, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::HOST_SP_GAME, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, body.data, body.size);
 }
 
 Message HostMPGameMessage(const std::string& host_player_name)
 { return Message(Message::HOST_MP_GAME, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, host_player_name); }
 
 Message JoinGameMessage(const std::string& player_name, Networking::ClientType client_type) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(player_name)
@@ -220,7 +288,7 @@ Message JoinGameMessage(const std::string& player_name, Networking::ClientType c
                << BOOST_SERIALIZATION_NVP(client_type);
         }
     }
-    return Message(Message::JOIN_GAME, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::JOIN_GAME, Networking::INVALID_PLAYER_ID, Networking::INVALID_PLAYER_ID, body.data, body.size);
 }
 
 Message HostIDMessage(int host_player_id) {
@@ -235,14 +303,15 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
                          const std::map<int, PlayerInfo>& players,
                          const GalaxySetupData& galaxy_setup_data)
 {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(single_player_game)
                << BOOST_SERIALIZATION_NVP(empire_id)
                << BOOST_SERIALIZATION_NVP(current_turn);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             oa << BOOST_SERIALIZATION_NVP(empires)
                << BOOST_SERIALIZATION_NVP(species)
                << BOOST_SERIALIZATION_NVP(combat_logs);
@@ -256,7 +325,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
             oa << BOOST_SERIALIZATION_NVP(single_player_game)
                << BOOST_SERIALIZATION_NVP(empire_id)
                << BOOST_SERIALIZATION_NVP(current_turn);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             oa << BOOST_SERIALIZATION_NVP(empires)
                << BOOST_SERIALIZATION_NVP(species)
                << BOOST_SERIALIZATION_NVP(combat_logs);
@@ -267,7 +336,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
             oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
         }
     }
-    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, body.data, body.size);
 }
 
 Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
@@ -278,14 +347,15 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
                          const OrderSet& orders, const SaveGameUIData* ui_data,
                          const GalaxySetupData& galaxy_setup_data)
 {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(single_player_game)
                << BOOST_SERIALIZATION_NVP(empire_id)
                << BOOST_SERIALIZATION_NVP(current_turn);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             oa << BOOST_SERIALIZATION_NVP(empires)
                << BOOST_SERIALIZATION_NVP(species)
                << BOOST_SERIALIZATION_NVP(combat_logs);
@@ -306,7 +376,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
             oa << BOOST_SERIALIZATION_NVP(single_player_game)
                << BOOST_SERIALIZATION_NVP(empire_id)
                << BOOST_SERIALIZATION_NVP(current_turn);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             oa << BOOST_SERIALIZATION_NVP(empires)
                << BOOST_SERIALIZATION_NVP(species)
                << BOOST_SERIALIZATION_NVP(combat_logs);
@@ -324,7 +394,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
             oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
         }
     }
-    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, body.data, body.size);
 }
 
 Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
@@ -335,14 +405,15 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
                          const OrderSet& orders, const std::string* save_state_string,
                          const GalaxySetupData& galaxy_setup_data)
 {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(single_player_game)
                << BOOST_SERIALIZATION_NVP(empire_id)
                << BOOST_SERIALIZATION_NVP(current_turn);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             oa << BOOST_SERIALIZATION_NVP(empires)
                << BOOST_SERIALIZATION_NVP(species)
                << BOOST_SERIALIZATION_NVP(combat_logs);
@@ -363,7 +434,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
             oa << BOOST_SERIALIZATION_NVP(single_player_game)
                << BOOST_SERIALIZATION_NVP(empire_id)
                << BOOST_SERIALIZATION_NVP(current_turn);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             oa << BOOST_SERIALIZATION_NVP(empires)
                << BOOST_SERIALIZATION_NVP(species)
                << BOOST_SERIALIZATION_NVP(combat_logs);
@@ -381,7 +452,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
             oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
         }
     }
-    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, body.data, body.size);
 }
 
 Message HostSPAckMessage(int player_id)
@@ -394,8 +465,9 @@ Message JoinAckMessage(int player_id)
 { return Message(Message::JOIN_GAME, Networking::INVALID_PLAYER_ID, player_id, ACKNOWLEDGEMENT); }
 
 Message TurnOrdersMessage(int sender, const OrderSet& orders) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             Serialize(oa, orders);
@@ -404,12 +476,13 @@ Message TurnOrdersMessage(int sender, const OrderSet& orders) {
             Serialize(oa, orders);
         }
     }
-    return Message(Message::TURN_ORDERS, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::TURN_ORDERS, sender, Networking::INVALID_PLAYER_ID, body.data, body.size);
 }
 
 Message TurnProgressMessage(Message::TurnProgressPhase phase_id, int player_id) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(phase_id);
@@ -418,12 +491,13 @@ Message TurnProgressMessage(Message::TurnProgressPhase phase_id, int player_id)
             oa << BOOST_SERIALIZATION_NVP(phase_id);
         }
     }
-    return Message(Message::TURN_PROGRESS, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::TURN_PROGRESS, Networking::INVALID_PLAYER_ID, player_id, body.data, body.size);
 }
 
 Message PlayerStatusMessage(int player_id, int about_player_id, Message::PlayerStatus player_status) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(about_player_id)
@@ -434,7 +508,7 @@ Message PlayerStatusMessage(int player_id, int about_player_id, Message::PlayerS
                << BOOST_SERIALIZATION_NVP(player_status);
         }
     }
-    return Message(Message::PLAYER_STATUS, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::PLAYER_STATUS, Networking::INVALID_PLAYER_ID, player_id, body.data, body.size);
 }
 
 Message TurnUpdateMessage(int player_id, int empire_id, int current_turn,
@@ -442,11 +516,12 @@ Message TurnUpdateMessage(int player_id, int empire_id, int current_turn,
                           const SpeciesManager& species, const CombatLogManager& combat_logs,
                           const std::map<int, PlayerInfo>& players)
 {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             oa << BOOST_SERIALIZATION_NVP(current_turn)
                << BOOST_SERIALIZATION_NVP(empires)
                << BOOST_SERIALIZATION_NVP(species)
@@ -455,7 +530,7 @@ Message TurnUpdateMessage(int player_id, int empire_id, int current_turn,
             oa << BOOST_SERIALIZATION_NVP(players);
         } else {
             freeorion_xml_oarchive oa(os);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             oa << BOOST_SERIALIZATION_NVP(current_turn)
                << BOOST_SERIALIZATION_NVP(empires)
                << BOOST_SERIALIZATION_NVP(species)
@@ -464,28 +539,30 @@ Message TurnUpdateMessage(int player_id, int empire_id, int current_turn,
             oa << BOOST_SERIALIZATION_NVP(players);
         }
     }
-    return Message(Message::TURN_UPDATE, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::TURN_UPDATE, Networking::INVALID_PLAYER_ID, player_id, body.data, body.size);
 }
 
 Message TurnPartialUpdateMessage(int player_id, int empire_id, const Universe& universe) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             Serialize(oa, universe);
         } else {
             freeorion_xml_oarchive oa(os);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             Serialize(oa, universe);
         }
     }
-    return Message(Message::TURN_PARTIAL_UPDATE, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::TURN_PARTIAL_UPDATE, Networking::INVALID_PLAYER_ID, player_id, body.data, body.size);
 }
 
 Message ClientSaveDataMessage(int sender, const OrderSet& orders, const SaveGameUIData& ui_data) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             Serialize(oa, orders);
@@ -504,12 +581,13 @@ Message ClientSaveDataMessage(int sender, const OrderSet& orders, const SaveGame
                << BOOST_SERIALIZATION_NVP(save_state_string_available);
         }
     }
-    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, body.data, body.size);
 }
 
 Message ClientSaveDataMessage(int sender, const OrderSet& orders, const std::string& save_state_string) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             Serialize(oa, orders);
@@ -528,12 +606,13 @@ Message ClientSaveDataMessage(int sender, const OrderSet& orders, const std::str
                << BOOST_SERIALIZATION_NVP(save_state_string);
         }
     }
-    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, body.data, body.size);
 }
 
 Message ClientSaveDataMessage(int sender, const OrderSet& orders) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             Serialize(oa, orders);
@@ -550,7 +629,7 @@ Message ClientSaveDataMessage(int sender, const OrderSet& orders) {
                << BOOST_SERIALIZATION_NVP(save_state_string_available);
         }
     }
-    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::CLIENT_SAVE_DATA, sender, Networking::INVALID_PLAYER_ID, body.data, body.size);
 }
 
 Message RequestNewObjectIDMessage(int sender)
@@ -582,8 +661,9 @@ Message SingleRecipientChatMessage(int sender, int receiver, const std::string&
 { return Message(Message::PLAYER_CHAT, sender, receiver, msg); }
 
 Message DiplomacyMessage(int sender, int receiver, const DiplomaticMessage& diplo_message) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(diplo_message);
@@ -592,12 +672,13 @@ Message DiplomacyMessage(int sender, int receiver, const DiplomaticMessage& dipl
             oa << BOOST_SERIALIZATION_NVP(diplo_message);
         }
     }
-    return Message(Message::DIPLOMACY, sender, receiver, os.str());
+    return Message(Message::DIPLOMACY, sender, receiver, body.data, body.size);
 }
 
 Message DiplomaticStatusMessage(int receiver, const DiplomaticStatusUpdateInfo& diplo_update) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(diplo_update.empire1_id)
@@ -610,14 +691,15 @@ Message DiplomaticStatusMessage(int receiver, const DiplomaticStatusUpdateInfo&
                << BOOST_SERIALIZATION_NVP(diplo_update.diplo_status);
         }
     }
-    return Message(Message::DIPLOMATIC_STATUS, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::DIPLOMATIC_STATUS, Networking::INVALID_PLAYER_ID, receiver, body.data, body.size);
 }
 
 Message VictoryDefeatMessage(int receiver, Message::VictoryOrDefeat victory_or_defeat,
                              const std::string& reason_string, int empire_id)
 {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(victory_or_defeat)
@@ -630,12 +712,13 @@ Message VictoryDefeatMessage(int receiver, Message::VictoryOrDefeat victory_or_d
                << BOOST_SERIALIZATION_NVP(empire_id);
         }
     }
-    return Message(Message::VICTORY_DEFEAT, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::VICTORY_DEFEAT, Networking::INVALID_PLAYER_ID, receiver, body.data, body.size);
 }
 
 Message PlayerEliminatedMessage(int receiver, int empire_id, const std::string& empire_name) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(empire_id)
@@ -646,14 +729,15 @@ Message PlayerEliminatedMessage(int receiver, int empire_id, const std::string&
                << BOOST_SERIALIZATION_NVP(empire_name);
         }
     }
-    return Message(Message::PLAYER_ELIMINATED, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::PLAYER_ELIMINATED, Networking::INVALID_PLAYER_ID, receiver, body.data, body.size);
 }
 
 Message EndGameMessage(int receiver, Message::EndGameReason reason,
                        const std::string& reason_player_name/* = ""*/)
 {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(reason)
@@ -664,12 +748,13 @@ Message EndGameMessage(int receiver, Message::EndGameReason reason,
                << BOOST_SERIALIZATION_NVP(reason_player_name);
         }
     }
-    return Message(Message::END_GAME, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::END_GAME, Networking::INVALID_PLAYER_ID, receiver, body.data, body.size);
 }
 
 Message ModeratorActionMessage(int sender, const Moderator::ModeratorAction& action) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         const Moderator::ModeratorAction* mod_action = &action;
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
@@ -679,7 +764,7 @@ Message ModeratorActionMessage(int sender, const Moderator::ModeratorAction& act
             oa << BOOST_SERIALIZATION_NVP(mod_action);
         }
     }
-    return Message(Message::MODERATOR_ACTION, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::MODERATOR_ACTION, sender, Networking::INVALID_PLAYER_ID, body.data, body.size);
 }
 
 Message ShutdownServerMessage(int sender)
@@ -691,8 +776,9 @@ Message RequestSavePreviewsMessage(int sender, std::string directory)
 
 /** returns the savegame previews to the client */
 Message DispatchSavePreviewsMessage(int receiver, const PreviewInformation& previews) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(previews);
@@ -701,15 +787,48 @@ Message DispatchSavePreviewsMessage(int receiver, const PreviewInformation& prev
             oa << BOOST_SERIALIZATION_NVP(previews);
         }
     }
-    return Message(Message::DISPATCH_SAVE_PREVIEWS, Networking::INVALID_PLAYER_ID, receiver, os.str(), true);
+    return Message(Message::DISPATCH_SAVE_PREVIEWS, Networking::INVALID_PLAYER_ID, receiver, body.data, body.size, true);
+}
+
+/** requests the contents of combat logs from the server synchronously */
+Message RequestCombatLogsMessage(int sender, const std::vector<int>& log_ids) {
+    MessageBody body;
+    {
+        MessageBodyStream os(&body);
+        if (GetOptionsDB().Get<bool>("binary-serialization")) {
+            freeorion_bin_oarchive oa(os);
+            oa << BOOST_SERIALIZATION_NVP(log_ids);
+        } else {
+            freeorion_xml_oarchive oa(os);
+            oa << BOOST_SERIALIZATION_NVP(log_ids);
+        }
+    }
+    return Message(Message::REQUEST_COMBAT_LOGS, sender, Networking::INVALID_PLAYER_ID, body.data, body.size);
+}
+
+/** returns the requested combat logs to the client */
+Message DispatchCombatLogsMessage(int receiver, const std::map<int, CombatLog>& logs) {
+    MessageBody body;
+    {
+        MessageBodyStream os(&body);
+        if (GetOptionsDB().Get<bool>("binary-serialization")) {
+            freeorion_bin_oarchive oa(os);
+            oa << BOOST_SERIALIZATION_NVP(logs);
+        } else {
+            freeorion_xml_oarchive oa(os);
+            oa << BOOST_SERIALIZATION_NVP(logs);
+        }
+    }
+    return Message(Message::DISPATCH_COMBAT_LOGS, Networking::INVALID_PLAYER_ID, receiver, body.data, body.size, true);
 }
 
 ////////////////////////////////////////////////
 // Multiplayer Lobby Message named ctors
 ////////////////////////////////////////////////
 Message LobbyUpdateMessage(int sender, const MultiplayerLobbyData& lobby_data) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(lobby_data);
@@ -718,12 +837,13 @@ Message LobbyUpdateMessage(int sender, const MultiplayerLobbyData& lobby_data) {
             oa << BOOST_SERIALIZATION_NVP(lobby_data);
         }
     }
-    return Message(Message::LOBBY_UPDATE, sender, Networking::INVALID_PLAYER_ID, os.str());
+    return Message(Message::LOBBY_UPDATE, sender, Networking::INVALID_PLAYER_ID, body.data, body.size);
 }
 
 Message ServerLobbyUpdateMessage(int receiver, const MultiplayerLobbyData& lobby_data) {
-    std::ostringstream os;
+    MessageBody body;
     {
+        MessageBodyStream os(&body);
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_oarchive oa(os);
             oa << BOOST_SERIALIZATION_NVP(lobby_data);
@@ -732,7 +852,7 @@ Message ServerLobbyUpdateMessage(int receiver, const MultiplayerLobbyData& lobby
             oa << BOOST_SERIALIZATION_NVP(lobby_data);
         }
     }
-    return Message(Message::LOBBY_UPDATE, Networking::INVALID_PLAYER_ID, receiver, os.str());
+    return Message(Message::LOBBY_UPDATE, Networking::INVALID_PLAYER_ID, receiver, body.data, body.size);
 }
 
 Message LobbyChatMessage(int sender, int receiver, const std::string& data)
@@ -803,7 +923,7 @@ void ExtractMessageData(const Message& msg, bool& single_player_game, int& empir
             ia >> BOOST_SERIALIZATION_NVP(single_player_game)
                >> BOOST_SERIALIZATION_NVP(empire_id)
                >> BOOST_SERIALIZATION_NVP(current_turn);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
 
             boost::timer deserialize_timer;
             ia >> BOOST_SERIALIZATION_NVP(empires);
@@ -837,7 +957,7 @@ void ExtractMessageData(const Message& msg, bool& single_player_game, int& empir
             ia >> BOOST_SERIALIZATION_NVP(single_player_game)
                >> BOOST_SERIALIZATION_NVP(empire_id)
                >> BOOST_SERIALIZATION_NVP(current_turn);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
 
             boost::timer deserialize_timer;
             ia >> BOOST_SERIALIZATION_NVP(empires);
@@ -932,7 +1052,7 @@ void ExtractMessageData(const Message& msg, int empire_id, int& current_turn,
         std::istringstream is(msg.Text());
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_iarchive ia(is);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             ia >> BOOST_SERIALIZATION_NVP(current_turn)
                >> BOOST_SERIALIZATION_NVP(empires)
                >> BOOST_SERIALIZATION_NVP(species)
@@ -941,7 +1061,7 @@ void ExtractMessageData(const Message& msg, int empire_id, int& current_turn,
             ia >> BOOST_SERIALIZATION_NVP(players);
         } else {
             freeorion_xml_iarchive ia(is);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             ia >> BOOST_SERIALIZATION_NVP(current_turn)
                >> BOOST_SERIALIZATION_NVP(empires)
                >> BOOST_SERIALIZATION_NVP(species)
@@ -965,11 +1085,11 @@ void ExtractMessageData(const Message& msg, int empire_id, Universe& universe) {
         std::istringstream is(msg.Text());
         if (GetOptionsDB().Get<bool>("binary-serialization")) {
             freeorion_bin_iarchive ia(is);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             Deserialize(ia, universe);
         } else {
             freeorion_xml_iarchive ia(is);
-            GetUniverse().EncodingEmpire() = empire_id;
+            ScopedEncodingEmpire encoding_empire(empire_id);
             Deserialize(ia, universe);
         }
     } catch (const std::exception& err) {
@@ -1243,3 +1363,41 @@ void ExtractMessageData(const Message& msg, PreviewInformation& previews) {
         throw err;
     }
 }
+
+void ExtractMessageData(const Message& msg, std::vector<int>& log_ids) {
+    try {
+        std::istringstream is(msg.Text());
+        if (GetOptionsDB().Get<bool>("binary-serialization")) {
+            freeorion_bin_iarchive ia(is);
+            ia >> BOOST_SERIALIZATION_NVP(log_ids);
+        } else {
+            freeorion_xml_iarchive ia(is);
+            ia >> BOOST_SERIALIZATION_NVP(log_ids);
+        }
+    } catch (const std::exception& err) {
+        ErrorLogger() << "ExtractMessageData(const Message& msg, std::vector<int>& log_ids) failed!  "
+                      << "Message:\n"
+                      << msg.Text() << "\n"
+                      << "Error: " << err.what();
+        throw err;
+    }
+}
+
+void ExtractMessageData(const Message& msg, std::map<int, CombatLog>& logs) {
+    try {
+        std::istringstream is(msg.Text());
+        if (GetOptionsDB().Get<bool>("binary-serialization")) {
+            freeorion_bin_iarchive ia(is);
+            ia >> BOOST_SERIALIZATION_NVP(logs);
+        } else {
+            freeorion_xml_iarchive ia(is);
+            ia >> BOOST_SERIALIZATION_NVP(logs);
+        }
+    } catch (const std::exception& err) {
+        ErrorLogger() << "ExtractMessageData(const Message& msg, std::map<int, CombatLog>& logs) failed!  "
+                      << "Message:\n"
+                      << msg.Text() << "\n"
+                      << "Error: " << err.what();
+        throw err;
+    }
+}
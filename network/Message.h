@@ -18,6 +18,7 @@
 
 class EmpireManager;
 class SpeciesManager;
+struct CombatLog;
 class CombatLogManager;
 class Message;
 struct MultiplayerLobbyData;
@@ -87,7 +88,9 @@ public:
         MODERATOR_ACTION,       ///< sent by client to server when a moderator edits the universe
         SHUT_DOWN_SERVER,       ///< sent by host client to server to kill the server process
         REQUEST_SAVE_PREVIEWS,  ///< sent by client to request previews of available savegames
-        DISPATCH_SAVE_PREVIEWS  ///< sent by host to client to provide the savegame previews
+        DISPATCH_SAVE_PREVIEWS, ///< sent by host to client to provide the savegame previews
+        REQUEST_COMBAT_LOGS,    ///< sent by client to request the contents of combat logs it knows only the ids of
+        DISPATCH_COMBAT_LOGS    ///< sent by server to client to provide the requested combat logs
     )
 
     GG_CLASS_ENUM(TurnProgressPhase,
@@ -129,6 +132,16 @@ public:
             int receiving_player,
             const std::string& text,
             bool synchronous_response = false);
+
+    /** Ctor that shares the first \a size bytes of \a text as the message
+      * body, without copying them.  The buffer must not be modified
+      * afterwards, since copies of the message refer to the same data. */
+    Message(MessageType message_type,
+            int sending_player,
+            int receiving_player,
+            boost::shared_array<char> text,
+            std::size_t size,
+            bool synchronous_response = false);
     //@}
 
     /** \name Accessors */ //@{
@@ -145,6 +158,11 @@ public:
     void        Resize(std::size_t size);   ///< Resizes the underlying char buffer to \a size uninitialized bytes.
     char*       Data();                     ///< Returns the underlying buffer.
     void        Swap(Message& rhs);         ///< Swaps the contents of \a *this with \a rhs.  Does not throw.
+
+    /** Sets the ID of the receiving player.  The body is unaffected, so this
+      * can be used on copies of one message to address it to several
+      * players while they all share the same body. */
+    void        SetReceivingPlayer(int receiving_player);
     //@}
 
 private:
@@ -330,6 +348,13 @@ FO_COMMON_API Message RequestSavePreviewsMessage(int sender, std::string directo
 /** returns the savegame previews to the client */
 FO_COMMON_API Message DispatchSavePreviewsMessage(int receiver, const PreviewInformation& preview);
 
+/** requests the contents of the combat logs with ids \a log_ids from the
+  * server synchronously */
+FO_COMMON_API Message RequestCombatLogsMessage(int sender, const std::vector<int>& log_ids);
+
+/** returns the requested combat logs to the client */
+FO_COMMON_API Message DispatchCombatLogsMessage(int receiver, const std::map<int, CombatLog>& logs);
+
 ////////////////////////////////////////////////
 // Multiplayer Lobby Message named ctors
 ////////////////////////////////////////////////
@@ -408,4 +433,8 @@ FO_COMMON_API void ExtractMessageData(const Message& msg, std::string& directory
 
 FO_COMMON_API void ExtractMessageData(const Message& msg, PreviewInformation& previews);
 
+FO_COMMON_API void ExtractMessageData(const Message& msg, std::vector<int>& log_ids);
+
+FO_COMMON_API void ExtractMessageData(const Message& msg, std::map<int, CombatLog>& logs);
+
 #endif // _Message_h_
@@ -32,15 +32,6 @@ private:
 };
 
 namespace {
-    void WriteMessage(boost::asio::ip::tcp::socket& socket, const Message& message) {
-        int header_buf[5];
-        HeaderToBuffer(message, header_buf);
-        std::vector<boost::asio::const_buffer> buffers;
-        buffers.push_back(boost::asio::buffer(header_buf));
-        buffers.push_back(boost::asio::buffer(message.Data(), message.Size()));
-        boost::asio::write(socket, buffers);
-    }
-
     struct PlayerID {
         PlayerID(int id) : m_id(id) {}
         bool operator()(const PlayerConnectionPtr& player_connection)
@@ -60,6 +51,7 @@ PlayerConnection::PlayerConnection(boost::asio::io_service& io_service,
     m_socket(io_service),
     m_ID(INVALID_PLAYER_ID),
     m_new_connection(true),
+    m_close_when_written(false),
     m_client_type(Networking::INVALID_CLIENT_TYPE),
     m_nonplayer_message_callback(nonplayer_message_callback),
     m_player_message_callback(player_message_callback),
@@ -87,11 +79,38 @@ bool PlayerConnection::IsLocalConnection() const
 void PlayerConnection::Start()
 { AsyncReadMessage(); }
 
+bool PlayerConnection::HasOutgoingMessages() const
+{ return !m_outgoing_messages.empty(); }
+
 void PlayerConnection::SendMessage(const Message& message) {
     /*if (TRACE_EXECUTION)
         DebugLogger() << "ServerNetworking::SendMessage : sending message "
                                << message;*/
-    WriteMessage(m_socket, message);
+    // copies of a Message share its body, so queueing does not copy the data
+    bool write_in_progress = !m_outgoing_messages.empty();
+    m_outgoing_messages.push_back(message);
+    if (!write_in_progress)
+        AsyncWriteMessage();
+}
+
+bool PlayerConnection::WriteMessage(const Message& message) {
+    // a partly written message can only be completed by its pending handler
+    if (!m_outgoing_messages.empty()) {
+        SendMessage(message);
+        return false;
+    }
+
+    HeaderToBuffer(message, m_outgoing_header_buffer.c_array());
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.push_back(boost::asio::buffer(m_outgoing_header_buffer));
+    buffers.push_back(boost::asio::buffer(message.Data(), message.Size()));
+    boost::system::error_code error;
+    boost::asio::write(m_socket, buffers, error);
+    if (error) {
+        ErrorLogger() << "PlayerConnection::WriteMessage(): error \"" << error << "\"";
+        return false;
+    }
+    return true;
 }
 
 void PlayerConnection::EstablishPlayer(int id, const std::string& player_name,
@@ -180,6 +199,7 @@ namespace {
         case Message::MODERATOR_ACTION:     return "Moderator Action";
         case Message::SHUT_DOWN_SERVER:     return "Shut Down Server";
         case Message::REQUEST_SAVE_PREVIEWS:return "Request save previews";
+        case Message::REQUEST_COMBAT_LOGS:  return "Request combat logs";
         default:                            return "Unknown Type";
         };
     }
@@ -269,6 +289,63 @@ void PlayerConnection::AsyncReadMessage() {
                                         boost::asio::placeholders::bytes_transferred));
 }
 
+void PlayerConnection::HandleMessageWrite(boost::system::error_code error,
+                                          std::size_t bytes_transferred)
+{
+    if (error) {
+        // a lost connection is reported by the pending read, so just drop
+        // whatever was still waiting to be written
+        if (error != boost::asio::error::eof &&
+            error != boost::asio::error::connection_reset &&
+            error != boost::asio::error::broken_pipe &&
+            error != boost::asio::error::operation_aborted)
+        {
+            ErrorLogger() << "PlayerConnection::HandleMessageWrite(): error \""
+                                   << error << "\"";
+        }
+        m_outgoing_messages.clear();
+        if (m_close_when_written)
+            Close();
+        return;
+    }
+
+    assert(static_cast<int>(bytes_transferred) == HEADER_SIZE + static_cast<int>(m_outgoing_messages.front().Size()));
+    m_outgoing_messages.pop_front();
+    if (!m_outgoing_messages.empty())
+        AsyncWriteMessage();
+    else if (m_close_when_written)
+        Close();
+}
+
+void PlayerConnection::AsyncWriteMessage() {
+    const Message& message = m_outgoing_messages.front();
+    HeaderToBuffer(message, m_outgoing_header_buffer.c_array());
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.push_back(boost::asio::buffer(m_outgoing_header_buffer));
+    buffers.push_back(boost::asio::buffer(message.Data(), message.Size()));
+    // the handler holds a reference to this connection, which keeps the
+    // queued message buffers alive even if the connection is dropped meanwhile
+    boost::asio::async_write(m_socket, buffers,
+                             boost::bind(&PlayerConnection::HandleMessageWrite, shared_from_this(),
+                                         boost::asio::placeholders::error,
+                                         boost::asio::placeholders::bytes_transferred));
+}
+
+void PlayerConnection::CloseWhenWritten() {
+    // a pending write holds a reference to this connection, so it stays alive
+    // to close the socket after the last queued message has been written
+    if (m_outgoing_messages.empty())
+        Close();
+    else
+        m_close_when_written = true;
+}
+
+void PlayerConnection::Close() {
+    boost::system::error_code error;
+    m_socket.shutdown(tcp::socket::shutdown_both, error);
+    m_socket.close(error);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // DiscoveryServer
 ////////////////////////////////////////////////////////////////////////////////
@@ -378,6 +455,16 @@ bool ServerNetworking::ModeratorsInGame() const {
     return false;
 }
 
+void ServerNetworking::SendMessageAll(const Message& message) {
+    for (ServerNetworking::const_established_iterator player_it = established_begin();
+         player_it != established_end(); ++player_it)
+    {
+        Message player_message(message);
+        player_message.SetReceivingPlayer((*player_it)->PlayerID());
+        (*player_it)->SendMessage(player_message);
+    }
+}
+
 void ServerNetworking::SendMessage(const Message& message,
                                    PlayerConnectionPtr player_connection)
 {
@@ -425,6 +512,7 @@ void ServerNetworking::Disconnect(int id) {
 void ServerNetworking::Disconnect(PlayerConnectionPtr player_connection)
 {
     DebugLogger() << "ServerNetworking::Disconnect";
+    player_connection->CloseWhenWritten();
     DisconnectImpl(player_connection);
 }
 
@@ -433,6 +521,7 @@ void ServerNetworking::DisconnectAll() {
     for (const_iterator it = m_player_connections.begin();
          it != m_player_connections.end(); ) {
         PlayerConnectionPtr player_connection = *it++;
+        player_connection->CloseWhenWritten();
         DisconnectImpl(player_connection);
     }
 }
@@ -11,6 +11,7 @@
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/signals2/signal.hpp>
 
+#include <deque>
 #include <queue>
 #include <set>
 
@@ -97,13 +98,22 @@ public:
     /** Sends message \a message to the player indicated in the message. */
     void SendMessage(const Message& message);
 
+    /** Sends message \a message to every established player, each copy
+        addressed to its recipient.  All copies share the body of \a message,
+        so a payload that is the same for all players is serialized once and
+        not copied per recipient. */
+    void SendMessageAll(const Message& message);
+
     /** Disconnects the server from player \a id. */
     void Disconnect(int id);
 
-    /** Disconnects the server from the client represented by \a player_connection. */
+    /** Disconnects the server from the client represented by \a
+        player_connection.  Messages already sent to the client are still
+        written before its socket is closed. */
     void Disconnect(PlayerConnectionPtr player_connection);
 
-    /** Disconnects the server from all clients. */
+    /** Disconnects the server from all clients, after writing the messages
+        already sent to them. */
     void DisconnectAll();
 
     /** Returns an iterator to the first PlayerConnection object. */
@@ -187,15 +197,27 @@ public:
     /** Checks if client associated with this connection runs on the same
         physical machine as the server */
     bool IsLocalConnection() const;
+
+    /** Returns true iff messages passed to SendMessage() are still waiting
+        to be written to the socket. */
+    bool HasOutgoingMessages() const;
     //@}
 
     /** \name Mutators */ //@{
     /** Starts the connection reading incoming messages on its socket. */
     void Start();
 
-    /** Sends \a message to out on the connection. */
+    /** Queues \a message to be sent out on the connection.  Messages are
+        written asynchronously, in the order they were sent, as the socket
+        accepts them; this function does not block. */
     void SendMessage(const Message& message);
 
+    /** Writes \a message to the socket before returning, so that it is sent
+        even if the server stops handling network events afterwards.  If
+        another message is still being written, \a message is queued like
+        SendMessage() does instead, and false is returned. */
+    bool WriteMessage(const Message& message);
+
     /** Establishes a connection as a player with a specific name and id.
         This function must only be called once. */
     void EstablishPlayer(int id, const std::string& player_name, Networking::ClientType client_type);
@@ -225,13 +247,21 @@ private:
     void HandleMessageHeaderRead(boost::system::error_code error,
                                  std::size_t bytes_transferred);
     void AsyncReadMessage();
+    void HandleMessageWrite(boost::system::error_code error,
+                            std::size_t bytes_transferred);
+    void AsyncWriteMessage();
+    void CloseWhenWritten();
+    void Close();
 
     boost::asio::ip::tcp::socket    m_socket;
     MessageHeaderBuffer             m_incoming_header_buffer;
     Message                         m_incoming_message;
+    MessageHeaderBuffer             m_outgoing_header_buffer;
+    std::deque<Message>             m_outgoing_messages;    ///< messages waiting to be written; the front one is being written
     int                             m_ID;
     std::string                     m_player_name;
     bool                            m_new_connection;
+    bool                            m_close_when_written;   ///< close the socket once m_outgoing_messages is empty
     Networking::ClientType          m_client_type;
 
     MessageAndConnectionFn m_nonplayer_message_callback;
@@ -0,0 +1,100 @@
+#include <boost/test/unit_test.hpp>
+
+#include "universe/ObjectMap.h"
+#include "universe/Ship.h"
+#include "universe/ShipDesign.h"
+#include "universe/Species.h"
+#include "universe/Universe.h"
+#include "util/AppInterface.h"
+#include "util/MultiplayerCommon.h"
+#include "util/OptionsDB.h"
+
+#include <stdexcept>
+
+namespace {
+    /** Provides the universe that ships look their designs up in. */
+    class TestApp : public IApp {
+    public:
+        TestApp() :
+            m_next_id(0)
+        {}
+
+        virtual Universe& GetUniverse()
+        { return m_universe; }
+
+        virtual EmpireManager& Empires()
+        { throw std::logic_error("TestApp has no empires"); }
+
+        virtual Empire* GetEmpire(int id)
+        { return 0; }
+
+        virtual TemporaryPtr<UniverseObject> GetUniverseObject(int object_id)
+        { return m_universe.Objects().Object(object_id); }
+
+        virtual ObjectMap& EmpireKnownObjects(int empire_id)
+        { return m_universe.Objects(); }
+
+        virtual TemporaryPtr<UniverseObject> EmpireKnownObject(int object_id, int empire_id)
+        { return GetUniverseObject(object_id); }
+
+        virtual std::string GetVisibleObjectName(TemporaryPtr<const UniverseObject> object)
+        { return object ? object->Name() : ""; }
+
+        virtual int GetNewObjectID()
+        { return ++m_next_id; }
+
+        virtual int GetNewDesignID()
+        { return ++m_next_id; }
+
+        virtual int CurrentTurn() const
+        { return 1; }
+
+        virtual const GalaxySetupData& GetGalaxySetupData() const
+        { return m_galaxy_setup_data; }
+
+    private:
+        Universe        m_universe;
+        GalaxySetupData m_galaxy_setup_data;
+        int             m_next_id;
+    };
+}
+
+struct ObjectMapIndexesFixture {
+    ObjectMapIndexesFixture()
+    { GetOptionsDB().Set<std::string>("resource-dir", FREEORION_TEST_RESOURCE_DIR); }
+
+    TestApp app;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ObjectMapIndexes, ObjectMapIndexesFixture)
+
+BOOST_AUTO_TEST_CASE(ShipIndexedBySpeciesTag) {
+    // the tag must come only from the species for this test to mean anything
+    const Species* species = GetSpecies("SP_HUMAN");
+    BOOST_REQUIRE(species);
+    BOOST_REQUIRE(species->Tags().count("ORGANIC"));
+    const HullType* hull = GetHullType("SH_BASIC_MEDIUM");
+    BOOST_REQUIRE(hull);
+    BOOST_REQUIRE(!hull->Tags().count("ORGANIC"));
+
+    Universe& universe = app.GetUniverse();
+    int design_id = universe.InsertShipDesign(
+        new ShipDesign("TEST_DESIGN", "", 1, ALL_EMPIRES, "SH_BASIC_MEDIUM",
+                       std::vector<std::string>(), "", ""));
+    TemporaryPtr<Ship> ship = universe.CreateShip(ALL_EMPIRES, design_id, "SP_HUMAN");
+    BOOST_REQUIRE(ship);
+    BOOST_CHECK(ship->HasTag("ORGANIC"));
+    BOOST_CHECK(ship->Tags().count("ORGANIC"));
+
+    ObjectMap& objects = universe.Objects();
+    objects.BuildIndexes();
+    const std::vector<TemporaryPtr<const UniverseObject> >* tagged = objects.IndexedObjectsWithTag("ORGANIC");
+    BOOST_REQUIRE(tagged);
+    bool found = false;
+    for (std::vector<TemporaryPtr<const UniverseObject> >::const_iterator it = tagged->begin(); it != tagged->end(); ++it)
+        found = found || (*it)->ID() == ship->ID();
+    BOOST_CHECK(found);
+    objects.ClearIndexes();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -11,6 +11,9 @@
 #include "../universe/Field.h"
 #include "../universe/Special.h"
 #include "../universe/Species.h"
+#include "../Empire/Empire.h"
+#include "../Empire/EmpireManager.h"
+#include "../util/AppInterface.h"
 #include "../util/Logger.h"
 #include "../util/MultiplayerCommon.h"
 
@@ -70,6 +73,10 @@ namespace {
         for (int i = 0; i < numObjects; i++)
             objvec.push_back(boost::python::extract<int>(objList[i]));
         GetUniverse().UpdateMeterEstimates(objvec);
+
+        // changed meters may change where empires can produce items
+        for (EmpireManager::iterator it = Empires().begin(); it != Empires().end(); ++it)
+            it->second->ClearProductionLocationCache();
     }
 
     //void                    (Universe::*UpdateMeterEstimatesVoidFunc)(void) =                   &Universe::UpdateMeterEstimates;
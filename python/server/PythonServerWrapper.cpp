@@ -1183,7 +1183,7 @@ void WrapServerAPI() {
         .def("spawn_limit",     &MonsterFleetPlanWrapper::SpawnLimit)
         .def("location",        &MonsterFleetPlanWrapper::Location);
 
-    def("user_string",                          make_function(&UserString,      return_value_policy<copy_const_reference>()));
+    def("user_string",                          make_function(static_cast<const std::string& (*)(const std::string&)>(&UserString), return_value_policy<copy_const_reference>()));
     def("roman_number",                         RomanNumber);
     def("get_resource_dir",                     GetResourceDirWrapper);
 
@@ -18,6 +18,7 @@
 #include "../util/Order.h"
 #include "../util/OrderSet.h"
 #include "../util/SaveGamePreviewUtils.h"
+#include "../util/SaveGameSections.h"
 #include "../util/Serialize.h"
 #include "../combat/CombatLogManager.h"
 
@@ -31,6 +32,10 @@
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
 
 #include <fstream>
 
@@ -38,6 +43,11 @@
 namespace fs = boost::filesystem;
 
 namespace {
+    void AddOptions(OptionsDB& db) {
+        db.Add("save-game-compression", UserStringNop("OPTIONS_DB_SAVE_GAME_COMPRESSION"), true);
+    }
+    bool temp_bool = RegisterOptions(&AddOptions);
+
     std::map<int, SaveGameEmpireData> CompileSaveGameEmpireData(const EmpireManager& empire_manager) {
         std::map<int, SaveGameEmpireData> retval;
         const EmpireManager& empires = Empires();
@@ -92,22 +102,13 @@ namespace {
     }
 
     const std::string UNABLE_TO_OPEN_FILE("Unable to open file");
-}
 
-void SaveGame(const std::string& filename, const ServerSaveGameData& server_save_game_data,
-              const std::vector<PlayerSaveGameData>& player_save_game_data,
-              const Universe& universe, const EmpireManager& empire_manager,
-              const SpeciesManager& species_manager, const CombatLogManager& combat_log_manager,
-              const GalaxySetupData& galaxy_setup_data, bool multiplayer)
-{
-    DebugLogger() << "SaveGame:: filename: " << filename;
-    GetUniverse().EncodingEmpire() = ALL_EMPIRES;
+    // name of the subdirectory of the save directory into which clients
+    // write autosaves
+    const fs::path AUTOSAVE_DIR_NAME("auto");
 
-    std::map<int, SaveGameEmpireData> empire_save_game_data = CompileSaveGameEmpireData(empire_manager);
-    SaveGamePreviewData save_preview_data;
-    CompileSaveGamePreviewData(server_save_game_data, player_save_game_data, empire_save_game_data, save_preview_data);
-
-    try {
+    /** Returns the path to which save file \a filename should be written. */
+    fs::path SaveGamePath(const std::string& filename, bool multiplayer) {
         fs::path path = FilenameToPath(filename);
         // A relative path should be relative to the save directory.
         if (path.is_relative()) {
@@ -121,127 +122,486 @@ void SaveGame(const std::string& filename, const ServerSaveGameData& server_save
                 path = GetSaveDir() / path.filename();
             }
         }
+        return path;
+    }
+
+    /** Passes each section of a save file, in order, to \a sink. */
+    template <class SectionSink>
+    void WriteSaveGameSections(SectionSink& sink,
+                               const SaveGamePreviewData& save_preview_data,
+                               const GalaxySetupData& galaxy_setup_data,
+                               const ServerSaveGameData& server_save_game_data,
+                               const std::map<int, SaveGameEmpireData>& empire_save_game_data,
+                               const std::vector<PlayerSaveGameData>& player_save_game_data,
+                               const EmpireManager& empire_manager,
+                               const SpeciesManager& species_manager,
+                               const CombatLogManager& combat_log_manager,
+                               const Universe& universe)
+    {
+        bool use_compression = GetOptionsDB().Get<bool>("save-game-compression");
+
+        // The preview, galaxy setup and empire summary sections are read
+        // when browsing saves and setting up a multiplayer lobby, and are
+        // small, so they are left uncompressed.
+        sink.Section("save_preview_data",       save_preview_data,      false);
+        sink.Section("galaxy_setup_data",       galaxy_setup_data,      false);
+        sink.Section("server_save_game_data",   server_save_game_data,  false);
+        sink.Section("empire_save_game_data",   empire_save_game_data,  false);
+        sink.Section("player_save_game_data",   player_save_game_data,  use_compression);
+        sink.Section("empire_manager",          empire_manager,         use_compression);
+        sink.Section("species_manager",         species_manager,        use_compression);
+        sink.Section("combat_log_manager",      combat_log_manager,     use_compression);
+        sink.UniverseSection(universe, use_compression);
+    }
+
+    /** Serializes save file sections directly to a file. */
+    class FileSectionSink {
+    public:
+        FileSectionSink(SaveGameSectionWriter& writer, bool binary) :
+            m_writer(writer),
+            m_binary(binary)
+        {}
+
+        template <class T>
+        void Section(const std::string& name, const T& data, bool compressed)
+        { WriteSaveGameSection(m_writer, name, data, m_binary, compressed); }
+
+        void UniverseSection(const Universe& universe, bool compressed) {
+            std::ostream& os = m_writer.BeginSection("universe", m_binary, compressed);
+            if (m_binary) {
+                freeorion_bin_oarchive oa(os);
+                Serialize(oa, universe);
+            } else {
+                freeorion_xml_oarchive oa(os);
+                Serialize(oa, universe);
+            }
+            m_writer.EndSection();
+        }
+
+    private:
+        SaveGameSectionWriter&  m_writer;
+        bool                    m_binary;
+    };
+
+    /** A save file section that has been serialized but not yet written. */
+    struct SerializedSection {
+        std::string name;
+        bool        binary;
+        bool        compressed;
+        std::size_t offset;     ///< position of the section's archive in SerializedSaveGame::data
+        std::size_t size;
+    };
+
+    /** A save file that has been serialized but not yet written.  The
+      * sections' uncompressed archives are stored one after another in a
+      * single buffer. */
+    struct SerializedSaveGame {
+        std::string                     data;
+        std::vector<SerializedSection>  sections;
+    };
+
+    typedef boost::iostreams::stream<boost::iostreams::back_insert_device<std::string> > StringAppendStream;
+
+    /** Serializes save file sections into memory, so that they can be
+      * written later without referring to the gamestate they were taken
+      * from.  Archives are appended directly to the save's buffer, without
+      * intermediate copies. */
+    class MemorySectionSink {
+    public:
+        MemorySectionSink(SerializedSaveGame& save, bool binary) :
+            m_save(save),
+            m_binary(binary)
+        {}
+
+        template <class T>
+        void Section(const std::string& name, const T& data, bool compressed) {
+            std::size_t offset = m_save.data.size();
+            StringAppendStream os(m_save.data);
+            if (m_binary) {
+                freeorion_bin_oarchive oa(os);
+                oa << boost::serialization::make_nvp(name.c_str(), data);
+            } else {
+                freeorion_xml_oarchive oa(os);
+                oa << boost::serialization::make_nvp(name.c_str(), data);
+            }
+            os.flush();
+            Add(name, compressed, offset);
+        }
+
+        void UniverseSection(const Universe& universe, bool compressed) {
+            std::size_t offset = m_save.data.size();
+            StringAppendStream os(m_save.data);
+            if (m_binary) {
+                freeorion_bin_oarchive oa(os);
+                Serialize(oa, universe);
+            } else {
+                freeorion_xml_oarchive oa(os);
+                Serialize(oa, universe);
+            }
+            os.flush();
+            Add("universe", compressed, offset);
+        }
+
+    private:
+        void Add(const std::string& name, bool compressed, std::size_t offset) {
+            m_save.sections.push_back(SerializedSection());
+            SerializedSection& section = m_save.sections.back();
+            section.name = name;
+            section.binary = m_binary;
+            section.compressed = compressed;
+            section.offset = offset;
+            section.size = m_save.data.size() - offset;
+        }
+
+        SerializedSaveGame& m_save;
+        bool                m_binary;
+    };
+
+    /** Writes a previously serialized save to a file at \a path, compressing
+      * those sections that are to be compressed.  Run on the background save
+      * thread. */
+    struct WriteSerializedSaveGame {
+        WriteSerializedSaveGame(const fs::path& path,
+                                boost::shared_ptr<const SerializedSaveGame> save,
+                                const boost::function<void (bool)>& finished) :
+            m_path(path),
+            m_save(save),
+            m_finished(finished)
+        {}
+
+        void operator()() const {
+            bool success = true;
+            try {
+                fs::ofstream ofs(m_path, std::ios_base::binary);
+                if (!ofs)
+                    throw std::runtime_error(UNABLE_TO_OPEN_FILE);
+
+                SaveGameSectionWriter writer(ofs);
+                for (std::vector<SerializedSection>::const_iterator it = m_save->sections.begin();
+                     it != m_save->sections.end(); ++it)
+                {
+                    std::ostream& os = writer.BeginSection(it->name, it->binary, it->compressed);
+                    os.write(m_save->data.data() + it->offset, it->size);
+                    writer.EndSection();
+                }
+                writer.Finish();
+                DebugLogger() << "SaveGameInBackground : finished writing " << m_path;
+            } catch (const std::exception& e) {
+                // stringtables are not safe to use from this thread, so the
+                // message is not translated
+                ErrorLogger() << "SaveGameInBackground : unable to write save file " << m_path << ": " << e.what();
+                success = false;
+            }
+            if (m_finished)
+                m_finished(success);
+        }
+
+        fs::path                                    m_path;
+        boost::shared_ptr<const SerializedSaveGame> m_save;
+        boost::function<void (bool)>                m_finished;
+    };
+
+    // size of the previous background save's serialized data, used to
+    // reserve space for the next one so that its buffer is not repeatedly
+    // reallocated and copied as it grows
+    std::size_t previous_background_save_size = 0;
+
+    // the thread writing the save started by the latest SaveGameInBackground()
+    boost::thread background_save_thread;
+}
+
+void SaveGame(const std::string& filename, const ServerSaveGameData& server_save_game_data,
+              const std::vector<PlayerSaveGameData>& player_save_game_data,
+              const Universe& universe, const EmpireManager& empire_manager,
+              const SpeciesManager& species_manager, const CombatLogManager& combat_log_manager,
+              const GalaxySetupData& galaxy_setup_data, bool multiplayer)
+{
+    DebugLogger() << "SaveGame:: filename: " << filename;
+    ScopedEncodingEmpire encoding_empire(ALL_EMPIRES);
 
+    std::map<int, SaveGameEmpireData> empire_save_game_data = CompileSaveGameEmpireData(empire_manager);
+    SaveGamePreviewData save_preview_data;
+    CompileSaveGamePreviewData(server_save_game_data, player_save_game_data, empire_save_game_data, save_preview_data);
+
+    // don't write to a file that a background save may also be writing
+    WaitForBackgroundSave();
+
+    try {
+        fs::path path = SaveGamePath(filename, multiplayer);
         fs::ofstream ofs(path, std::ios_base::binary);
 
         if (!ofs)
             throw std::runtime_error(UNABLE_TO_OPEN_FILE);
 
-        if (GetOptionsDB().Get<bool>("binary-serialization")) {
-            freeorion_bin_oarchive oa(ofs);
-            oa << BOOST_SERIALIZATION_NVP(save_preview_data);
-            oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
-            oa << BOOST_SERIALIZATION_NVP(server_save_game_data);
-            oa << BOOST_SERIALIZATION_NVP(player_save_game_data);
-            oa << BOOST_SERIALIZATION_NVP(empire_save_game_data);
-            oa << BOOST_SERIALIZATION_NVP(empire_manager);
-            oa << BOOST_SERIALIZATION_NVP(species_manager);
-            oa << BOOST_SERIALIZATION_NVP(combat_log_manager);
-            Serialize(oa, universe);
-        } else {
-            freeorion_xml_oarchive oa(ofs);
-            oa << BOOST_SERIALIZATION_NVP(save_preview_data);
-            oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
-            oa << BOOST_SERIALIZATION_NVP(server_save_game_data);
-            oa << BOOST_SERIALIZATION_NVP(player_save_game_data);
-            oa << BOOST_SERIALIZATION_NVP(empire_save_game_data);
-            oa << BOOST_SERIALIZATION_NVP(empire_manager);
-            oa << BOOST_SERIALIZATION_NVP(species_manager);
-            oa << BOOST_SERIALIZATION_NVP(combat_log_manager);
-            Serialize(oa, universe);
-        }
+        SaveGameSectionWriter writer(ofs);
+        FileSectionSink sink(writer, GetOptionsDB().Get<bool>("binary-serialization"));
+        WriteSaveGameSections(sink, save_preview_data, galaxy_setup_data, server_save_game_data,
+                              empire_save_game_data, player_save_game_data, empire_manager,
+                              species_manager, combat_log_manager, universe);
+        writer.Finish();
     } catch (const std::exception& e) {
         ErrorLogger() << UserString("UNABLE_TO_WRITE_SAVE_FILE") << " SaveGame exception: " << ": " << e.what();
         throw e;
     }
 }
 
-void LoadGame(const std::string& filename, ServerSaveGameData& server_save_game_data,
-              std::vector<PlayerSaveGameData>& player_save_game_data,
-              Universe& universe, EmpireManager& empire_manager,
-              SpeciesManager& species_manager, CombatLogManager& combat_log_manager,
-              GalaxySetupData& galaxy_setup_data, bool alternate_serialization)
+void SaveGameInBackground(const std::string& filename, const ServerSaveGameData& server_save_game_data,
+                          const std::vector<PlayerSaveGameData>& player_save_game_data,
+                          const Universe& universe, const EmpireManager& empire_manager,
+                          const SpeciesManager& species_manager, const CombatLogManager& combat_log_manager,
+                          const GalaxySetupData& galaxy_setup_data, bool multiplayer,
+                          const boost::function<void (bool)>& finished)
 {
-    //boost::this_thread::sleep(boost::posix_time::seconds(5));
-    bool use_binary = GetOptionsDB().Get<bool>("binary-serialization") ^ alternate_serialization;
+    DebugLogger() << "SaveGameInBackground:: filename: " << filename;
 
-    // player notifications
-    if (ServerApp* server = ServerApp::GetApp())
-        server->Networking().SendMessage(TurnProgressMessage(Message::LOADING_GAME));
+    // only one save is written at a time.  waiting before taking the
+    // snapshot also ensures that only one snapshot is held in memory.
+    WaitForBackgroundSave();
 
-    GetUniverse().EncodingEmpire() = ALL_EMPIRES;
+    ScopedEncodingEmpire encoding_empire(ALL_EMPIRES);
 
-    std::map<int, SaveGameEmpireData> ignored_save_game_empire_data;
-    SaveGamePreviewData ignored_save_preview_data;
-
-    empire_manager.Clear();
-    universe.Clear();
+    std::map<int, SaveGameEmpireData> empire_save_game_data = CompileSaveGameEmpireData(empire_manager);
+    SaveGamePreviewData save_preview_data;
+    CompileSaveGamePreviewData(server_save_game_data, player_save_game_data, empire_save_game_data, save_preview_data);
 
+    // snapshot the gamestate by serializing it, uncompressed, into memory
+    boost::shared_ptr<SerializedSaveGame> save(new SerializedSaveGame());
+    fs::path path;
     try {
-        const fs::path path = FilenameToPath(filename);
-        fs::ifstream ifs(path, std::ios_base::binary);
+        path = SaveGamePath(filename, multiplayer);
+        save->data.reserve(previous_background_save_size);
+        MemorySectionSink sink(*save, GetOptionsDB().Get<bool>("binary-serialization"));
+        WriteSaveGameSections(sink, save_preview_data, galaxy_setup_data, server_save_game_data,
+                              empire_save_game_data, player_save_game_data, empire_manager,
+                              species_manager, combat_log_manager, universe);
+    } catch (const std::exception& e) {
+        ErrorLogger() << UserString("UNABLE_TO_WRITE_SAVE_FILE") << " SaveGameInBackground exception: " << ": " << e.what();
+        throw;
+    }
+    previous_background_save_size = save->data.size();
 
-        if (!ifs)
-            throw std::runtime_error(UNABLE_TO_OPEN_FILE);
-        if (use_binary) {
-            freeorion_bin_iarchive ia ( ifs );
-            //freeorion_iarchive ia(ifs);
-            DebugLogger() << "LoadGame : Passing Preview Data";
-            ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
-
-            DebugLogger() << "LoadGame : Reading Galaxy Setup Data";
-            ia >> BOOST_SERIALIZATION_NVP(galaxy_setup_data);
-
-            DebugLogger() << "LoadGame : Reading Server Save Game Data";
-            ia >> BOOST_SERIALIZATION_NVP(server_save_game_data);
-            DebugLogger() << "LoadGame : Reading Player Save Game Data";
-            ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
-
-            DebugLogger() << "LoadGame : Reading Empire Save Game Data (Ignored)";
-            ia >> BOOST_SERIALIZATION_NVP(ignored_save_game_empire_data);
-            DebugLogger() << "LoadGame : Reading Empires Data";
-            ia >> BOOST_SERIALIZATION_NVP(empire_manager);
-            DebugLogger() << "LoadGame : Reading Species Data";
-            ia >> BOOST_SERIALIZATION_NVP(species_manager);
-            DebugLogger() << "LoadGame : Reading Combat Logs";
-            ia >> BOOST_SERIALIZATION_NVP(combat_log_manager);
-            DebugLogger() << "LoadGame : Reading Universe Data";
-            Deserialize(ia, universe);
-        } else {
-            freeorion_xml_iarchive ia ( ifs );
-            DebugLogger() << "LoadGame : Passing Preview Data";
-            ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
-
-            DebugLogger() << "LoadGame : Reading Galaxy Setup Data";
-            ia >> BOOST_SERIALIZATION_NVP(galaxy_setup_data);
-
-            DebugLogger() << "LoadGame : Reading Server Save Game Data";
-            ia >> BOOST_SERIALIZATION_NVP(server_save_game_data);
-            DebugLogger() << "LoadGame : Reading Player Save Game Data";
-            ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
-
-            DebugLogger() << "LoadGame : Reading Empire Save Game Data (Ignored)";
-            ia >> BOOST_SERIALIZATION_NVP(ignored_save_game_empire_data);
-            DebugLogger() << "LoadGame : Reading Empires Data";
-            ia >> BOOST_SERIALIZATION_NVP(empire_manager);
-            DebugLogger() << "LoadGame : Reading Species Data";
-            ia >> BOOST_SERIALIZATION_NVP(species_manager);
-            DebugLogger() << "LoadGame : Reading Combat Logs";
-            ia >> BOOST_SERIALIZATION_NVP(combat_log_manager);
-            DebugLogger() << "LoadGame : Reading Universe Data";
-            Deserialize(ia, universe);
+    background_save_thread = boost::thread(WriteSerializedSaveGame(path, save, finished));
+}
+
+bool IsAutosaveFilename(const std::string& filename)
+{ return FilenameToPath(filename).parent_path().filename() == AUTOSAVE_DIR_NAME; }
+
+void WaitForBackgroundSave() {
+    if (!background_save_thread.joinable())
+        return;
+    DebugLogger() << "WaitForBackgroundSave : waiting for save to finish being written";
+    background_save_thread.join();
+}
+
+namespace {
+    // Loaders for save files written before the sectioned format, which
+    // consist of a single archive that has to be read from the start, and
+    // whose serialization format has to be guessed.
+    void LegacyLoadGame(const std::string& filename, ServerSaveGameData& server_save_game_data,
+                        std::vector<PlayerSaveGameData>& player_save_game_data,
+                        Universe& universe, EmpireManager& empire_manager,
+                        SpeciesManager& species_manager, CombatLogManager& combat_log_manager,
+                        GalaxySetupData& galaxy_setup_data, bool alternate_serialization)
+    {
+        //boost::this_thread::sleep(boost::posix_time::seconds(5));
+        bool use_binary = GetOptionsDB().Get<bool>("binary-serialization") ^ alternate_serialization;
+
+        // player notifications
+        if (ServerApp* server = ServerApp::GetApp())
+            server->Networking().SendMessage(TurnProgressMessage(Message::LOADING_GAME));
+
+        ScopedEncodingEmpire encoding_empire(ALL_EMPIRES);
+
+        std::map<int, SaveGameEmpireData> ignored_save_game_empire_data;
+        SaveGamePreviewData ignored_save_preview_data;
+
+        empire_manager.Clear();
+        universe.Clear();
+
+        try {
+            const fs::path path = FilenameToPath(filename);
+            fs::ifstream ifs(path, std::ios_base::binary);
+
+            if (!ifs)
+                throw std::runtime_error(UNABLE_TO_OPEN_FILE);
+            if (use_binary) {
+                freeorion_bin_iarchive ia ( ifs );
+                //freeorion_iarchive ia(ifs);
+                DebugLogger() << "LoadGame : Passing Preview Data";
+                ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
+
+                DebugLogger() << "LoadGame : Reading Galaxy Setup Data";
+                ia >> BOOST_SERIALIZATION_NVP(galaxy_setup_data);
+
+                DebugLogger() << "LoadGame : Reading Server Save Game Data";
+                ia >> BOOST_SERIALIZATION_NVP(server_save_game_data);
+                DebugLogger() << "LoadGame : Reading Player Save Game Data";
+                ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
+
+                DebugLogger() << "LoadGame : Reading Empire Save Game Data (Ignored)";
+                ia >> BOOST_SERIALIZATION_NVP(ignored_save_game_empire_data);
+                DebugLogger() << "LoadGame : Reading Empires Data";
+                ia >> BOOST_SERIALIZATION_NVP(empire_manager);
+                DebugLogger() << "LoadGame : Reading Species Data";
+                ia >> BOOST_SERIALIZATION_NVP(species_manager);
+                DebugLogger() << "LoadGame : Reading Combat Logs";
+                ia >> BOOST_SERIALIZATION_NVP(combat_log_manager);
+                DebugLogger() << "LoadGame : Reading Universe Data";
+                Deserialize(ia, universe);
+            } else {
+                freeorion_xml_iarchive ia ( ifs );
+                DebugLogger() << "LoadGame : Passing Preview Data";
+                ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
+
+                DebugLogger() << "LoadGame : Reading Galaxy Setup Data";
+                ia >> BOOST_SERIALIZATION_NVP(galaxy_setup_data);
+
+                DebugLogger() << "LoadGame : Reading Server Save Game Data";
+                ia >> BOOST_SERIALIZATION_NVP(server_save_game_data);
+                DebugLogger() << "LoadGame : Reading Player Save Game Data";
+                ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
+
+                DebugLogger() << "LoadGame : Reading Empire Save Game Data (Ignored)";
+                ia >> BOOST_SERIALIZATION_NVP(ignored_save_game_empire_data);
+                DebugLogger() << "LoadGame : Reading Empires Data";
+                ia >> BOOST_SERIALIZATION_NVP(empire_manager);
+                DebugLogger() << "LoadGame : Reading Species Data";
+                ia >> BOOST_SERIALIZATION_NVP(species_manager);
+                DebugLogger() << "LoadGame : Reading Combat Logs";
+                ia >> BOOST_SERIALIZATION_NVP(combat_log_manager);
+                DebugLogger() << "LoadGame : Reading Universe Data";
+                Deserialize(ia, universe);
+            }
+        } catch (const std::exception& e) {
+            if (alternate_serialization) {
+                ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadGame exception: " << ": " << e.what();
+                throw e;
+            } else {
+                LegacyLoadGame(filename, server_save_game_data, player_save_game_data, universe, empire_manager,
+                               species_manager, combat_log_manager, galaxy_setup_data, true);
+                DebugLogger() << "LoadGame: alternate serialization used to load game file " << filename;
+            }
         }
-    } catch (const std::exception& e) {
-        if (alternate_serialization) {
-            ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadGame exception: " << ": " << e.what();
-            throw e;
-        } else {
-            LoadGame(filename, server_save_game_data, player_save_game_data, universe, empire_manager,
-                    species_manager, combat_log_manager, galaxy_setup_data, true);
-            DebugLogger() << "LoadGame: alternate serialization used to load game file " << filename;
+        DebugLogger() << "LoadGame : Done loading save file";
+    }
+
+
+
+    void LegacyLoadGalaxySetupData(const std::string& filename, GalaxySetupData& galaxy_setup_data, bool alternate_serialization) {
+
+        SaveGamePreviewData ignored_save_preview_data;
+
+        try {
+            fs::path path = FilenameToPath(filename);
+            fs::ifstream ifs(path, std::ios_base::binary);
+
+            if (!ifs)
+                throw std::runtime_error(UNABLE_TO_OPEN_FILE);
+            bool use_binary = GetOptionsDB().Get<bool>("binary-serialization") ^ alternate_serialization;
+            if (use_binary) {
+                freeorion_bin_iarchive ia ( ifs );
+                //freeorion_iarchive ia(ifs);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
+                ia >> BOOST_SERIALIZATION_NVP(galaxy_setup_data);
+            } else {
+                freeorion_xml_iarchive ia ( ifs );
+                ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
+                ia >> BOOST_SERIALIZATION_NVP(galaxy_setup_data);
+            }
+            // skipping additional deserialization which is not needed for this function
+        } catch (const std::exception& e) {
+            if (alternate_serialization) {
+                ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadGalaxySetupData exception: " << ": " << e.what();
+                throw e;
+            } else {
+                DebugLogger() << "LoadGalaxySetupData: trying alternate serialization.";
+                LegacyLoadGalaxySetupData(filename, galaxy_setup_data, true);
+            }
+        }
+    }
+
+
+    void LegacyLoadPlayerSaveGameData(const std::string& filename, std::vector<PlayerSaveGameData>& player_save_game_data, bool alternate_serialization) {
+        SaveGamePreviewData ignored_save_preview_data;
+        ServerSaveGameData  ignored_server_save_game_data;
+        GalaxySetupData     ignored_galaxy_setup_data;
+
+        try {
+            fs::path path = FilenameToPath(filename);
+            fs::ifstream ifs(path, std::ios_base::binary);
+
+            if (!ifs)
+                throw std::runtime_error(UNABLE_TO_OPEN_FILE);
+            bool use_binary = GetOptionsDB().Get<bool>("binary-serialization") ^ alternate_serialization;
+            if (use_binary) {
+                freeorion_bin_iarchive ia ( ifs );
+                //freeorion_iarchive ia(ifs);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_galaxy_setup_data);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
+                ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
+            } else {
+                freeorion_xml_iarchive ia ( ifs );
+                ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_galaxy_setup_data);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
+                ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
+            }
+            // skipping additional deserialization which is not needed for this function
+        } catch (const std::exception& e) {
+            if (alternate_serialization) {
+                ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadPlayerSaveGameData exception: " << ": " << e.what();
+                throw e;
+            } else {
+                DebugLogger() << "LoadPlayerSaveGameData: trying alternate serialization";
+                LegacyLoadPlayerSaveGameData(filename, player_save_game_data, true);
+            }
+        }
+    }
+
+
+
+    void LegacyLoadEmpireSaveGameData(const std::string& filename, std::map<int, SaveGameEmpireData>& empire_save_game_data, bool alternate_serialization) {
+        SaveGamePreviewData             ignored_save_preview_data;
+        ServerSaveGameData              ignored_server_save_game_data;
+        std::vector<PlayerSaveGameData> ignored_player_save_game_data;
+        GalaxySetupData                 ignored_galaxy_setup_data;
+
+        try {
+            fs::path path = FilenameToPath(filename);
+            DebugLogger() << "LoadEmpireSaveGameData: filename: " << filename << " path:" << path;
+            fs::ifstream ifs(path, std::ios_base::binary);
+
+            if (!ifs)
+                throw std::runtime_error(UNABLE_TO_OPEN_FILE);
+            bool use_binary = GetOptionsDB().Get<bool>("binary-serialization") ^ alternate_serialization;
+            if (use_binary) {
+                freeorion_bin_iarchive ia ( ifs );
+                //freeorion_iarchive ia(ifs);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_galaxy_setup_data);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_player_save_game_data);
+                ia >> BOOST_SERIALIZATION_NVP(empire_save_game_data);
+            } else {
+                freeorion_xml_iarchive ia ( ifs );
+                ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_galaxy_setup_data);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
+                ia >> BOOST_SERIALIZATION_NVP(ignored_player_save_game_data);
+                ia >> BOOST_SERIALIZATION_NVP(empire_save_game_data);
+            }
+            // skipping additional deserialization which is not needed for this function
+        } catch (const std::exception& e) {
+            if (alternate_serialization) {
+                ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadEmpireSaveGameData exception: " << ": " << e.what();
+                throw e;
+            } else {
+                DebugLogger() << "LoadEmpireSaveGameData: trying alternate serialization";
+                LegacyLoadEmpireSaveGameData(filename, empire_save_game_data, true);
+            }
         }
     }
-    DebugLogger() << "LoadGame : Done loading save file";
 }
 
 void LoadGame(const std::string& filename, ServerSaveGameData& server_save_game_data,
@@ -249,131 +609,115 @@ void LoadGame(const std::string& filename, ServerSaveGameData& server_save_game_
               Universe& universe, EmpireManager& empire_manager,
               SpeciesManager& species_manager, CombatLogManager& combat_log_manager,
               GalaxySetupData& galaxy_setup_data)
-    {
-        LoadGame(filename, server_save_game_data, player_save_game_data, universe, empire_manager,
-                species_manager, combat_log_manager, galaxy_setup_data, false);
+{
+    WaitForBackgroundSave();
+
+    const fs::path path = FilenameToPath(filename);
+    fs::ifstream ifs(path, std::ios_base::binary);
+    if (!ifs) {
+        ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadGame exception: " << ": " << UNABLE_TO_OPEN_FILE;
+        throw std::runtime_error(UNABLE_TO_OPEN_FILE);
     }
 
+    SaveGameSectionReader reader(ifs);
+    if (!reader.Valid()) {
+        ifs.close();
+        LegacyLoadGame(filename, server_save_game_data, player_save_game_data, universe, empire_manager,
+                       species_manager, combat_log_manager, galaxy_setup_data, false);
+        return;
+    }
 
-void LoadGalaxySetupData(const std::string& filename, GalaxySetupData& galaxy_setup_data, bool alternate_serialization) {
-    
-    SaveGamePreviewData ignored_save_preview_data;
+    // player notifications
+    if (ServerApp* server = ServerApp::GetApp())
+        server->Networking().SendMessage(TurnProgressMessage(Message::LOADING_GAME));
 
-    try {
-        fs::path path = FilenameToPath(filename);
-        fs::ifstream ifs(path, std::ios_base::binary);
+    ScopedEncodingEmpire encoding_empire(ALL_EMPIRES);
 
-        if (!ifs)
-            throw std::runtime_error(UNABLE_TO_OPEN_FILE);
-        bool use_binary = GetOptionsDB().Get<bool>("binary-serialization") ^ alternate_serialization;
-        if (use_binary) {
-            freeorion_bin_iarchive ia ( ifs );
-            //freeorion_iarchive ia(ifs);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
-            ia >> BOOST_SERIALIZATION_NVP(galaxy_setup_data);
+    empire_manager.Clear();
+    universe.Clear();
+
+    try {
+        DebugLogger() << "LoadGame : Reading Galaxy Setup Data";
+        ReadSaveGameSection(reader, "galaxy_setup_data", galaxy_setup_data);
+        DebugLogger() << "LoadGame : Reading Server Save Game Data";
+        ReadSaveGameSection(reader, "server_save_game_data", server_save_game_data);
+        DebugLogger() << "LoadGame : Reading Player Save Game Data";
+        ReadSaveGameSection(reader, "player_save_game_data", player_save_game_data);
+        DebugLogger() << "LoadGame : Reading Empires Data";
+        ReadSaveGameSection(reader, "empire_manager", empire_manager);
+        DebugLogger() << "LoadGame : Reading Species Data";
+        ReadSaveGameSection(reader, "species_manager", species_manager);
+        DebugLogger() << "LoadGame : Reading Combat Logs";
+        ReadSaveGameSection(reader, "combat_log_manager", combat_log_manager);
+
+        DebugLogger() << "LoadGame : Reading Universe Data";
+        std::istream& universe_is = reader.OpenSection("universe");
+        if (reader.Section("universe")->binary) {
+            freeorion_bin_iarchive ia(universe_is);
+            Deserialize(ia, universe);
         } else {
-            freeorion_xml_iarchive ia ( ifs );
-            ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
-            ia >> BOOST_SERIALIZATION_NVP(galaxy_setup_data);
+            freeorion_xml_iarchive ia(universe_is);
+            Deserialize(ia, universe);
         }
-        // skipping additional deserialization which is not needed for this function
     } catch (const std::exception& e) {
-        if (alternate_serialization) {
-            ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadGalaxySetupData exception: " << ": " << e.what();
-            throw e;
-        } else {
-            DebugLogger() << "LoadGalaxySetupData: trying alternate serialization.";
-            LoadGalaxySetupData(filename, galaxy_setup_data, true);
-        }
+        ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadGame exception: " << ": " << e.what();
+        throw;
     }
+    DebugLogger() << "LoadGame : Done loading save file";
 }
 
-void LoadGalaxySetupData(const std::string& filename, GalaxySetupData& galaxy_setup_data) 
-    { LoadGalaxySetupData(filename, galaxy_setup_data, false); } 
-
-void LoadPlayerSaveGameData(const std::string& filename, std::vector<PlayerSaveGameData>& player_save_game_data, bool alternate_serialization) {
-    SaveGamePreviewData ignored_save_preview_data;
-    ServerSaveGameData  ignored_server_save_game_data;
-    GalaxySetupData     ignored_galaxy_setup_data;
+namespace {
+    /** Reads section \a section_name of save file \a filename into \a data.
+      * Returns false if the file is not a sectioned save file, in which case
+      * a legacy loader has to be used instead. */
+    template <class T>
+    bool LoadSaveGameSection(const std::string& filename, const std::string& section_name, T& data) {
+        WaitForBackgroundSave();
 
-    try {
-        fs::path path = FilenameToPath(filename);
+        const fs::path path = FilenameToPath(filename);
         fs::ifstream ifs(path, std::ios_base::binary);
-
         if (!ifs)
             throw std::runtime_error(UNABLE_TO_OPEN_FILE);
-        bool use_binary = GetOptionsDB().Get<bool>("binary-serialization") ^ alternate_serialization;
-        if (use_binary) {
-            freeorion_bin_iarchive ia ( ifs );
-            //freeorion_iarchive ia(ifs);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_galaxy_setup_data);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
-            ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
-        } else {
-            freeorion_xml_iarchive ia ( ifs );
-            ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_galaxy_setup_data);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
-            ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
-        }
-        // skipping additional deserialization which is not needed for this function
-    } catch (const std::exception& e) {
-        if (alternate_serialization) {
-            ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadPlayerSaveGameData exception: " << ": " << e.what();
-            throw e;
-        } else {
-            DebugLogger() << "LoadPlayerSaveGameData: trying alternate serialization";
-            LoadPlayerSaveGameData(filename, player_save_game_data, true);
-        }
-    }
-}
-
-void LoadPlayerSaveGameData(const std::string& filename, std::vector<PlayerSaveGameData>& player_save_game_data)
-    { LoadPlayerSaveGameData(filename, player_save_game_data, false); }
 
+        SaveGameSectionReader reader(ifs);
+        if (!reader.Valid())
+            return false;
 
-void LoadEmpireSaveGameData(const std::string& filename, std::map<int, SaveGameEmpireData>& empire_save_game_data, bool alternate_serialization) {
-    SaveGamePreviewData             ignored_save_preview_data;
-    ServerSaveGameData              ignored_server_save_game_data;
-    std::vector<PlayerSaveGameData> ignored_player_save_game_data;
-    GalaxySetupData                 ignored_galaxy_setup_data;
+        ReadSaveGameSection(reader, section_name, data);
+        return true;
+    }
+}
 
+void LoadGalaxySetupData(const std::string& filename, GalaxySetupData& galaxy_setup_data) {
     try {
-        fs::path path = FilenameToPath(filename);
-        DebugLogger() << "LoadEmpireSaveGameData: filename: " << filename << " path:" << path;
-        fs::ifstream ifs(path, std::ios_base::binary);
+        if (LoadSaveGameSection(filename, "galaxy_setup_data", galaxy_setup_data))
+            return;
+    } catch (const std::exception& e) {
+        ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadGalaxySetupData exception: " << ": " << e.what();
+        throw;
+    }
+    LegacyLoadGalaxySetupData(filename, galaxy_setup_data, false);
+}
 
-        if (!ifs)
-            throw std::runtime_error(UNABLE_TO_OPEN_FILE);
-        bool use_binary = GetOptionsDB().Get<bool>("binary-serialization") ^ alternate_serialization;
-        if (use_binary) {
-            freeorion_bin_iarchive ia ( ifs );
-            //freeorion_iarchive ia(ifs);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_galaxy_setup_data);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_player_save_game_data);
-            ia >> BOOST_SERIALIZATION_NVP(empire_save_game_data);
-        } else {
-            freeorion_xml_iarchive ia ( ifs );
-            ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_galaxy_setup_data);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
-            ia >> BOOST_SERIALIZATION_NVP(ignored_player_save_game_data);
-            ia >> BOOST_SERIALIZATION_NVP(empire_save_game_data);
-        }
-        // skipping additional deserialization which is not needed for this function
+void LoadPlayerSaveGameData(const std::string& filename, std::vector<PlayerSaveGameData>& player_save_game_data) {
+    try {
+        if (LoadSaveGameSection(filename, "player_save_game_data", player_save_game_data))
+            return;
     } catch (const std::exception& e) {
-        if (alternate_serialization) {
-            ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadEmpireSaveGameData exception: " << ": " << e.what();
-            throw e;
-        } else {
-            DebugLogger() << "LoadEmpireSaveGameData: trying alternate serialization";
-            LoadEmpireSaveGameData(filename, empire_save_game_data, true);
-        }
+        ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadPlayerSaveGameData exception: " << ": " << e.what();
+        throw;
     }
+    LegacyLoadPlayerSaveGameData(filename, player_save_game_data, false);
 }
 
-void LoadEmpireSaveGameData(const std::string& filename, std::map<int, SaveGameEmpireData>& empire_save_game_data)
-    { LoadEmpireSaveGameData(filename, empire_save_game_data, false); }
+void LoadEmpireSaveGameData(const std::string& filename, std::map<int, SaveGameEmpireData>& empire_save_game_data) {
+    DebugLogger() << "LoadEmpireSaveGameData: filename: " << filename;
+    try {
+        if (LoadSaveGameSection(filename, "empire_save_game_data", empire_save_game_data))
+            return;
+    } catch (const std::exception& e) {
+        ErrorLogger() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadEmpireSaveGameData exception: " << ": " << e.what();
+        throw;
+    }
+    LegacyLoadEmpireSaveGameData(filename, empire_save_game_data, false);
+}
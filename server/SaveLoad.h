@@ -2,6 +2,8 @@
 #ifndef _SaveLoad_h_
 #define _SaveLoad_h_
 
+#include <boost/function.hpp>
+
 #include <vector>
 #include <map>
 #include <string>
@@ -27,6 +29,34 @@ void SaveGame(const std::string& filename,
               bool multiplayer
              );
 
+/** Saves the provided data to savefile \a filename without waiting for the
+  * file to be written.  The data is serialized into memory before returning,
+  * so that the gamestate may change afterwards, and is then compressed and
+  * written to disk on a background thread.  \a finished is called on that
+  * thread with whether the file was written successfully.  Only one save is
+  * written at a time, so this first waits for any earlier background save to
+  * be written.  Should only be called from the server's main thread. */
+void SaveGameInBackground(const std::string& filename,
+                          const ServerSaveGameData& server_save_game_data,
+                          const std::vector<PlayerSaveGameData>& player_save_game_data,
+                          const Universe& universe,
+                          const EmpireManager& empire_manager,
+                          const SpeciesManager& species_manager,
+                          const CombatLogManager& combat_log_manager,
+                          const GalaxySetupData& galaxy_setup_data,
+                          bool multiplayer,
+                          const boost::function<void (bool)>& finished
+                         );
+
+/** Returns true if \a filename is in an autosave directory, to which clients
+  * write their autosaves. */
+bool IsAutosaveFilename(const std::string& filename);
+
+/** Returns once any save started by SaveGameInBackground() has finished being
+  * written.  Saving and loading functions call this themselves before
+  * accessing save files. */
+void WaitForBackgroundSave();
+
 /** Loads the indicated data from savefile \a filename. */
 void LoadGame(const std::string& filename,
               ServerSaveGameData& server_save_game_data,
@@ -28,6 +28,7 @@
 #include "../util/SaveGamePreviewUtils.h"
 #include "../util/SitRepEntry.h"
 #include "../util/ScopedTimer.h"
+#include "../util/RunQueue.h"
 
 #include <GG/SignalsAndSlots.h>
 
@@ -46,6 +47,53 @@ namespace fs = boost::filesystem;
 void Seed(unsigned int seed);
 
 namespace {
+    void AddOptions(OptionsDB& db) {
+        db.Add("turn-update-threads",   UserStringNop("OPTIONS_DB_TURN_UPDATE_THREADS_DESC"),   4,  RangedValidator<int>(1, 32));
+    }
+    bool temp_bool = RegisterOptions(&AddOptions);
+
+    /** Serializes the turn update message for one player.  Several of these
+      * run concurrently; each only reads the gamestate, and the empire whose
+      * knowledge is serialized is set per thread by TurnUpdateMessage. */
+    class TurnUpdateWorkItem {
+    public:
+        TurnUpdateWorkItem(int player_id, int empire_id, int current_turn,
+                           const EmpireManager& empires, const Universe& universe,
+                           const SpeciesManager& species, const CombatLogManager& combat_logs,
+                           const std::map<int, PlayerInfo>& players, Message& result) :
+            m_player_id(player_id),
+            m_empire_id(empire_id),
+            m_current_turn(current_turn),
+            m_empires(empires),
+            m_universe(universe),
+            m_species(species),
+            m_combat_logs(combat_logs),
+            m_players(players),
+            m_result(result)
+        {}
+
+        void operator()() {
+            try {
+                m_result = TurnUpdateMessage(m_player_id, m_empire_id, m_current_turn, m_empires,
+                                             m_universe, m_species, m_combat_logs, m_players);
+            } catch (const std::exception& e) {
+                ErrorLogger() << "TurnUpdateWorkItem: failed to serialize turn update for player "
+                              << m_player_id << ": " << e.what();
+            }
+        }
+
+    private:
+        int                                 m_player_id;
+        int                                 m_empire_id;
+        int                                 m_current_turn;
+        const EmpireManager&                m_empires;
+        const Universe&                     m_universe;
+        const SpeciesManager&               m_species;
+        const CombatLogManager&             m_combat_logs;
+        const std::map<int, PlayerInfo>&    m_players;
+        Message&                            m_result;
+    };
+
     //If there's only one other empire, return their ID:
     int EnemyId(int empire_id, const std::set<int> &empire_ids) {
         if (empire_ids.size() == 2) {
@@ -137,11 +185,15 @@ ServerApp::ServerApp() :
 
     PythonInit();
 
+    // keep combat logs on disk rather than in memory for the life of the server
+    GetCombatLogManager().OpenStore(GetUserDir() / fs::unique_path("combat-logs-%%%%-%%%%-%%%%.bin"));
+
     m_signals.async_wait(boost::bind(&ServerApp::SignalHandler, this, _1, _2));
 }
 
 ServerApp::~ServerApp() {
     DebugLogger() << "ServerApp::~ServerApp";
+    WaitForBackgroundSave();
     PythonCleanup();
     CleanupAIs();
     delete m_fsm;
@@ -161,9 +213,22 @@ void ServerApp::SignalHandler(const boost::system::error_code& error, int signal
 void ServerApp::Exit(int code) {
     DebugLogger() << "Initiating Exit (code " << code << " - " << (code ? "error" : "normal") << " termination)";
     CleanupAIs();
+    WaitForBackgroundSave();
     exit(code);
 }
 
+void ServerApp::BackgroundSaveFinished(bool success)
+{ m_io_service.post(boost::bind(&ServerApp::HandleBackgroundSaveFinished, this, success)); }
+
+void ServerApp::HandleBackgroundSaveFinished(bool success) {
+    if (success) {
+        DebugLogger() << "ServerApp::HandleBackgroundSaveFinished : save written";
+        return;
+    }
+    ErrorLogger() << "ServerApp::HandleBackgroundSaveFinished : save could not be written";
+    m_networking.SendMessageAll(ErrorMessage(UserStringNop("UNABLE_TO_WRITE_SAVE_FILE"), false));
+}
+
 namespace {
     std::string AIClientExe()
     {
@@ -319,10 +384,15 @@ void ServerApp::CleanupAIs() {
 
     bool ai_connection_lingering = false;
     try {
+        Message end_game_message = EndGameMessage(Networking::INVALID_PLAYER_ID, Message::YOU_ARE_ELIMINATED);
         for (ServerNetworking::const_iterator it = m_networking.begin(); it != m_networking.end(); ++it) {
             PlayerConnectionPtr player = *it;
             if (player->GetClientType() == Networking::CLIENT_TYPE_AI_PLAYER) {
-                player->SendMessage(EndGameMessage(player->PlayerID(), Message::YOU_ARE_ELIMINATED));
+                end_game_message.SetReceivingPlayer(player->PlayerID());
+                // network events may not be handled again before the AIs are
+                // killed, so write the message out now
+                if (!player->WriteMessage(end_game_message))
+                    DebugLogger() << "ServerApp::CleanupAIs() couldn't write end game message to AI player " << player->PlayerID() << " immediately";
                 ai_connection_lingering = true;
             }
         }
@@ -397,6 +467,7 @@ void ServerApp::HandleMessage(const Message& msg, PlayerConnectionPtr player_con
     case Message::SHUT_DOWN_SERVER:         HandleShutdownMessage(msg, player_connection);  break;
 
     case Message::REQUEST_SAVE_PREVIEWS:    UpdateSavePreviews(msg, player_connection); break;
+    case Message::REQUEST_COMBAT_LOGS:      UpdateCombatLogs(msg, player_connection);   break;
     
     default:
         ErrorLogger() << "ServerApp::HandleMessage : Received an unknown message type \"" << msg.Type() << "\".  Terminating connection.";
@@ -825,6 +896,21 @@ void ServerApp::UpdateSavePreviews(const Message& msg, PlayerConnectionPtr playe
     DebugLogger() << "ServerApp::UpdateSavePreviews: Previews sent.";
 }
 
+void ServerApp::UpdateCombatLogs(const Message& msg, PlayerConnectionPtr player_connection) {
+    std::vector<int> log_ids;
+    try {
+        ExtractMessageData(msg, log_ids);
+    } catch (...) {
+        ErrorLogger() << "ServerApp::UpdateCombatLogs: couldn't read requested log ids from player " << player_connection->PlayerID();
+    }
+
+    std::map<int, CombatLog> logs;
+    GetCombatLogManager().GetLogs(log_ids, PlayerEmpireID(player_connection->PlayerID()), logs);
+    DebugLogger() << "ServerApp::UpdateCombatLogs: Sending " << logs.size() << " of " << log_ids.size()
+                  << " requested combat logs to player " << player_connection->PlayerID();
+    player_connection->SendMessage(DispatchCombatLogsMessage(player_connection->PlayerID(), logs));
+}
+
 namespace {
     /** Verifies that a human player is connected with the indicated \a id. */
     bool HumanPlayerWithIdConnected(const ServerNetworking& sn, int id) {
@@ -1753,7 +1839,10 @@ namespace {
                 // knows about a change in system ownership
                 for (std::set<int>::const_iterator empire_it = combat_info.empire_ids.begin();
                      empire_it != combat_info.empire_ids.end(); ++empire_it)
-                { universe.EmpireKnownObjects(*empire_it).CopyObject(system, ALL_EMPIRES); }
+                {
+                    universe.UnshareEmpireLatestKnownObject(system->ID(), *empire_it);
+                    universe.EmpireKnownObjects(*empire_it).CopyObject(system, ALL_EMPIRES);
+                }
             }
         }
     }
@@ -2340,6 +2429,7 @@ namespace {
             // knowledge update to ensure previous owner of planet knows who owns it now?
             if (planet_initial_owner_id != ALL_EMPIRES && planet_initial_owner_id != planet->Owner()) {
                 // get empire's knowledge of object
+                GetUniverse().UnshareEmpireLatestKnownObject(planet->ID(), planet_initial_owner_id);
                 ObjectMap& empire_latest_known_objects = EmpireKnownObjects(planet_initial_owner_id);
                 empire_latest_known_objects.CopyObject(planet, planet_initial_owner_id);
             }
@@ -2657,6 +2747,9 @@ void ServerApp::PreCombatProcessTurns() {
         if (fleet)
             fleet->ClearArrivalFlag();
     }
+    // blockades are established by fleets present before any fleets move, so
+    // that fleets arriving at the same time do not blockade each other
+    m_universe.InvalidateBlockades();
     for (std::vector<TemporaryPtr<Fleet> >::iterator it = fleets.begin(); it != fleets.end(); ++it) {
         // save for possible SitRep generation after moving...
         TemporaryPtr<Fleet> fleet = *it;
@@ -3016,17 +3109,57 @@ void ServerApp::PostCombatProcessTurns() {
                                         m_networking.PlayerIsHost(player_id));
     }
 
+    DebugLogger() << "ServerApp::PostCombatProcessTurns Serializing turn updates for players";
+    // serialize new-turn updates for all players concurrently.  the gamestate
+    // is not modified until all are done, so the workers need not lock it.
+    std::vector<PlayerConnectionPtr> recipients(m_networking.established_begin(), m_networking.established_end());
+    std::vector<Message> turn_updates(recipients.size());
+    if (!recipients.empty()) {
+        ScopedTimer timer("ServerApp::PostCombatProcessTurns serializing turn updates", true);
+        unsigned int num_threads = static_cast<unsigned int>(std::min<std::size_t>(
+            std::max(1, GetOptionsDB().Get<int>("turn-update-threads")), recipients.size()));
+        RunQueue<TurnUpdateWorkItem> run_queue(num_threads);
+        boost::shared_mutex global_mutex;
+        boost::unique_lock<boost::shared_mutex> global_lock(global_mutex); // create after run_queue, destroy before run_queue
+
+        for (std::size_t i = 0; i < recipients.size(); ++i) {
+            int player_id = recipients[i]->PlayerID();
+            run_queue.AddWork(new TurnUpdateWorkItem(player_id,             PlayerEmpireID(player_id),
+                                                     m_current_turn,        m_empires,
+                                                     m_universe,            GetSpeciesManager(),
+                                                     GetCombatLogManager(), players,
+                                                     turn_updates[i]));
+        }
+        run_queue.Wait(global_lock);
+    }
+
+    // retry serializations that failed on a worker thread here, without any
+    // others running concurrently
+    for (std::size_t i = 0; i < recipients.size(); ++i) {
+        if (turn_updates[i].Type() != Message::UNDEFINED)
+            continue;
+        int player_id = recipients[i]->PlayerID();
+        DebugLogger() << "ServerApp::PostCombatProcessTurns retrying turn update for player " << player_id;
+        TurnUpdateWorkItem work_item(player_id,             PlayerEmpireID(player_id),
+                                     m_current_turn,        m_empires,
+                                     m_universe,            GetSpeciesManager(),
+                                     GetCombatLogManager(), players,
+                                     turn_updates[i]);
+        work_item();
+    }
+
     DebugLogger() << "ServerApp::PostCombatProcessTurns Sending turn updates to players";
-    // send new-turn updates to all players
-    for (ServerNetworking::const_established_iterator player_it = m_networking.established_begin();
-         player_it != m_networking.established_end(); ++player_it)
-    {
-        PlayerConnectionPtr player = *player_it;
-        int player_id = player->PlayerID();
-        player->SendMessage(TurnUpdateMessage(player_id,                PlayerEmpireID(player_id),
-                                              m_current_turn,           m_empires,
-                                              m_universe,               GetSpeciesManager(),
-                                              GetCombatLogManager(),    players));
+    // sending only queues the messages; they are written as the sockets accept them
+    for (std::size_t i = 0; i < recipients.size(); ++i) {
+        if (turn_updates[i].Type() == Message::UNDEFINED) {
+            // the player can't continue without a turn update
+            ErrorLogger() << "ServerApp::PostCombatProcessTurns couldn't serialize turn update for player "
+                          << recipients[i]->PlayerID() << ".  Terminating connection.";
+            recipients[i]->SendMessage(ErrorMessage(recipients[i]->PlayerID(), UserStringNop("SERVER_TURN_UPDATE_ERROR"), true));
+            m_networking.Disconnect(recipients[i]);
+            continue;
+        }
+        recipients[i]->SendMessage(turn_updates[i]);
     }
     DebugLogger() << "ServerApp::PostCombatProcessTurns done";
 }
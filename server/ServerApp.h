@@ -156,6 +156,15 @@ public:
 
     void UpdateSavePreviews(const Message& msg, PlayerConnectionPtr player_connection);
 
+    /** Sends the contents of the combat logs requested in \a msg to the
+      * requesting player, leaving out any the player's empire may not see. */
+    void UpdateCombatLogs(const Message& msg, PlayerConnectionPtr player_connection);
+
+    /** Called when a save started by SaveGameInBackground() has finished
+      * being written, which may be on another thread.  Defers handling the
+      * result to the server's main thread. */
+    void BackgroundSaveFinished(bool success);
+
     static ServerApp*           GetApp();         ///< returns a ClientApp pointer to the singleton instance of the app
     Universe&                   GetUniverse();    ///< returns server's copy of Universe
     EmpireManager&              Empires();        ///< returns the server's copy of the Empires
@@ -235,6 +244,10 @@ private:
       * between two empires. Updates those empires of the change. */
     void    HandleDiplomaticMessageChange(int empire1_id, int empire2_id);
 
+    /** Reports the result of a background save to players; called on the
+      * server's main thread. */
+    void    HandleBackgroundSaveFinished(bool success);
+
     boost::asio::io_service m_io_service;
     boost::asio::signal_set m_signals;
 
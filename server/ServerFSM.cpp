@@ -18,6 +18,7 @@
 #include "../util/ModeratorAction.h"
 #include "../util/MultiplayerCommon.h"
 
+#include <boost/bind.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/thread/thread.hpp>
@@ -34,15 +35,7 @@ namespace {
             ErrorLogger() << "SendMessageToAllPlayers couldn't get server.";
             return;
         }
-        ServerNetworking& networking = server->Networking();
-
-        for (ServerNetworking::const_established_iterator player_it = networking.established_begin();
-             player_it != networking.established_end();
-             ++player_it)
-        {
-            PlayerConnectionPtr player = *player_it;
-            player->SendMessage(message);
-        }
+        server->Networking().SendMessageAll(message);
     }
 
     void SendMessageToHost(const Message& message) {
@@ -201,11 +194,12 @@ void ServerFSM::HandleNonLobbyDisconnection(const Disconnection& d) {
         // player abnormally disconnected during a regular game
         DebugLogger() << "ServerFSM::HandleNonLobbyDisconnection : Lost connection to player #" << boost::lexical_cast<std::string>(id)
                                << ", named \"" << player_connection->PlayerName() << "\"; server terminating.";
-        std::string message = player_connection->PlayerName();
+        // in the future we may find a way to recover from this, but for now we will immediately send a game ending message as well
+        Message end_game_message = EndGameMessage(Networking::INVALID_PLAYER_ID, Message::PLAYER_DISCONNECT, player_connection->PlayerName());
         for (ServerNetworking::const_established_iterator it = m_server.m_networking.established_begin(); it != m_server.m_networking.established_end(); ++it) {
             if ((*it)->PlayerID() != id) {
-                // in the future we may find a way to recover from this, but for now we will immediately send a game ending message as well
-                (*it)->SendMessage(EndGameMessage((*it)->PlayerID(), Message::PLAYER_DISCONNECT, player_connection->PlayerName()));
+                end_game_message.SetReceivingPlayer((*it)->PlayerID());
+                (*it)->SendMessage(end_game_message);
             }
         }
     }
@@ -373,11 +367,7 @@ sc::result MPLobby::react(const Disconnection& d) {
     }
 
     // send updated lobby data to players after disconnection-related changes
-    for (ServerNetworking::const_established_iterator it = server.m_networking.established_begin();
-         it != server.m_networking.established_end(); ++it)
-    {
-        (*it)->SendMessage(ServerLobbyUpdateMessage((*it)->PlayerID(), *m_lobby_data));
-    }
+    server.m_networking.SendMessageAll(ServerLobbyUpdateMessage(Networking::INVALID_PLAYER_ID, *m_lobby_data));
 
     return discard_event();
 }
@@ -451,9 +441,7 @@ sc::result MPLobby::react(const JoinGame& msg) {
     // after setting all details, push into lobby data
     m_lobby_data->m_players.push_back(std::make_pair(player_id, player_setup_data));
 
-    for (ServerNetworking::const_established_iterator it = server.m_networking.established_begin();
-         it != server.m_networking.established_end(); ++it)
-    { (*it)->SendMessage(ServerLobbyUpdateMessage((*it)->PlayerID(), *m_lobby_data)); }
+    server.m_networking.SendMessageAll(ServerLobbyUpdateMessage(Networking::INVALID_PLAYER_ID, *m_lobby_data));
 
     return discard_event();
 }
@@ -672,9 +660,12 @@ sc::result MPLobby::react(const LobbyChat& msg) {
     const Message& message = msg.m_message;
 
     if (message.ReceivingPlayer() == Networking::INVALID_PLAYER_ID) { // the receiver is everyone (except the sender)
+        Message chat_message = ServerLobbyChatMessage(message.SendingPlayer(), Networking::INVALID_PLAYER_ID, message.Text());
         for (ServerNetworking::const_established_iterator it = server.m_networking.established_begin(); it != server.m_networking.established_end(); ++it) {
-            if ((*it)->PlayerID() != message.SendingPlayer())
-                (*it)->SendMessage(ServerLobbyChatMessage(message.SendingPlayer(), (*it)->PlayerID(), message.Text()));
+            if ((*it)->PlayerID() != message.SendingPlayer()) {
+                chat_message.SetReceivingPlayer((*it)->PlayerID());
+                (*it)->SendMessage(chat_message);
+            }
         }
     } else {
         server.m_networking.SendMessage(ServerLobbyChatMessage(message.SendingPlayer(), message.ReceivingPlayer(), message.Text()));
@@ -1073,15 +1064,17 @@ PlayingGame::~PlayingGame()
 sc::result PlayingGame::react(const PlayerChat& msg) {
     if (TRACE_EXECUTION) DebugLogger() << "(ServerFSM) PlayingGame.PlayerChat";
     ServerApp& server = Server();
+    Message chat_message = SingleRecipientChatMessage(msg.m_message.SendingPlayer(),
+                                                      Networking::INVALID_PLAYER_ID,
+                                                      msg.m_message.Text());
     for (ServerNetworking::const_established_iterator it = server.m_networking.established_begin();
          it != server.m_networking.established_end(); ++it)
     {
         if (msg.m_message.ReceivingPlayer() == Networking::INVALID_PLAYER_ID ||
             msg.m_message.ReceivingPlayer() == (*it)->PlayerID())
         {
-            (*it)->SendMessage(SingleRecipientChatMessage(msg.m_message.SendingPlayer(),
-                                                          (*it)->PlayerID(),
-                                                          msg.m_message.Text()));
+            chat_message.SetReceivingPlayer((*it)->PlayerID());
+            (*it)->SendMessage(chat_message);
         }
     }
     return discard_event();
@@ -1210,14 +1203,9 @@ sc::result WaitingForTurnEnd::react(const TurnOrders& msg) {
 
 
     // notify other player that this player submitted orders
-    for (ServerNetworking::const_established_iterator player_it = server.m_networking.established_begin();
-         player_it != server.m_networking.established_end(); ++player_it)
-    {
-        PlayerConnectionPtr player_ctn = *player_it;
-        player_ctn->SendMessage(PlayerStatusMessage(player_ctn->PlayerID(),
-                                                    message.SendingPlayer(),
-                                                    Message::WAITING));
-    }
+    server.m_networking.SendMessageAll(PlayerStatusMessage(Networking::INVALID_PLAYER_ID,
+                                                           message.SendingPlayer(),
+                                                           Message::WAITING));
 
     // inform player who just submitted of their new status.  Note: not sure why
     // this only needs to be send to the submitting player and not all others as
@@ -1393,13 +1381,25 @@ sc::result WaitingForSaveData::react(const ClientSaveData& msg) {
         // set in WaitingForTurnEndIdle::react(const SaveGameRequest& msg)
         const std::string& save_filename = context<WaitingForTurnEnd>().m_save_filename;
 
-        // save game...
+        // save game...  autosaves are serialized now and written to disk in
+        // the background, so that the turn can continue meanwhile.  other
+        // saves are written before continuing, as the player is waiting for
+        // them.
         try {
-            SaveGame(save_filename,     server_data,    m_player_save_game_data,
-                     GetUniverse(),     Empires(),      GetSpeciesManager(),
-                     GetCombatLogManager(),             server.m_galaxy_setup_data,
-                     !server.m_single_player_game
-                    );
+            if (IsAutosaveFilename(save_filename)) {
+                SaveGameInBackground(save_filename,     server_data,    m_player_save_game_data,
+                                     GetUniverse(),     Empires(),      GetSpeciesManager(),
+                                     GetCombatLogManager(),             server.m_galaxy_setup_data,
+                                     !server.m_single_player_game,
+                                     boost::bind(&ServerApp::BackgroundSaveFinished, &server, _1)
+                                    );
+            } else {
+                SaveGame(save_filename,     server_data,    m_player_save_game_data,
+                         GetUniverse(),     Empires(),      GetSpeciesManager(),
+                         GetCombatLogManager(),             server.m_galaxy_setup_data,
+                         !server.m_single_player_game
+                        );
+            }
 
         } catch (const std::exception&) {
             DebugLogger() << "Catch std::exception&";
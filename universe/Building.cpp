@@ -223,29 +223,27 @@ std::string BuildingType::Dump() const {
     return retval;
 }
 
-namespace {
-    TemporaryPtr<const UniverseObject> SourceForEmpire(int empire_id) {
-        const Empire* empire = GetEmpire(empire_id);
-        if (!empire) {
-            DebugLogger() << "SourceForEmpire: Unable to get empire with ID: " << empire_id;
-            return TemporaryPtr<const UniverseObject>();
-        }
-        // get a source object, which is owned by the empire with the passed-in
-        // empire id.  this is used in conditions to reference which empire is
-        // doing the building.  Ideally this will be the capital, but any object
-        // owned by the empire will work.
-        TemporaryPtr<const UniverseObject> source = GetUniverseObject(empire->CapitalID());
-        // no capital?  scan through all objects to find one owned by this empire
-        if (!source) {
-            for (ObjectMap::const_iterator<> obj_it = Objects().const_begin(); obj_it != Objects().const_end(); ++obj_it) {
-                if (obj_it->OwnedBy(empire_id)) {
-                    source = *obj_it;
-                    break;
-                }
+TemporaryPtr<const UniverseObject> ProductionSourceForEmpire(int empire_id) {
+    const Empire* empire = GetEmpire(empire_id);
+    if (!empire) {
+        DebugLogger() << "ProductionSourceForEmpire: Unable to get empire with ID: " << empire_id;
+        return TemporaryPtr<const UniverseObject>();
+    }
+    // get a source object, which is owned by the empire with the passed-in
+    // empire id.  this is used in conditions to reference which empire is
+    // doing the building.  Ideally this will be the capital, but any object
+    // owned by the empire will work.
+    TemporaryPtr<const UniverseObject> source = GetUniverseObject(empire->CapitalID());
+    // no capital?  scan through all objects to find one owned by this empire
+    if (!source) {
+        for (ObjectMap::const_iterator<> obj_it = Objects().const_begin(); obj_it != Objects().const_end(); ++obj_it) {
+            if (obj_it->OwnedBy(empire_id)) {
+                source = *obj_it;
+                break;
             }
         }
-        return source;
     }
+    return source;
 }
 
 bool BuildingType::ProductionCostTimeLocationInvariant() const {
@@ -269,7 +267,7 @@ float BuildingType::ProductionCost(int empire_id, int location_id) const {
         if (!location)
             return 999999.9f;    // arbitrary large number
 
-        TemporaryPtr<const UniverseObject> source = SourceForEmpire(empire_id);
+        TemporaryPtr<const UniverseObject> source = ProductionSourceForEmpire(empire_id);
         if (!source && !m_production_cost->SourceInvariant())
             return 999999.9f;
 
@@ -293,7 +291,7 @@ int BuildingType::ProductionTime(int empire_id, int location_id) const {
         if (!location)
             return 9999;    // arbitrary large number
 
-        TemporaryPtr<const UniverseObject> source = SourceForEmpire(empire_id);
+        TemporaryPtr<const UniverseObject> source = ProductionSourceForEmpire(empire_id);
         if (!source && !m_production_time->SourceInvariant())
             return 9999;
 
@@ -311,7 +309,7 @@ bool BuildingType::ProductionLocation(int empire_id, int location_id) const {
     if (!location)
         return false;
 
-    TemporaryPtr<const UniverseObject> source = SourceForEmpire(empire_id);
+    TemporaryPtr<const UniverseObject> source = ProductionSourceForEmpire(empire_id);
     if (!source)
         return false;
 
@@ -326,7 +324,7 @@ bool BuildingType::EnqueueLocation(int empire_id, int location_id) const {
     if (!location)
         return false;
 
-    TemporaryPtr<const UniverseObject> source = SourceForEmpire(empire_id);
+    TemporaryPtr<const UniverseObject> source = ProductionSourceForEmpire(empire_id);
     if (!source)
         return false;
 
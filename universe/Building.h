@@ -233,4 +233,10 @@ FO_COMMON_API BuildingTypeManager& GetBuildingTypeManager();
   * type \a name.  If no such BuildingType exists, 0 is returned instead. */
 FO_COMMON_API const BuildingType* GetBuildingType(const std::string& name);
 
+/** Returns an object owned by the empire with id \a empire_id, preferably its
+  * capital, that is used as the source when evaluating the conditions and
+  * values that determine where and at what cost that empire can produce
+  * items.  Returns a null pointer if there is no such object. */
+FO_COMMON_API TemporaryPtr<const UniverseObject> ProductionSourceForEmpire(int empire_id);
+
 #endif // _Building_h_
@@ -3,6 +3,7 @@
 #include "../util/Logger.h"
 #include "../util/Random.h"
 #include "../util/i18n.h"
+#include "../util/OptionsDB.h"
 #include "UniverseObject.h"
 #include "Universe.h"
 #include "Building.h"
@@ -21,8 +22,13 @@
 
 #include <boost/algorithm/string/case_conv.hpp>
 #include <boost/bind.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/st_connected.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
 
 using boost::io::str;
 
@@ -94,6 +100,40 @@ namespace {
                         boost::bind(&std::map< int, TemporaryPtr< UniverseObject > >::value_type::second,_1) );
     }
 
+    void AddIndexedObjects(const std::vector<TemporaryPtr<const UniverseObject> >& indexed_objects,
+                           Condition::ObjectSet& condition_non_targets)
+    {
+        condition_non_targets.insert(condition_non_targets.end(),
+                                     indexed_objects.begin(), indexed_objects.end());
+    }
+
+    /** Returns the bit that represents the object with id \a object_id in an
+      * object id bitset.  Temporary objects have the lowest id of any object
+      * in the universe. */
+    std::size_t ObjectIDBit(int object_id)
+    { return static_cast<std::size_t>(object_id - TEMPORARY_OBJECT_ID); }
+
+    /** Returns the number of bits an object id bitset needs to represent all
+      * of \a objects. */
+    std::size_t ObjectIDBitsetSize(const Condition::ObjectSet& objects) {
+        std::size_t retval = 0;
+        for (Condition::ObjectSet::const_iterator it = objects.begin(); it != objects.end(); ++it)
+            retval = std::max(retval, ObjectIDBit((*it)->ID()) + 1);
+        return retval;
+    }
+
+    /** Number of initial candidates below which And stops collecting the
+      * candidates of further operands, and leaves it to evaluation to test
+      * those few candidates against the remaining operands. */
+    const std::size_t FEW_INITIAL_CANDIDATES = 16;
+
+    /** Sets the bits of the ids of \a objects in \a bits, which must be large
+      * enough to hold all of them. */
+    void SetObjectIDBits(const Condition::ObjectSet& objects, boost::dynamic_bitset<>& bits) {
+        for (Condition::ObjectSet::const_iterator it = objects.begin(); it != objects.end(); ++it)
+            bits.set(ObjectIDBit((*it)->ID()));
+    }
+
     /** Attempts to cast \a obj to a Fleet pointer. If that fails, attempts to
       * cast \a obj to a Ship pointer, and then get the Fleet of the ship. If
       * both fail then returns a null object Fleet pointer. */
@@ -254,6 +294,14 @@ bool Condition::ConditionBase::operator==(const Condition::ConditionBase& rhs) c
     return true;
 }
 
+std::size_t Condition::ConditionBase::StructuralHash() const {
+    if (!m_structural_hash_known) {
+        m_structural_hash = boost::hash<std::string>()(Dump());
+        m_structural_hash_known = true;
+    }
+    return m_structural_hash;
+}
+
 void Condition::ConditionBase::Eval(const ScriptingContext& parent_context,
                                     ObjectSet& matches, ObjectSet& non_matches,
                                     SearchDomain search_domain/* = NON_MATCHES*/) const
@@ -449,6 +497,9 @@ bool Condition::Number::SourceInvariant() const {
            m_condition->SourceInvariant();
 }
 
+bool Condition::Number::Deterministic() const
+{ return !m_condition || m_condition->Deterministic(); }
+
 bool Condition::Number::Match(const ScriptingContext& local_context) const {
     // get acceptable range of subcondition matches for candidate
     int low = (m_low ? std::max(0, m_low->Eval(local_context)) : 0);
@@ -922,6 +973,9 @@ bool Condition::SortedNumberOf::SourceInvariant() const
           (!m_sort_key || m_sort_key->SourceInvariant()) &&
           (!m_condition || m_condition->SourceInvariant())); }
 
+bool Condition::SortedNumberOf::Deterministic() const
+{ return m_sorting_method != SORT_RANDOM && (!m_condition || m_condition->Deterministic()); }
+
 std::string Condition::SortedNumberOf::Description(bool negated/* = false*/) const {
     std::string number_str = ValueRef::ConstantExpr(m_number) ? boost::lexical_cast<std::string>(m_number->Dump()) : m_number->Description();
 
@@ -1004,6 +1058,9 @@ void Condition::SortedNumberOf::GetDefaultInitialCandidateObjects(const Scriptin
     }
 }
 
+bool Condition::SortedNumberOf::RestrictsInitialCandidates() const
+{ return m_condition && m_condition->RestrictsInitialCandidates(); }
+
 void Condition::SortedNumberOf::SetTopLevelContent(const std::string& content_name) {
     if (m_number)
         m_number->SetTopLevelContent(content_name);
@@ -1221,6 +1278,33 @@ std::string Condition::EmpireAffiliation::Dump() const {
     return retval;
 }
 
+void Condition::EmpireAffiliation::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                                     Condition::ObjectSet& condition_non_targets) const
+{
+    // only affiliations that depend on just the owner can use the owner index
+    bool simple_eval_safe = Objects().IndexesBuilt() &&
+                            (m_affiliation == AFFIL_NONE ||
+                             (m_affiliation == AFFIL_SELF &&
+                              (!m_empire_id || ValueRef::ConstantExpr(m_empire_id) ||
+                               (m_empire_id->LocalCandidateInvariant() &&
+                               (parent_context.condition_root_candidate || RootCandidateInvariant())))));
+    if (!simple_eval_safe) {
+        ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+
+    if (m_affiliation == AFFIL_NONE) {
+        AddIndexedObjects(*Objects().IndexedObjectsOwnedBy(ALL_EMPIRES), condition_non_targets);
+        return;
+    }
+
+    TemporaryPtr<const UniverseObject> no_object;
+    int empire_id = m_empire_id ? m_empire_id->Eval(ScriptingContext(parent_context, no_object)) : ALL_EMPIRES;
+    if (empire_id == ALL_EMPIRES)
+        return; // nothing is owned by no empire
+    AddIndexedObjects(*Objects().IndexedObjectsOwnedBy(empire_id), condition_non_targets);
+}
+
 bool Condition::EmpireAffiliation::Match(const ScriptingContext& local_context) const {
     TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
@@ -1966,7 +2050,26 @@ std::string Condition::Building::Dump() const {
 
 void Condition::Building::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                             Condition::ObjectSet& condition_non_targets) const
-{ AddBuildingSet(condition_non_targets); }
+{
+    bool simple_eval_safe = !m_names.empty() && Objects().IndexesBuilt() &&
+                            (parent_context.condition_root_candidate || RootCandidateInvariant());
+    for (std::vector<ValueRef::ValueRefBase<std::string>*>::const_iterator it = m_names.begin();
+         simple_eval_safe && it != m_names.end(); ++it)
+    { simple_eval_safe = (*it)->LocalCandidateInvariant(); }
+
+    if (!simple_eval_safe) {
+        AddBuildingSet(condition_non_targets);
+        return;
+    }
+
+    // add buildings of each specified type once
+    std::set<std::string> names;
+    for (std::vector<ValueRef::ValueRefBase<std::string>*>::const_iterator it = m_names.begin();
+         it != m_names.end(); ++it)
+    { names.insert((*it)->Eval(parent_context)); }
+    for (std::set<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+        AddIndexedObjects(*Objects().IndexedBuildingsOfType(*it), condition_non_targets);
+}
 
 bool Condition::Building::Match(const ScriptingContext& local_context) const {
     TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
@@ -2192,6 +2295,28 @@ std::string Condition::HasSpecial::Dump() const {
     return DumpIndent() + "HasSpecial name = \"" + name_str + "\"\n";
 }
 
+void Condition::HasSpecial::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                              Condition::ObjectSet& condition_non_targets) const
+{
+    bool simple_eval_safe = m_name && Objects().IndexesBuilt() &&
+                            m_name->LocalCandidateInvariant() &&
+                            (parent_context.condition_root_candidate || RootCandidateInvariant());
+    if (!simple_eval_safe) {
+        ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+
+    // capacity and turn limits are checked when matching; any object with the
+    // special may match
+    TemporaryPtr<const UniverseObject> no_object;
+    std::string name = m_name->Eval(ScriptingContext(parent_context, no_object));
+    if (name.empty()) {
+        ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+    AddIndexedObjects(*Objects().IndexedObjectsWithSpecial(name), condition_non_targets);
+}
+
 bool Condition::HasSpecial::Match(const ScriptingContext& local_context) const {
     TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
@@ -2320,6 +2445,22 @@ std::string Condition::HasTag::Dump() const {
     return retval;
 }
 
+void Condition::HasTag::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                          Condition::ObjectSet& condition_non_targets) const
+{
+    bool simple_eval_safe = m_name && Objects().IndexesBuilt() &&
+                            m_name->LocalCandidateInvariant() &&
+                            (parent_context.condition_root_candidate || RootCandidateInvariant());
+    if (!simple_eval_safe) {
+        ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+
+    TemporaryPtr<const UniverseObject> no_object;
+    std::string name = boost::to_upper_copy<std::string>(m_name->Eval(ScriptingContext(parent_context, no_object)));
+    AddIndexedObjects(*Objects().IndexedObjectsWithTag(name), condition_non_targets);
+}
+
 bool Condition::HasTag::Match(const ScriptingContext& local_context) const {
     TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
@@ -2564,6 +2705,9 @@ bool Condition::Contains::TargetInvariant() const
 bool Condition::Contains::SourceInvariant() const
 { return m_condition->SourceInvariant(); }
 
+bool Condition::Contains::Deterministic() const
+{ return !m_condition || m_condition->Deterministic(); }
+
 std::string Condition::Contains::Description(bool negated/* = false*/) const {
     return str(FlexibleFormat((!negated)
         ? UserString("DESC_CONTAINS")
@@ -2731,6 +2875,9 @@ bool Condition::ContainedBy::TargetInvariant() const
 bool Condition::ContainedBy::SourceInvariant() const
 { return m_condition->SourceInvariant(); }
 
+bool Condition::ContainedBy::Deterministic() const
+{ return !m_condition || m_condition->Deterministic(); }
+
 std::string Condition::ContainedBy::Description(bool negated/* = false*/) const {
     return str(FlexibleFormat((!negated)
         ? UserString("DESC_CONTAINED_BY")
@@ -2870,6 +3017,28 @@ std::string Condition::InSystem::Dump() const {
     return retval;
 }
 
+void Condition::InSystem::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                            Condition::ObjectSet& condition_non_targets) const
+{
+    bool simple_eval_safe = m_system_id && Objects().IndexesBuilt() &&
+                            (ValueRef::ConstantExpr(m_system_id) ||
+                             (m_system_id->LocalCandidateInvariant() &&
+                             (parent_context.condition_root_candidate || RootCandidateInvariant())));
+    if (!simple_eval_safe) {
+        ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+
+    TemporaryPtr<const UniverseObject> no_object;
+    int system_id = m_system_id->Eval(ScriptingContext(parent_context, no_object));
+    if (system_id == INVALID_OBJECT_ID) {
+        // objects in any system may match
+        ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+    AddIndexedObjects(*Objects().IndexedObjectsInSystem(system_id), condition_non_targets);
+}
+
 bool Condition::InSystem::Match(const ScriptingContext& local_context) const {
     TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
@@ -3647,8 +3816,11 @@ bool Condition::Species::operator==(const Condition::ConditionBase& rhs) const {
 
 namespace {
     struct SpeciesSimpleMatch {
-        SpeciesSimpleMatch(const std::vector<std::string>& names) :
-            m_names(names)
+        /** \a name_ids are the interned ids of the species to match, or all
+          * species if \a any_species is true. */
+        SpeciesSimpleMatch(const std::vector<StringID>& name_ids, bool any_species) :
+            m_name_ids(name_ids),
+            m_any_species(any_species)
         {}
 
         bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
@@ -3657,28 +3829,31 @@ namespace {
 
             // is it a population centre?
             if (TemporaryPtr<const ::PopCenter> pop = boost::dynamic_pointer_cast<const ::PopCenter>(candidate)) {
-                const std::string& species_name = pop->SpeciesName();
                 // if the popcenter has a species and that species is one of those specified...
-                return !species_name.empty() && (m_names.empty() || (std::find(m_names.begin(), m_names.end(), species_name) != m_names.end()));
+                return MatchesID(pop->SpeciesNameID());
             }
             // is it a ship?
             if (TemporaryPtr<const ::Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate)) {
                 // if the ship has a species and that species is one of those specified...
-                const std::string& species_name = ship->SpeciesName();
-                return !species_name.empty() && (m_names.empty() || (std::find(m_names.begin(), m_names.end(), species_name) != m_names.end()));
+                return MatchesID(ship->SpeciesNameID());
             }
             // is it a building on a planet?
             if (TemporaryPtr<const ::Building> building = boost::dynamic_pointer_cast<const Building>(candidate)) {
                 TemporaryPtr<const ::Planet> planet = GetPlanet(building->PlanetID());
-                const std::string& species_name = planet->SpeciesName();
                 // if the planet (which IS a popcenter) has a species and that species is one of those specified...
-                return !species_name.empty() && (m_names.empty() || (std::find(m_names.begin(), m_names.end(), species_name) != m_names.end()));
+                return MatchesID(planet->SpeciesNameID());
             }
 
             return false;
         }
 
-        const std::vector<std::string>& m_names;
+        bool MatchesID(StringID species_name_id) const {
+            return species_name_id != INVALID_STRING_ID &&
+                   (m_any_species || std::find(m_name_ids.begin(), m_name_ids.end(), species_name_id) != m_name_ids.end());
+        }
+
+        const std::vector<StringID>&    m_name_ids;
+        bool                            m_any_species;
     };
 }
 
@@ -3699,13 +3874,18 @@ void Condition::Species::Eval(const ScriptingContext& parent_context,
         }
     }
     if (simple_eval_safe) {
-        // evaluate names once, and use to check all candidate objects
-        std::vector<std::string> names;
+        // evaluate names once, and use to check all candidate objects.  names
+        // that have never been interned can't be the species of any object.
+        std::vector<StringID> name_ids;
         // get all names from valuerefs
         for (std::vector<ValueRef::ValueRefBase<std::string>*>::const_iterator it = m_names.begin();
              it != m_names.end(); ++it)
-        { names.push_back((*it)->Eval(parent_context)); }
-        EvalImpl(matches, non_matches, search_domain, SpeciesSimpleMatch(names));
+        {
+            StringID name_id = InternedStringID((*it)->Eval(parent_context));
+            if (name_id != INVALID_STRING_ID)
+                name_ids.push_back(name_id);
+        }
+        EvalImpl(matches, non_matches, search_domain, SpeciesSimpleMatch(name_ids, m_names.empty()));
     } else {
         // re-evaluate allowed building types range for each candidate object
         Condition::ConditionBase::Eval(parent_context, matches, non_matches, search_domain);
@@ -3780,6 +3960,29 @@ std::string Condition::Species::Dump() const {
     return retval;
 }
 
+void Condition::Species::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                           Condition::ObjectSet& condition_non_targets) const
+{
+    bool simple_eval_safe = !m_names.empty() && Objects().IndexesBuilt() &&
+                            (parent_context.condition_root_candidate || RootCandidateInvariant());
+    for (std::vector<ValueRef::ValueRefBase<std::string>*>::const_iterator it = m_names.begin();
+         simple_eval_safe && it != m_names.end(); ++it)
+    { simple_eval_safe = (*it)->LocalCandidateInvariant(); }
+
+    if (!simple_eval_safe) {
+        ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+
+    // add objects with each specified species once
+    std::set<std::string> names;
+    for (std::vector<ValueRef::ValueRefBase<std::string>*>::const_iterator it = m_names.begin();
+         it != m_names.end(); ++it)
+    { names.insert((*it)->Eval(parent_context)); }
+    for (std::set<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+        AddIndexedObjects(*Objects().IndexedObjectsWithSpecies(*it), condition_non_targets);
+}
+
 bool Condition::Species::Match(const ScriptingContext& local_context) const {
     TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
@@ -6378,6 +6581,9 @@ bool Condition::WithinDistance::TargetInvariant() const
 bool Condition::WithinDistance::SourceInvariant() const
 { return m_distance->SourceInvariant() && m_condition->SourceInvariant(); }
 
+bool Condition::WithinDistance::Deterministic() const
+{ return !m_condition || m_condition->Deterministic(); }
+
 std::string Condition::WithinDistance::Description(bool negated/* = false*/) const {
     std::string value_str = ValueRef::ConstantExpr(m_distance) ?
                                 boost::lexical_cast<std::string>(m_distance->Eval()) :
@@ -6512,6 +6718,9 @@ bool Condition::WithinStarlaneJumps::TargetInvariant() const
 bool Condition::WithinStarlaneJumps::SourceInvariant() const
 { return m_jumps->SourceInvariant() && m_condition->SourceInvariant(); }
 
+bool Condition::WithinStarlaneJumps::Deterministic() const
+{ return !m_condition || m_condition->Deterministic(); }
+
 std::string Condition::WithinStarlaneJumps::Description(bool negated/* = false*/) const {
     std::string value_str = ValueRef::ConstantExpr(m_jumps) ? boost::lexical_cast<std::string>(m_jumps->Eval()) : m_jumps->Description();
     return str(FlexibleFormat((!negated)
@@ -6970,6 +7179,9 @@ bool Condition::CanAddStarlaneConnection::TargetInvariant() const
 bool Condition::CanAddStarlaneConnection::SourceInvariant() const
 { return m_condition->SourceInvariant(); }
 
+bool Condition::CanAddStarlaneConnection::Deterministic() const
+{ return !m_condition || m_condition->Deterministic(); }
+
 std::string Condition::CanAddStarlaneConnection::Description(bool negated/* = false*/) const {
     return str(FlexibleFormat((!negated)
         ? UserString("DESC_CAN_ADD_STARLANE_CONNECTION") : UserString("DESC_CAN_ADD_STARLANE_CONNECTION_NOT"))
@@ -7355,6 +7567,9 @@ bool Condition::ResourceSupplyConnectedByEmpire::TargetInvariant() const
 bool Condition::ResourceSupplyConnectedByEmpire::SourceInvariant() const
 { return m_empire_id->SourceInvariant() && m_condition->SourceInvariant(); }
 
+bool Condition::ResourceSupplyConnectedByEmpire::Deterministic() const
+{ return !m_condition || m_condition->Deterministic(); }
+
 bool Condition::ResourceSupplyConnectedByEmpire::Match(const ScriptingContext& local_context) const {
     TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
@@ -7617,6 +7832,9 @@ bool Condition::OrderedBombarded::TargetInvariant() const
 bool Condition::OrderedBombarded::SourceInvariant() const
 { return m_by_object_condition->SourceInvariant(); }
 
+bool Condition::OrderedBombarded::Deterministic() const
+{ return !m_by_object_condition || m_by_object_condition->Deterministic(); }
+
 std::string Condition::OrderedBombarded::Description(bool negated/* = false*/) const {
     std::string by_str;
     if (m_by_object_condition)
@@ -7990,9 +8208,361 @@ void Condition::Location::SetTopLevelContent(const std::string& content_name) {
         m_name2->SetTopLevelContent(content_name);
 }
 
+///////////////////////////////////////////////////////////
+// OperandPlan                                           //
+///////////////////////////////////////////////////////////
+namespace {
+    double EstimatedCost(const Condition::ConditionBase* condition);
+
+    double SumOfEstimatedCosts(const std::vector<Condition::ConditionBase*>& conditions) {
+        double retval = 0.0;
+        for (std::vector<Condition::ConditionBase*>::const_iterator it = conditions.begin();
+             it != conditions.end(); ++it)
+        { retval += EstimatedCost(*it); }
+        return retval;
+    }
+
+    /** Returns a rough estimate of the relative cost of evaluating
+      * \a condition on one candidate object. */
+    double EstimatedCost(const Condition::ConditionBase* condition) {
+        if (!condition)
+            return 0.0;
+
+        // combinations of other conditions
+        if (const Condition::And* and_condition = dynamic_cast<const Condition::And*>(condition))
+            return SumOfEstimatedCosts(and_condition->Operands());
+        if (const Condition::Or* or_condition = dynamic_cast<const Condition::Or*>(condition))
+            return SumOfEstimatedCosts(or_condition->Operands());
+        if (const Condition::Not* not_condition = dynamic_cast<const Condition::Not*>(condition))
+            return EstimatedCost(not_condition->Operand());
+        if (const Condition::Described* described_condition = dynamic_cast<const Condition::Described*>(condition))
+            return EstimatedCost(described_condition->SubCondition());
+
+        // conditions that match subconditions against the objects in or
+        // around each candidate
+        if (const Condition::Contains* contains_condition = dynamic_cast<const Condition::Contains*>(condition))
+            return 10.0 + EstimatedCost(contains_condition->GetCondition());
+        if (const Condition::ContainedBy* contained_condition = dynamic_cast<const Condition::ContainedBy*>(condition))
+            return 10.0 + EstimatedCost(contained_condition->GetCondition());
+
+        // conditions that evaluate subconditions on the whole universe, or
+        // search distances or the starlane graph
+        if (dynamic_cast<const Condition::Number*>(condition) ||
+            dynamic_cast<const Condition::SortedNumberOf*>(condition) ||
+            dynamic_cast<const Condition::WithinDistance*>(condition) ||
+            dynamic_cast<const Condition::WithinStarlaneJumps*>(condition) ||
+            dynamic_cast<const Condition::CanAddStarlaneConnection*>(condition) ||
+            dynamic_cast<const Condition::ResourceSupplyConnectedByEmpire*>(condition) ||
+            dynamic_cast<const Condition::OrderedBombarded*>(condition))
+        { return 100.0; }
+
+        // conditions that look up empires, queues, designs or content
+        if (dynamic_cast<const Condition::Enqueued*>(condition) ||
+            dynamic_cast<const Condition::VisibleToEmpire*>(condition) ||
+            dynamic_cast<const Condition::ExploredByEmpire*>(condition) ||
+            dynamic_cast<const Condition::FleetSupplyableByEmpire*>(condition) ||
+            dynamic_cast<const Condition::OwnerHasTech*>(condition) ||
+            dynamic_cast<const Condition::OwnerHasBuildingTypeAvailable*>(condition) ||
+            dynamic_cast<const Condition::OwnerHasShipDesignAvailable*>(condition) ||
+            dynamic_cast<const Condition::EmpireMeterValue*>(condition) ||
+            dynamic_cast<const Condition::EmpireStockpileValue*>(condition) ||
+            dynamic_cast<const Condition::CanColonize*>(condition) ||
+            dynamic_cast<const Condition::CanProduceShips*>(condition) ||
+            dynamic_cast<const Condition::Location*>(condition) ||
+            dynamic_cast<const Condition::ValueTest*>(condition))
+        { return 3.0; }
+
+        // simple tests of the candidate's own properties
+        return 1.0;
+    }
+
+    const unsigned int EVALS_PER_PLAN = 32;
+}
+
+/** Keeps the order in which an And or Or condition evaluates its operands.
+  * Operands are ranked by their estimated cost per candidate, divided by the
+  * fraction of candidates they have been seen to remove from further
+  * evaluation: for And, those they reject, and for Or, those they accept.
+  * Until an operand has been evaluated, half of the candidates are assumed
+  * to pass it. */
+struct Condition::OperandPlan {
+    OperandPlan(const std::vector<ConditionBase*>& operands, bool is_and) :
+        m_is_and(is_and),
+        m_costs(operands.size()),
+        m_candidates(operands.size(), 0.0),
+        m_passed(operands.size(), 0.0),
+        m_order(operands.size()),
+        m_evals_since_planned(0)
+    {
+        for (unsigned int i = 0; i < operands.size(); ++i) {
+            m_costs[i] = EstimatedCost(operands[i]);
+            m_order[i] = i;
+        }
+        Plan();
+    }
+
+    /** Returns the indices of the operands in the order they should be
+      * evaluated. */
+    std::vector<unsigned int> Order() const {
+        boost::mutex::scoped_lock lock(m_mutex);
+        return m_order;
+    }
+
+    /** Adds the number of candidates on which each operand was evaluated, and
+      * how many of them passed, to the statistics used for planning. */
+    void Record(const std::vector<unsigned int>& operands, const std::vector<std::size_t>& candidates,
+                const std::vector<std::size_t>& passed)
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        for (unsigned int i = 0; i < operands.size(); ++i) {
+            m_candidates[operands[i]] += candidates[i];
+            m_passed[operands[i]] += passed[i];
+        }
+        if (++m_evals_since_planned >= EVALS_PER_PLAN) {
+            m_evals_since_planned = 0;
+            Plan();
+        }
+    }
+
+private:
+    struct RankLess {
+        RankLess(const std::vector<double>& ranks) : m_ranks(ranks) {}
+        bool operator()(unsigned int lhs, unsigned int rhs) const
+        { return m_ranks[lhs] < m_ranks[rhs]; }
+        const std::vector<double>& m_ranks;
+    };
+
+    double PassFraction(unsigned int operand) const
+    { return (m_passed[operand] + 1.0) / (m_candidates[operand] + 2.0); }
+
+    void Plan() {
+        std::vector<double> ranks(m_costs.size());
+        for (unsigned int i = 0; i < m_costs.size(); ++i) {
+            double removed_fraction = m_is_and ? 1.0 - PassFraction(i) : PassFraction(i);
+            ranks[i] = m_costs[i] / std::max(removed_fraction, 0.01);
+        }
+
+        std::vector<unsigned int> order(m_order);
+        std::stable_sort(order.begin(), order.end(), RankLess(ranks));
+        if (order == m_order)
+            return;
+        m_order.swap(order);
+
+        if (GetOptionsDB().Get<bool>("verbose-logging")) {
+            std::stringstream ss;
+            for (unsigned int i = 0; i < m_order.size(); ++i)
+                ss << " " << m_order[i] << " (cost " << m_costs[m_order[i]]
+                   << ", passed " << PassFraction(m_order[i]) << ")";
+            DebugLogger() << (m_is_and ? "And" : "Or") << " condition operand order:" << ss.str();
+        }
+    }
+
+    const bool                  m_is_and;
+    std::vector<double>         m_costs;
+    std::vector<double>         m_candidates;
+    std::vector<double>         m_passed;
+    std::vector<unsigned int>   m_order;
+    unsigned int                m_evals_since_planned;
+    mutable boost::mutex        m_mutex;
+};
+
+namespace {
+    /** Which objects an operand has been evaluated on, and which of those it
+      * matched, indexed by ObjectIDBit(). */
+    struct OperandMatches {
+        boost::dynamic_bitset<>     evaluated;
+        boost::dynamic_bitset<>     matched;
+    };
+
+    /** The operand matches remembered while a ScopedOperandMatchesCache
+      * exists.  Entries are indexed by the operand's structural hash and the
+      * source object id, or INVALID_OBJECT_ID for source invariant operands,
+      * and are replaced rather than modified, so that evaluations on other
+      * threads can keep using the entry they found. */
+    class OperandMatchesCache {
+    public:
+        boost::shared_ptr<const OperandMatches> Find(const Condition::ConditionBase* operand, int source_id) const {
+            boost::shared_lock<boost::shared_mutex> guard(m_mutex);
+            std::pair<EntryMap::const_iterator, EntryMap::const_iterator> range =
+                m_entries.equal_range(std::make_pair(operand->StructuralHash(), source_id));
+            for (EntryMap::const_iterator it = range.first; it != range.second; ++it) {
+                if (*it->second.first == *operand)
+                    return it->second.second;
+            }
+            return boost::shared_ptr<const OperandMatches>();
+        }
+
+        void Store(const Condition::ConditionBase* operand, int source_id,
+                   boost::shared_ptr<const OperandMatches> matches)
+        {
+            boost::unique_lock<boost::shared_mutex> guard(m_mutex);
+            std::pair<std::size_t, int> key(operand->StructuralHash(), source_id);
+            std::pair<EntryMap::iterator, EntryMap::iterator> range = m_entries.equal_range(key);
+            for (EntryMap::iterator it = range.first; it != range.second; ++it) {
+                if (*it->second.first == *operand) {
+                    it->second.second = matches;
+                    return;
+                }
+            }
+            m_entries.insert(std::make_pair(key, std::make_pair(operand, matches)));
+        }
+
+    private:
+        typedef std::multimap<std::pair<std::size_t, int>,
+                              std::pair<const Condition::ConditionBase*,
+                                        boost::shared_ptr<const OperandMatches> > > EntryMap;
+
+        EntryMap                        m_entries;
+        mutable boost::shared_mutex     m_mutex;
+    };
+
+    OperandMatchesCache* operand_matches_cache = 0;
+
+    /** Returns true if whether \a condition matches a candidate does not
+      * depend on which other candidates it is evaluated with, or on chance.
+      * SortedNumberOf picks from all its candidates, so its matches and those
+      * of the conditions combining it do. */
+    bool MatchesCandidatesIndependently(const Condition::ConditionBase* condition) {
+        if (!condition)
+            return true;
+        if (!condition->Deterministic())
+            return false;
+        if (dynamic_cast<const Condition::SortedNumberOf*>(condition))
+            return false;
+        if (const Condition::And* and_condition = dynamic_cast<const Condition::And*>(condition)) {
+            const std::vector<Condition::ConditionBase*>& operands = and_condition->Operands();
+            for (unsigned int i = 0; i < operands.size(); ++i)
+                if (!MatchesCandidatesIndependently(operands[i]))
+                    return false;
+        } else if (const Condition::Or* or_condition = dynamic_cast<const Condition::Or*>(condition)) {
+            const std::vector<Condition::ConditionBase*>& operands = or_condition->Operands();
+            for (unsigned int i = 0; i < operands.size(); ++i)
+                if (!MatchesCandidatesIndependently(operands[i]))
+                    return false;
+        } else if (const Condition::Not* not_condition = dynamic_cast<const Condition::Not*>(condition)) {
+            return MatchesCandidatesIndependently(not_condition->Operand());
+        } else if (const Condition::Described* described = dynamic_cast<const Condition::Described*>(condition)) {
+            return MatchesCandidatesIndependently(described->SubCondition());
+        }
+        return true;
+    }
+
+    /** Evaluates And operand \a operand like ConditionBase::Eval, but takes
+      * the result for objects it was already evaluated on from the operand
+      * matches cache, if there is one and the operand's matches can be reused,
+      * and remembers the result for the other objects. */
+    void EvalOperand(const Condition::ConditionBase* operand, const ScriptingContext& context,
+                     Condition::ObjectSet& matches, Condition::ObjectSet& non_matches,
+                     Condition::SearchDomain search_domain)
+    {
+        if (!operand_matches_cache || !operand->StructuralHashKnown() ||
+            !operand->RootCandidateInvariant() || !operand->TargetInvariant())
+        {
+            operand->Eval(context, matches, non_matches, search_domain);
+            return;
+        }
+
+        int source_id = INVALID_OBJECT_ID;
+        if (!operand->SourceInvariant()) {
+            if (!context.source) {
+                operand->Eval(context, matches, non_matches, search_domain);
+                return;
+            }
+            source_id = context.source->ID();
+        }
+
+        boost::shared_ptr<const OperandMatches> cached = operand_matches_cache->Find(operand, source_id);
+
+        // move objects with a cached result like EvalImpl does, and set aside
+        // the others to be evaluated
+        Condition::ObjectSet& from_set = search_domain == Condition::MATCHES ? matches : non_matches;
+        Condition::ObjectSet& to_set = search_domain == Condition::MATCHES ? non_matches : matches;
+        Condition::ObjectSet unknown_non_matches;
+        for (Condition::ObjectSet::iterator it = from_set.begin(); it != from_set.end(); ) {
+            std::size_t bit = ObjectIDBit((*it)->ID());
+            if (!cached || bit >= cached->evaluated.size() || !cached->evaluated[bit]) {
+                unknown_non_matches.push_back(*it);
+            } else if (cached->matched[bit] != (search_domain == Condition::MATCHES)) {
+                to_set.push_back(*it);
+            } else {
+                ++it;
+                continue;
+            }
+            *it = from_set.back();
+            from_set.pop_back();
+        }
+        if (unknown_non_matches.empty())
+            return;
+
+        Condition::ObjectSet unknown_matches;
+        unknown_matches.reserve(unknown_non_matches.size());
+        operand->Eval(context, unknown_matches, unknown_non_matches, Condition::NON_MATCHES);
+
+        boost::shared_ptr<OperandMatches> updated(cached ? new OperandMatches(*cached) : new OperandMatches);
+        std::size_t bitset_size = std::max(updated->evaluated.size(),
+                                           std::max(ObjectIDBitsetSize(unknown_matches),
+                                                    ObjectIDBitsetSize(unknown_non_matches)));
+        updated->evaluated.resize(bitset_size);
+        updated->matched.resize(bitset_size);
+        SetObjectIDBits(unknown_matches, updated->evaluated);
+        SetObjectIDBits(unknown_non_matches, updated->evaluated);
+        SetObjectIDBits(unknown_matches, updated->matched);
+        operand_matches_cache->Store(operand, source_id, updated);
+
+        matches.insert(matches.end(), unknown_matches.begin(), unknown_matches.end());
+        non_matches.insert(non_matches.end(), unknown_non_matches.begin(), unknown_non_matches.end());
+    }
+}
+
+///////////////////////////////////////////////////////////
+// ScopedOperandMatchesCache                             //
+///////////////////////////////////////////////////////////
+Condition::ScopedOperandMatchesCache::ScopedOperandMatchesCache() :
+    m_owner(!operand_matches_cache)
+{
+    if (m_owner)
+        operand_matches_cache = new OperandMatchesCache;
+    else
+        ErrorLogger() << "ScopedOperandMatchesCache created while another one exists";
+}
+
+Condition::ScopedOperandMatchesCache::~ScopedOperandMatchesCache() {
+    if (m_owner) {
+        delete operand_matches_cache;
+        operand_matches_cache = 0;
+    }
+}
+
+void Condition::ScopedOperandMatchesCache::PrepareCondition(const ConditionBase* condition) {
+    if (const And* and_condition = dynamic_cast<const And*>(condition)) {
+        const std::vector<ConditionBase*>& operands = and_condition->Operands();
+        for (unsigned int i = 0; i < operands.size(); ++i) {
+            if (!operands[i])
+                continue;
+            if (MatchesCandidatesIndependently(operands[i]))
+                operands[i]->StructuralHash();
+            PrepareCondition(operands[i]);
+        }
+    } else if (const Or* or_condition = dynamic_cast<const Or*>(condition)) {
+        const std::vector<ConditionBase*>& operands = or_condition->Operands();
+        for (unsigned int i = 0; i < operands.size(); ++i)
+            PrepareCondition(operands[i]);
+    } else if (const Not* not_condition = dynamic_cast<const Not*>(condition)) {
+        PrepareCondition(not_condition->Operand());
+    } else if (const Described* described = dynamic_cast<const Described*>(condition)) {
+        PrepareCondition(described->SubCondition());
+    }
+}
+
 ///////////////////////////////////////////////////////////
 // And                                                   //
 ///////////////////////////////////////////////////////////
+Condition::And::And(const std::vector<ConditionBase*>& operands) :
+    ConditionBase(),
+    m_operands(operands),
+    m_plan(new OperandPlan(operands, true))
+{}
+
 Condition::And::~And() {
     for (unsigned int i = 0; i < m_operands.size(); ++i)
         delete m_operands[i];
@@ -8032,18 +8602,29 @@ void Condition::And::Eval(const ScriptingContext& parent_context, ObjectSet& mat
         }
     }
 
+    // evaluate operands in planned order, recording how many candidates each
+    // one was evaluated on and passed
+    std::vector<unsigned int> order = m_plan->Order();
+    std::vector<std::size_t> candidates, passed;
+    candidates.reserve(order.size());
+    passed.reserve(order.size());
+
     if (search_domain == NON_MATCHES) {
         ObjectSet partly_checked_non_matches;
         partly_checked_non_matches.reserve(non_matches.size());
 
         // move items in non_matches set that pass first operand condition into
         // partly_checked_non_matches set
-        m_operands[0]->Eval(local_context, partly_checked_non_matches, non_matches, NON_MATCHES);
+        candidates.push_back(non_matches.size());
+        EvalOperand(m_operands[order[0]], local_context, partly_checked_non_matches, non_matches, NON_MATCHES);
+        passed.push_back(partly_checked_non_matches.size());
 
         // move items that don't pass one of the other conditions back to non_matches
-        for (unsigned int i = 1; i < m_operands.size(); ++i) {
+        for (unsigned int i = 1; i < order.size(); ++i) {
             if (partly_checked_non_matches.empty()) break;
-            m_operands[i]->Eval(local_context, partly_checked_non_matches, non_matches, MATCHES);
+            candidates.push_back(partly_checked_non_matches.size());
+            EvalOperand(m_operands[order[i]], local_context, partly_checked_non_matches, non_matches, MATCHES);
+            passed.push_back(partly_checked_non_matches.size());
         }
 
         // merge items that passed all operand conditions into matches
@@ -8056,14 +8637,19 @@ void Condition::And::Eval(const ScriptingContext& parent_context, ObjectSet& mat
         // check all operand conditions on all objects in the matches set, moving those
         // that don't pass a condition to the non-matches set
 
-        for (unsigned int i = 0; i < m_operands.size(); ++i) {
+        for (unsigned int i = 0; i < order.size(); ++i) {
             if (matches.empty()) break;
-            m_operands[i]->Eval(local_context, matches, non_matches, MATCHES);
+            candidates.push_back(matches.size());
+            EvalOperand(m_operands[order[i]], local_context, matches, non_matches, MATCHES);
+            passed.push_back(matches.size());
         }
 
         // items already in non_matches set are not checked, and remain in non_matches set
         // even if they pass all operand conditions
     }
+
+    order.resize(candidates.size());
+    m_plan->Record(order, candidates, passed);
 }
 
 bool Condition::And::RootCandidateInvariant() const {
@@ -8114,6 +8700,16 @@ bool Condition::And::SourceInvariant() const {
     return true;
 }
 
+bool Condition::And::Deterministic() const {
+    for (std::vector<ConditionBase*>::const_iterator it = m_operands.begin();
+         it != m_operands.end(); ++it)
+    {
+        if (*it && !(*it)->Deterministic())
+            return false;
+    }
+    return true;
+}
+
 std::string Condition::And::Description(bool negated/* = false*/) const {
     if (m_operands.size() == 1) {
         return m_operands[0]->Description();
@@ -8142,11 +8738,78 @@ std::string Condition::And::Dump() const {
 }
 
 void Condition::And::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context, Condition::ObjectSet& condition_non_targets) const {
-    if (!Operands().empty()) {
-        Operands()[0]->GetDefaultInitialCandidateObjects(parent_context, condition_non_targets); //gets condition_non_targets from first operand condition
-    } else {
+    if (Operands().empty()) {
         ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
     }
+
+    // any object that matches all operands is among the initial candidates
+    // of each of them.  collect the candidate sets of operands that restrict
+    // them to fewer than all objects...
+    std::size_t num_objects = Objects().NumExistingObjects();
+    std::vector<Condition::ObjectSet> operand_candidates;
+    unsigned int smallest = 0;
+    for (unsigned int i = 0; i < Operands().size(); ++i) {
+        if (!Operands()[i]->RestrictsInitialCandidates())
+            continue;
+        Condition::ObjectSet candidates;
+        Operands()[i]->GetDefaultInitialCandidateObjects(parent_context, candidates);
+        if (candidates.empty())
+            return;
+        if (candidates.size() >= num_objects)
+            continue;
+        // if there are only a few candidates, testing them against the other
+        // operands is cheaper than collecting and intersecting more sets
+        if (candidates.size() <= FEW_INITIAL_CANDIDATES) {
+            condition_non_targets.insert(condition_non_targets.end(), candidates.begin(), candidates.end());
+            return;
+        }
+        if (!operand_candidates.empty() && candidates.size() < operand_candidates[smallest].size())
+            smallest = operand_candidates.size();
+        operand_candidates.push_back(Condition::ObjectSet());
+        operand_candidates.back().swap(candidates);
+    }
+
+    if (operand_candidates.empty()) {
+        ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+    const Condition::ObjectSet& smallest_candidates = operand_candidates[smallest];
+    if (operand_candidates.size() == 1) {
+        condition_non_targets.insert(condition_non_targets.end(), smallest_candidates.begin(), smallest_candidates.end());
+        return;
+    }
+
+    // ...intersect the others as bitsets of object ids, and keep the objects
+    // of the smallest set that are in the intersection
+    std::size_t num_bits = ObjectIDBitsetSize(smallest_candidates);
+    boost::dynamic_bitset<> common_bits;
+    for (unsigned int i = 0; i < operand_candidates.size(); ++i) {
+        if (i == smallest)
+            continue;
+        boost::dynamic_bitset<> bits(std::max(num_bits, ObjectIDBitsetSize(operand_candidates[i])));
+        SetObjectIDBits(operand_candidates[i], bits);
+        bits.resize(num_bits);
+        if (common_bits.empty())
+            common_bits.swap(bits);
+        else
+            common_bits &= bits;
+        if (common_bits.none())
+            return;
+    }
+
+    condition_non_targets.reserve(condition_non_targets.size() + common_bits.count());
+    for (Condition::ObjectSet::const_iterator it = smallest_candidates.begin(); it != smallest_candidates.end(); ++it) {
+        if (common_bits.test(ObjectIDBit((*it)->ID())))
+            condition_non_targets.push_back(*it);
+    }
+}
+
+bool Condition::And::RestrictsInitialCandidates() const {
+    for (unsigned int i = 0; i < Operands().size(); ++i)
+        if (Operands()[i]->RestrictsInitialCandidates())
+            return true;
+    return false;
 }
 
 void Condition::And::SetTopLevelContent(const std::string& content_name) {
@@ -8160,6 +8823,12 @@ void Condition::And::SetTopLevelContent(const std::string& content_name) {
 ///////////////////////////////////////////////////////////
 // Or                                                    //
 ///////////////////////////////////////////////////////////
+Condition::Or::Or(const std::vector<ConditionBase*>& operands) :
+    ConditionBase(),
+    m_operands(operands),
+    m_plan(new OperandPlan(operands, false))
+{}
+
 Condition::Or::~Or() {
     for (unsigned int i = 0; i < m_operands.size(); ++i)
         delete m_operands[i];
@@ -8199,14 +8868,23 @@ void Condition::Or::Eval(const ScriptingContext& parent_context, ObjectSet& matc
         }
     }
 
+    // evaluate operands in planned order, recording how many candidates each
+    // one was evaluated on and passed
+    std::vector<unsigned int> order = m_plan->Order();
+    std::vector<std::size_t> candidates, passed;
+    candidates.reserve(order.size());
+    passed.reserve(order.size());
+
     if (search_domain == NON_MATCHES) {
         // check each item in the non-matches set against each of the operand conditions
         // if a non-candidate item matches an operand condition, move the item to the
         // matches set.
 
-        for (unsigned int i = 0; i < m_operands.size(); ++i) {
+        for (unsigned int i = 0; i < order.size(); ++i) {
             if (non_matches.empty()) break;
-            m_operands[i]->Eval(local_context, matches, non_matches, NON_MATCHES);
+            candidates.push_back(non_matches.size());
+            m_operands[order[i]]->Eval(local_context, matches, non_matches, NON_MATCHES);
+            passed.push_back(candidates.back() - non_matches.size());
         }
 
         // items already in matches set are not checked and remain in the
@@ -8218,12 +8896,16 @@ void Condition::Or::Eval(const ScriptingContext& parent_context, ObjectSet& matc
 
         // move items in matches set the fail the first operand condition into 
         // partly_checked_matches set
-        m_operands[0]->Eval(local_context, matches, partly_checked_matches, MATCHES);
+        candidates.push_back(matches.size());
+        m_operands[order[0]]->Eval(local_context, matches, partly_checked_matches, MATCHES);
+        passed.push_back(matches.size());
 
         // move items that pass any of the other conditions back into matches
-        for (unsigned int i = 1; i < m_operands.size(); ++i) {
+        for (unsigned int i = 1; i < order.size(); ++i) {
             if (partly_checked_matches.empty()) break;
-            m_operands[i]->Eval(local_context, matches, partly_checked_matches, NON_MATCHES);
+            candidates.push_back(partly_checked_matches.size());
+            m_operands[order[i]]->Eval(local_context, matches, partly_checked_matches, NON_MATCHES);
+            passed.push_back(candidates.back() - partly_checked_matches.size());
         }
 
         // merge items that failed all operand conditions into non_matches
@@ -8233,6 +8915,49 @@ void Condition::Or::Eval(const ScriptingContext& parent_context, ObjectSet& matc
         // non_matches set even if they pass one or more of the operand 
         // conditions
     }
+
+    order.resize(candidates.size());
+    m_plan->Record(order, candidates, passed);
+}
+
+void Condition::Or::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context, Condition::ObjectSet& condition_non_targets) const {
+    // any object that matches an operand is among the initial candidates of
+    // that operand, so take the union of those sets, using a bitset of
+    // object ids to add each object only once
+    if (!RestrictsInitialCandidates()) {
+        ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+    std::size_t num_objects = Objects().NumExistingObjects();
+    std::vector<Condition::ObjectSet> operand_candidates(Operands().size());
+    std::size_t num_bits = 0;
+    for (unsigned int i = 0; i < Operands().size(); ++i) {
+        Operands()[i]->GetDefaultInitialCandidateObjects(parent_context, operand_candidates[i]);
+        if (operand_candidates[i].size() >= num_objects) {
+            ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+            return;
+        }
+        num_bits = std::max(num_bits, ObjectIDBitsetSize(operand_candidates[i]));
+    }
+
+    boost::dynamic_bitset<> added_bits(num_bits);
+    for (unsigned int i = 0; i < operand_candidates.size(); ++i) {
+        const Condition::ObjectSet& candidates = operand_candidates[i];
+        for (Condition::ObjectSet::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
+            std::size_t bit = ObjectIDBit((*it)->ID());
+            if (added_bits.test(bit))
+                continue;
+            added_bits.set(bit);
+            condition_non_targets.push_back(*it);
+        }
+    }
+}
+
+bool Condition::Or::RestrictsInitialCandidates() const {
+    for (unsigned int i = 0; i < Operands().size(); ++i)
+        if (!Operands()[i]->RestrictsInitialCandidates())
+            return false;
+    return true;
 }
 
 bool Condition::Or::RootCandidateInvariant() const {
@@ -8283,6 +9008,16 @@ bool Condition::Or::SourceInvariant() const {
     return true;
 }
 
+bool Condition::Or::Deterministic() const {
+    for (std::vector<ConditionBase*>::const_iterator it = m_operands.begin();
+         it != m_operands.end(); ++it)
+    {
+        if (*it && !(*it)->Deterministic())
+            return false;
+    }
+    return true;
+}
+
 std::string Condition::Or::Description(bool negated/* = false*/) const {
     if (m_operands.size() == 1) {
         return m_operands[0]->Description();
@@ -8380,6 +9115,9 @@ bool Condition::Not::SourceInvariant() const {
     return m_source_invariant == INVARIANT;
 }
 
+bool Condition::Not::Deterministic() const
+{ return !m_operand || m_operand->Deterministic(); }
+
 std::string Condition::Not::Description(bool negated/* = false*/) const
 { return m_operand->Description(true); }
 
@@ -8449,6 +9187,9 @@ bool Condition::Described::TargetInvariant() const
 bool Condition::Described::SourceInvariant() const
 { return !m_condition || m_condition->SourceInvariant(); }
 
+bool Condition::Described::Deterministic() const
+{ return !m_condition || m_condition->Deterministic(); }
+
 void Condition::Described::SetTopLevelContent(const std::string& content_name) {
     if (m_condition)
         m_condition->SetTopLevelContent(content_name);
@@ -10,6 +10,7 @@
 
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <string>
 #include <vector>
@@ -110,6 +111,8 @@ namespace Condition {
     struct ValueTest;
     struct Location;
     struct Described;
+    struct OperandPlan;
+    class ScopedOperandMatchesCache;
 }
 
 /** Returns a single string which describes a vector of Conditions. If multiple
@@ -130,7 +133,9 @@ struct FO_COMMON_API Condition::ConditionBase {
     ConditionBase() :
         m_root_candidate_invariant(UNKNOWN_INVARIANCE),
         m_target_invariant(UNKNOWN_INVARIANCE),
-        m_source_invariant(UNKNOWN_INVARIANCE)
+        m_source_invariant(UNKNOWN_INVARIANCE),
+        m_structural_hash(0),
+        m_structural_hash_known(false)
     {}
     virtual ~ConditionBase();
 
@@ -165,6 +170,12 @@ struct FO_COMMON_API Condition::ConditionBase {
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
 
+    /** Returns true if GetDefaultInitialCandidateObjects() may return fewer
+      * than all existing objects, or false if it always returns all of them,
+      * so that callers combining the candidates of several conditions can
+      * skip collecting them. */
+    virtual bool        RestrictsInitialCandidates() const { return false; }
+
     /** Returns true iff this condition's evaluation does not reference
       * the RootCandidate objects.  This requirement ensures that if this
       * condition is a subcondition to another Condition or a ValueRef, this
@@ -186,9 +197,22 @@ struct FO_COMMON_API Condition::ConditionBase {
       * source object.*/
     virtual bool        SourceInvariant() const { return false; }
 
+    /** Returns true iff evaluating this condition again in the same context
+      * always matches the same objects, which is not the case for Random. */
+    virtual bool        Deterministic() const { return true; }
+
     virtual std::string Description(bool negated = false) const = 0;
     virtual std::string Dump() const = 0;
 
+    /** Returns a hash of the structure of this condition, which is the same
+      * for conditions that are equal.  It is computed from Dump() on the
+      * first call and then cached, so the first call should not be made
+      * concurrently with any other use of Dump(). */
+    std::size_t         StructuralHash() const;
+
+    /** Returns true if StructuralHash() has already been computed. */
+    bool                StructuralHashKnown() const { return m_structural_hash_known; }
+
     virtual void        SetTopLevelContent(const std::string& content_name) = 0;
 
 protected:
@@ -200,6 +224,9 @@ private:
     struct MatchHelper;
     friend struct MatchHelper;
 
+    mutable std::size_t m_structural_hash;
+    mutable bool        m_structural_hash_known;
+
     virtual bool        Match(const ScriptingContext& local_context) const;
 
     friend class boost::serialization::access;
@@ -226,6 +253,7 @@ struct FO_COMMON_API Condition::Number : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const ValueRef::ValueRefBase<int>*  Low() const { return m_low; }
@@ -317,6 +345,7 @@ struct FO_COMMON_API Condition::SortedNumberOf : public Condition::ConditionBase
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const ValueRef::ValueRefBase<int>*      Number() const { return m_number; }
@@ -325,6 +354,7 @@ struct FO_COMMON_API Condition::SortedNumberOf : public Condition::ConditionBase
     const ConditionBase*                    GetCondition() const { return m_condition; }
     virtual void                            GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                                               Condition::ObjectSet& condition_non_targets) const;
+    virtual bool                            RestrictsInitialCandidates() const;
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
@@ -385,6 +415,9 @@ struct FO_COMMON_API Condition::EmpireAffiliation : public Condition::ConditionB
     virtual bool        SourceInvariant() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
+    virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                          Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     const ValueRef::ValueRefBase<int>*  EmpireID() const { return m_empire_id; }
     EmpireAffiliationType               GetAffiliation() const { return m_affiliation; }
@@ -413,6 +446,7 @@ struct FO_COMMON_API Condition::Source : public Condition::ConditionBase {
     virtual std::string Dump() const;
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name) {}
 
@@ -461,6 +495,7 @@ struct FO_COMMON_API Condition::Target : public Condition::ConditionBase {
     virtual std::string Dump() const;
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name) {}
 
@@ -498,6 +533,7 @@ struct FO_COMMON_API Condition::Homeworld : public Condition::ConditionBase {
     const std::vector<ValueRef::ValueRefBase<std::string>*>   Names() const { return m_names; }
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
@@ -522,6 +558,7 @@ struct FO_COMMON_API Condition::Capital : public Condition::ConditionBase {
     virtual std::string Dump() const;
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name) {}
 
@@ -544,6 +581,7 @@ struct FO_COMMON_API Condition::Monster : public Condition::ConditionBase {
     virtual std::string Dump() const;
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name) {}
 
@@ -595,6 +633,7 @@ struct FO_COMMON_API Condition::Type : public Condition::ConditionBase {
     const ValueRef::ValueRefBase<UniverseObjectType>*   GetType() const { return m_type; }
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
@@ -629,6 +668,7 @@ struct FO_COMMON_API Condition::Building : public Condition::ConditionBase {
     const std::vector<ValueRef::ValueRefBase<std::string>*>   Names() const { return m_names; }
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
@@ -684,6 +724,9 @@ struct FO_COMMON_API Condition::HasSpecial : public Condition::ConditionBase {
     virtual bool        SourceInvariant() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
+    virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                          Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
     const ValueRef::ValueRefBase<std::string>*  Name() const { return m_name; }
     const ValueRef::ValueRefBase<double>*       CapacityLow() const { return m_capacity_low; }
     const ValueRef::ValueRefBase<double>*       CapacityHigh() const { return m_capacity_high; }
@@ -725,6 +768,9 @@ struct FO_COMMON_API Condition::HasTag : public Condition::ConditionBase {
     virtual bool        SourceInvariant() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
+    virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                          Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     ValueRef::ValueRefBase<std::string>*    Name() const { return m_name; }
 
@@ -791,11 +837,13 @@ struct FO_COMMON_API Condition::Contains : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const ConditionBase*GetCondition() const { return m_condition; }
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
@@ -826,6 +874,7 @@ struct FO_COMMON_API Condition::ContainedBy : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const ConditionBase*GetCondition() const { return m_condition; }
@@ -859,6 +908,9 @@ struct FO_COMMON_API Condition::InSystem : public Condition::ConditionBase {
     virtual bool        SourceInvariant() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
+    virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                          Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
     const ValueRef::ValueRefBase<int>*  SystemId() const { return m_system_id; }
 
     virtual void        SetTopLevelContent(const std::string& content_name);
@@ -893,6 +945,7 @@ struct FO_COMMON_API Condition::ObjectID : public Condition::ConditionBase {
     const ValueRef::ValueRefBase<int>*  ObjectId() const { return m_object_id; }
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
@@ -928,6 +981,7 @@ struct FO_COMMON_API Condition::PlanetType : public Condition::ConditionBase {
     const std::vector<ValueRef::ValueRefBase< ::PlanetType>*>&    Types() const { return m_types; }
     void                GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
@@ -963,6 +1017,7 @@ struct FO_COMMON_API Condition::PlanetSize : public Condition::ConditionBase {
     const std::vector<ValueRef::ValueRefBase< ::PlanetSize>*>&    Sizes() const { return m_sizes; }
     void                GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
@@ -1000,6 +1055,7 @@ struct FO_COMMON_API Condition::PlanetEnvironment : public Condition::ConditionB
     const std::vector<ValueRef::ValueRefBase< ::PlanetEnvironment>*>& Environments() const { return m_environments; }
     void                GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
@@ -1037,6 +1093,9 @@ struct FO_COMMON_API Condition::Species : public Condition::ConditionBase {
     virtual bool        SourceInvariant() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
+    virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                          Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const { return true; }
     const std::vector<ValueRef::ValueRefBase<std::string>*>&  Names() const { return m_names; }
 
     virtual void        SetTopLevelContent(const std::string& content_name);
@@ -1406,6 +1465,7 @@ struct FO_COMMON_API Condition::Chance : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const { return false; }
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const ValueRef::ValueRefBase<double>*   GetChance() const { return m_chance; }
@@ -1737,6 +1797,7 @@ struct FO_COMMON_API Condition::WithinDistance : public Condition::ConditionBase
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
 
@@ -1772,6 +1833,7 @@ struct FO_COMMON_API Condition::WithinStarlaneJumps : public Condition::Conditio
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
 
@@ -1808,6 +1870,7 @@ struct FO_COMMON_API Condition::CanAddStarlaneConnection :  Condition::Condition
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
 
@@ -1924,6 +1987,7 @@ struct FO_COMMON_API Condition::ResourceSupplyConnectedByEmpire : public Conditi
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
 
@@ -1996,6 +2060,7 @@ struct FO_COMMON_API Condition::OrderedBombarded : public Condition::ConditionBa
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
 
@@ -2092,10 +2157,7 @@ private:
 
 /** Matches all objects that match every Condition in \a operands. */
 struct FO_COMMON_API Condition::And : public Condition::ConditionBase {
-    And(const std::vector<ConditionBase*>& operands) :
-        ConditionBase(),
-        m_operands(operands)
-    {}
+    And(const std::vector<ConditionBase*>& operands);
     virtual ~And();
     virtual bool        operator==(const Condition::ConditionBase& rhs) const;
     virtual void        Eval(const ScriptingContext& parent_context, Condition::ObjectSet& matches,
@@ -2105,16 +2167,19 @@ struct FO_COMMON_API Condition::And : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const std::vector<ConditionBase*>&
                         Operands() const { return m_operands; }
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context, Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const;
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
 private:
-    std::vector<ConditionBase*> m_operands;
+    std::vector<ConditionBase*>     m_operands;
+    boost::shared_ptr<OperandPlan>  m_plan;     ///< order in which to evaluate m_operands
 
     friend class boost::serialization::access;
     template <class Archive>
@@ -2123,10 +2188,7 @@ private:
 
 /** Matches all objects that match at least one Condition in \a operands. */
 struct FO_COMMON_API Condition::Or : public Condition::ConditionBase {
-    Or(const std::vector<ConditionBase*>& operands) :
-        ConditionBase(),
-        m_operands(operands)
-    {}
+    Or(const std::vector<ConditionBase*>& operands);
     virtual ~Or();
     virtual bool        operator==(const Condition::ConditionBase& rhs) const;
     virtual void        Eval(const ScriptingContext& parent_context, Condition::ObjectSet& matches,
@@ -2136,15 +2198,19 @@ struct FO_COMMON_API Condition::Or : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const std::vector<ConditionBase*>&
                         Operands() const { return m_operands; }
+    virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context, Condition::ObjectSet& condition_non_targets) const;
+    virtual bool        RestrictsInitialCandidates() const;
 
     virtual void        SetTopLevelContent(const std::string& content_name);
 
 private:
-    std::vector<ConditionBase*> m_operands;
+    std::vector<ConditionBase*>     m_operands;
+    boost::shared_ptr<OperandPlan>  m_plan;     ///< order in which to evaluate m_operands
 
     friend class boost::serialization::access;
     template <class Archive>
@@ -2166,6 +2232,7 @@ struct FO_COMMON_API Condition::Not : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const ConditionBase*Operand() const { return m_operand; }
@@ -2197,6 +2264,7 @@ struct FO_COMMON_API Condition::Described : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual bool        Deterministic() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const                    { return m_condition ? m_condition->Dump() : ""; }
     const ConditionBase*SubCondition() const            { return m_condition; }
@@ -2213,6 +2281,31 @@ private:
     void serialize(Archive& ar, const unsigned int version);
 };
 
+/** While an instance of this class exists, And conditions remember which
+  * objects their root candidate and target invariant operands matched, and
+  * reuse those matches when an operand structurally equal to one evaluated
+  * before is evaluated again for the same source object, or for any source if
+  * the operand is source invariant.  The objects in the universe must not
+  * change while an instance exists, and only one instance may exist at a
+  * time. */
+class FO_COMMON_API Condition::ScopedOperandMatchesCache {
+public:
+    ScopedOperandMatchesCache();
+    ~ScopedOperandMatchesCache();
+
+    /** Computes the structural hashes of the And operands within \a condition
+      * whose matches can be reused.  Operands are only looked up if their hash
+      * is known, and since the hash is computed from Dump(), this must be
+      * called before \a condition is evaluated on other threads. */
+    static void PrepareCondition(const ConditionBase* condition);
+
+private:
+    ScopedOperandMatchesCache(const ScopedOperandMatchesCache&);
+    ScopedOperandMatchesCache& operator=(const ScopedOperandMatchesCache&);
+
+    bool m_owner;
+};
+
 // template implementations
 template <class Archive>
 void Condition::ConditionBase::serialize(Archive& ar, const unsigned int version)
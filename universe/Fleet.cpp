@@ -223,10 +223,65 @@ const std::list<int>& Fleet::TravelRoute() const {
     return m_travel_route;
 }
 
+Fleet::MovePathInputs::MovePathInputs() :
+    route(),
+    flag_blockades(false),
+    turn(INVALID_GAME_TURN),
+    x(0.0),
+    y(0.0),
+    system_id(INVALID_OBJECT_ID),
+    prev_system_id(INVALID_OBJECT_ID),
+    next_system_id(INVALID_OBJECT_ID),
+    arrival_starlane(INVALID_OBJECT_ID),
+    speed(0.0f),
+    fuel(0.0f),
+    max_fuel(0.0f)
+{}
+
+Fleet::MovePathInputs::MovePathInputs(const Fleet& fleet, const std::list<int>& route_, bool flag_blockades_) :
+    route(route_),
+    flag_blockades(flag_blockades_),
+    turn(CurrentTurn()),
+    x(fleet.X()),
+    y(fleet.Y()),
+    system_id(fleet.SystemID()),
+    prev_system_id(fleet.m_prev_system),
+    next_system_id(fleet.m_next_system),
+    arrival_starlane(fleet.m_arrival_starlane),
+    speed(fleet.Speed()),
+    fuel(fleet.Fuel()),
+    max_fuel(fleet.MaxFuel())
+{}
+
+bool Fleet::MovePathInputs::operator==(const MovePathInputs& rhs) const {
+    // paths calculated outside of a game aren't reused
+    if (turn == INVALID_GAME_TURN || rhs.turn == INVALID_GAME_TURN)
+        return false;
+    return turn == rhs.turn &&
+           flag_blockades == rhs.flag_blockades &&
+           x == rhs.x && y == rhs.y &&
+           system_id == rhs.system_id &&
+           prev_system_id == rhs.prev_system_id &&
+           next_system_id == rhs.next_system_id &&
+           arrival_starlane == rhs.arrival_starlane &&
+           speed == rhs.speed && fuel == rhs.fuel && max_fuel == rhs.max_fuel &&
+           route == rhs.route;
+}
+
 std::list<MovePathNode> Fleet::MovePath(bool flag_blockades /*= false*/) const
 { return MovePath(TravelRoute(), flag_blockades); }
 
 std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route, bool flag_blockades /*= false*/) const {
+    MovePathInputs inputs(*this, route, flag_blockades);
+    if (inputs == m_move_path_inputs)
+        return m_move_path;
+
+    m_move_path = CalculateMovePath(route, flag_blockades);
+    m_move_path_inputs = inputs;
+    return m_move_path;
+}
+
+std::list<MovePathNode> Fleet::CalculateMovePath(const std::list<int>& route, bool flag_blockades) const {
     std::list<MovePathNode> retval;
 
     if (route.empty())
@@ -248,12 +303,9 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route, bool flag_b
     // determine all systems where fleet(s) can be resupplied if fuel runs out
     int owner = this->Owner();
     const Empire* empire = GetEmpire(owner);
-    std::set<int> fleet_supplied_systems;
-    std::set<int> unobstructed_systems;
-    if (empire) {
-        fleet_supplied_systems = empire->FleetSupplyableSystemIDs();
-        unobstructed_systems = empire->SupplyUnobstructedSystems();
-    }
+    static const std::set<int> EMPTY_SET;
+    const std::set<int>& fleet_supplied_systems = empire ? empire->FleetSupplyableSystemIDs() : EMPTY_SET;
+    const std::set<int>& unobstructed_systems = empire ? empire->SupplyUnobstructedSystems() : EMPTY_SET;
 
     // determine if, given fuel available and supplyable systems, fleet will ever be able to move
     if (fuel < 1.0f &&
@@ -831,10 +883,8 @@ void Fleet::MovementPhase() {
     }
 
     Empire* empire = GetEmpire(fleet->Owner());
-    std::set<int> supply_unobstructed_systems;
-    if (empire)
-        supply_unobstructed_systems.insert(empire->SupplyUnobstructedSystems().begin(),
-                                           empire->SupplyUnobstructedSystems().end());
+    static const std::set<int> EMPTY_SET;
+    const std::set<int>& supply_unobstructed_systems = empire ? empire->SupplyUnobstructedSystems() : EMPTY_SET;
 
     std::vector<TemporaryPtr<Ship> > ships = Objects().FindObjects<Ship>(m_ships);
 
@@ -1213,8 +1263,8 @@ bool Fleet::BlockadedAtSystem(int start_system_id, int dest_system_id) const {
     }
 
     const Empire* empire = GetEmpire(this->Owner());
-    if (empire) {  
-        std::set<int> unobstructed_systems = empire->SupplyUnobstructedSystems();
+    if (empire) {
+        const std::set<int>& unobstructed_systems = empire->SupplyUnobstructedSystems();
         if (unobstructed_systems.find(start_system_id) != unobstructed_systems.end())
             return false;
         if (empire->UnrestrictedLaneTravel(start_system_id, dest_system_id)) {
@@ -1224,6 +1274,14 @@ bool Fleet::BlockadedAtSystem(int start_system_id, int dest_system_id) const {
         }
     }
 
+    const Universe::SystemBlockade* blockade = GetUniverse().GetSystemBlockade(start_system_id);
+    if (!blockade)
+        return false;
+
+    // perhaps should consider allies
+    if (blockade->unrestricted_owners.find(this->Owner()) != blockade->unrestricted_owners.end())
+        return false;
+
     float lowestShipStealth = 99999.9f; // arbitrary large number. actual stealth of ships should be less than this...
     std::vector<TemporaryPtr<const Ship> > ships = Objects().FindObjects<const Ship>(this->ShipIDs());
     for (std::vector<TemporaryPtr<const Ship> >::iterator it = ships.begin();
@@ -1234,55 +1292,20 @@ bool Fleet::BlockadedAtSystem(int start_system_id, int dest_system_id) const {
             lowestShipStealth = ship->CurrentMeterValue(METER_STEALTH);
     }
 
-    float monsterDetection = 0.0f;
-    std::vector<TemporaryPtr<const Fleet> > fleets =
-        Objects().FindObjects<const Fleet>(current_system->FleetIDs());
-    for (std::vector<TemporaryPtr<const Fleet> >::iterator fleet_it = fleets.begin();
-         fleet_it != fleets.end(); ++fleet_it)
+    for (std::map<int, float>::const_iterator it = blockade->blockaders.begin();
+         it != blockade->blockaders.end(); ++it)
     {
-        TemporaryPtr<const Fleet> fleet = *fleet_it;
-        if (!fleet->Unowned())
+        int blockader_id = it->first;
+        if (blockader_id == this->Owner())
             continue;
-
-        ships = Objects().FindObjects<const Ship>(fleet->ShipIDs());
-        for (std::vector<TemporaryPtr<const Ship> >::iterator ship_it = ships.begin();
-             ship_it != ships.end(); ++ship_it)
-        {
-            TemporaryPtr<const Ship> ship = *ship_it;
-            float curDetect = ship->CurrentMeterValue(METER_DETECTION);
-            if (curDetect >= monsterDetection)
-                monsterDetection = curDetect;
-        }
-    }
-
-    bool canBeBlockaded = false;
-    for (std::vector<TemporaryPtr<const Fleet> >::iterator fleet_it = fleets.begin();
-         fleet_it != fleets.end(); ++fleet_it)
-    {
-        TemporaryPtr<const Fleet> fleet = *fleet_it;
-        if (fleet->NextSystemID() != INVALID_OBJECT_ID) //fleets trying to leave this turn can't blockade pre-combat.
-            continue;
-        bool unrestricted = (fleet->m_arrival_starlane == start_system_id);
-        if  (fleet->Owner() == this->Owner()) {
-            if (unrestricted)  // perhaps should consider allies 
-                return false;
+        bool unrestricted = blockade->unrestricted_blockaders.find(blockader_id) != blockade->unrestricted_blockaders.end();
+        if (!unrestricted && !not_yet_in_system)
             continue;
-        }
-        bool can_see;
-        if (!fleet->Unowned()) {
-            can_see = (GetEmpire(fleet->Owner())->GetMeter("METER_DETECTION_STRENGTH")->Current() >= lowestShipStealth);
-        } else {
-            can_see = (monsterDetection >= lowestShipStealth);
-        }
-        bool at_war = Unowned() || fleet->Unowned() ||
-                      Empires().GetDiplomaticStatus(this->Owner(), fleet->Owner()) == DIPLO_WAR;
-        bool aggressive = (fleet->Aggressive() || fleet->Unowned());
-
-        if (aggressive && fleet->HasArmedShips() && at_war && can_see && (unrestricted || not_yet_in_system))
-            canBeBlockaded = true; // don't exit early here, because blockade may yet be thwarted by ownership & presence check above
-    }
-    if (canBeBlockaded) {
-        return true;
+        bool can_see = (it->second >= lowestShipStealth);
+        bool at_war = Unowned() || blockader_id == ALL_EMPIRES ||
+                      Empires().GetDiplomaticStatus(this->Owner(), blockader_id) == DIPLO_WAR;
+        if (at_war && can_see)
+            return true;
     }
     return false;
 }
@@ -156,6 +156,26 @@ protected:
     //@}
 
 private:
+    /** Inputs that determine the MovePath of this fleet along a route.  A
+      * MovePath is recalculated only if its inputs differ from those of the
+      * most recently calculated MovePath.  Empire supply and blockades only
+      * change between turns, so are represented by the turn number. */
+    struct MovePathInputs {
+        MovePathInputs();
+        MovePathInputs(const Fleet& fleet, const std::list<int>& route_, bool flag_blockades_);
+        bool operator==(const MovePathInputs& rhs) const;
+
+        std::list<int>  route;
+        bool            flag_blockades;
+        int             turn;
+        double          x, y;
+        int             system_id, prev_system_id, next_system_id, arrival_starlane;
+        float           speed, fuel, max_fuel;
+    };
+
+    /** Does the actual MovePath calculation, without caching. */
+    std::list<MovePathNode> CalculateMovePath(const std::list<int>& route, bool flag_blockades) const;
+
     ///< removes any systems on the route after the specified system
     void                    ShortenRouteToEndAtSystem(std::list<int>& travel_route, int last_system);
 
@@ -182,6 +202,10 @@ private:
     bool                        m_arrived_this_turn;
     int                         m_arrival_starlane; // see comment for ArrivalStarlane()
 
+    mutable MovePathInputs      m_move_path_inputs;     ///< inputs from which m_move_path was calculated
+    mutable std::list<MovePathNode>
+                                m_move_path;            ///< most recently calculated MovePath
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -8,6 +8,7 @@
 #include "System.h"
 #include "Building.h"
 #include "Field.h"
+#include "PopCenter.h"
 #include "Enums.h"
 #include "../util/Logger.h"
 
@@ -24,6 +25,34 @@
 #define FOR_EACH_MAP(f, ...)              { f(m_objects, ##__VA_ARGS__);            \
                                             FOR_EACH_SPECIALIZED_MAP(f, ##__VA_ARGS__); }
 
+/////////////////////////////////////////////
+// struct ObjectMap::Indexes
+/////////////////////////////////////////////
+struct ObjectMap::Indexes {
+    typedef std::vector<TemporaryPtr<const UniverseObject> > ObjectVec;
+
+    std::map<int, ObjectVec>            by_owner;
+    std::map<int, ObjectVec>            by_system;
+    std::map<std::string, ObjectVec>    by_species;
+    std::map<std::string, ObjectVec>    by_tag;
+    std::map<std::string, ObjectVec>    by_special;
+    std::map<std::string, ObjectVec>    by_building_type;
+};
+
+namespace {
+    const std::vector<TemporaryPtr<const UniverseObject> > EMPTY_OBJECT_VEC;
+
+    template <class Key>
+    const std::vector<TemporaryPtr<const UniverseObject> >* FindIndexed(
+        const std::map<Key, std::vector<TemporaryPtr<const UniverseObject> > >& index, const Key& key)
+    {
+        typename std::map<Key, std::vector<TemporaryPtr<const UniverseObject> > >::const_iterator it = index.find(key);
+        if (it == index.end())
+            return &EMPTY_OBJECT_VEC;
+        return &it->second;
+    }
+}
+
 /////////////////////////////////////////////
 // class ObjectMap
 /////////////////////////////////////////////
@@ -50,6 +79,7 @@ void ObjectMap::CopyForSerialize(const ObjectMap& copied_map) {
     if (&copied_map == this)
         return;
 
+    m_indexes.reset();
     // note: the following relies upon only m_objects actually getting serialized by ObjectMap::serialize
     m_objects.insert(copied_map.m_objects.begin(), copied_map.m_objects.end());
 }
@@ -153,6 +183,7 @@ ObjectMap::const_iterator<> ObjectMap::const_end() const
 { return const_end<UniverseObject>(); }
 
 void ObjectMap::Insert(boost::shared_ptr<UniverseObject> item, int empire_id/* = ALL_EMPIRES*/) {
+    m_indexes.reset();
     FOR_EACH_MAP(TryInsertIntoMap, item);
     if (item &&
         GetUniverse().EmpireKnownDestroyedObjectIDs(empire_id).find(item->ID()) ==
@@ -201,6 +232,7 @@ boost::shared_ptr<UniverseObject> ObjectMap::Remove(int id) {
     //DebugLogger() << "Object was removed: " << it->second->Dump();
     // object found, so store pointer for later...
     boost::shared_ptr<UniverseObject> result = it->second;
+    m_indexes.reset();
     // and erase from pointer maps
     m_objects.erase(it);
     FOR_EACH_SPECIALIZED_MAP(EraseFromMap, id);
@@ -218,10 +250,13 @@ boost::shared_ptr<UniverseObject> ObjectMap::Remove(int id) {
 
 void ObjectMap::Clear() {
     FOR_EACH_MAP(ClearMap);
+    m_indexes.reset();
 }
 
 void ObjectMap::swap(ObjectMap& rhs) {
     FOR_EACH_MAP(SwapMap, rhs);
+    m_indexes.reset();
+    rhs.m_indexes.reset();
 }
 
 std::vector<int> ObjectMap::FindExistingObjectIDs() const {
@@ -233,6 +268,7 @@ std::vector<int> ObjectMap::FindExistingObjectIDs() const {
 }
 
 void ObjectMap::UpdateCurrentDestroyedObjects(const std::set<int>& destroyed_object_ids) {
+    m_indexes.reset();
     m_existing_objects.clear();
     m_existing_buildings.clear();
     m_existing_fields.clear();
@@ -330,33 +366,119 @@ void ObjectMap::AuditContainment(const std::set<int>& destroyed_object_ids) {
             contained_ships[alt_id].insert(contained_id);
     }
 
-    // set contained objects of all possible containers
-    for (iterator<> it = begin(); it != end(); ++it) {
-        TemporaryPtr<UniverseObject> obj = *it;
+    // set contained objects of all possible containers, by replacing those
+    // whose contents change with updated copies
+    std::vector<boost::shared_ptr<UniverseObject> > updated_containers;
+    for (const_iterator<> it = const_begin(); it != const_end(); ++it) {
+        TemporaryPtr<const UniverseObject> obj = *it;
         if (obj->ObjectType() == OBJ_SYSTEM) {
-            TemporaryPtr<System> sys = boost::dynamic_pointer_cast<System>(obj);
+            TemporaryPtr<const System> sys = boost::dynamic_pointer_cast<const System>(obj);
             if (!sys)
                 continue;
-            sys->m_objects =    contained_objs[sys->ID()];
-            sys->m_planets =    contained_planets[sys->ID()];
-            sys->m_buildings =  contained_buildings[sys->ID()];
-            sys->m_fleets =     contained_fleets[sys->ID()];
-            sys->m_ships =      contained_ships[sys->ID()];
-            sys->m_fields =     contained_fields[sys->ID()];
+            int id = sys->ID();
+            if (sys->m_objects == contained_objs[id] && sys->m_planets == contained_planets[id] &&
+                sys->m_buildings == contained_buildings[id] && sys->m_fleets == contained_fleets[id] &&
+                sys->m_ships == contained_ships[id] && sys->m_fields == contained_fields[id])
+            { continue; }
+            boost::shared_ptr<System> updated = MakeShared(sys->Clone());
+            updated->m_specials =   sys->m_specials;
+            updated->m_objects =    contained_objs[id];
+            updated->m_planets =    contained_planets[id];
+            updated->m_buildings =  contained_buildings[id];
+            updated->m_fleets =     contained_fleets[id];
+            updated->m_ships =      contained_ships[id];
+            updated->m_fields =     contained_fields[id];
+            updated_containers.push_back(updated);
         } else if (obj->ObjectType() == OBJ_PLANET) {
-            TemporaryPtr<Planet> plt = boost::dynamic_pointer_cast<Planet>(obj);
-            if (!plt)
+            TemporaryPtr<const Planet> plt = boost::dynamic_pointer_cast<const Planet>(obj);
+            if (!plt || plt->m_buildings == contained_buildings[plt->ID()])
                 continue;
-            plt->m_buildings =  contained_buildings[plt->ID()];
+            boost::shared_ptr<Planet> updated = MakeShared(plt->Clone());
+            updated->m_specials =   plt->m_specials;
+            updated->m_buildings =  contained_buildings[plt->ID()];
+            updated_containers.push_back(updated);
         } else if (obj->ObjectType() == OBJ_FLEET) {
-            TemporaryPtr<Fleet> flt = boost::dynamic_pointer_cast<Fleet>(obj);
-            if (!flt)
+            TemporaryPtr<const Fleet> flt = boost::dynamic_pointer_cast<const Fleet>(obj);
+            if (!flt || flt->m_ships == contained_ships[flt->ID()])
                 continue;
-            flt->m_ships =      contained_ships[flt->ID()];
+            boost::shared_ptr<Fleet> updated = MakeShared(flt->Clone());
+            updated->m_specials =   flt->m_specials;
+            updated->m_ships =      contained_ships[flt->ID()];
+            updated_containers.push_back(updated);
         }
     }
+
+    for (std::vector<boost::shared_ptr<UniverseObject> >::const_iterator it = updated_containers.begin();
+         it != updated_containers.end(); ++it)
+    { Insert(*it); }
 }
 
+void ObjectMap::BuildIndexes() {
+    boost::shared_ptr<Indexes> indexes(new Indexes());
+
+    for (std::map<int, TemporaryPtr<UniverseObject> >::const_iterator it = m_existing_objects.begin();
+         it != m_existing_objects.end(); ++it)
+    {
+        TemporaryPtr<const UniverseObject> obj = it->second;
+        if (!obj)
+            continue;
+
+        indexes->by_owner[obj->Owner()].push_back(obj);
+
+        if (obj->SystemID() != INVALID_OBJECT_ID)
+            indexes->by_system[obj->SystemID()].push_back(obj);
+
+        std::set<std::string> tags = obj->Tags();
+        for (std::set<std::string>::const_iterator tag_it = tags.begin(); tag_it != tags.end(); ++tag_it)
+            indexes->by_tag[*tag_it].push_back(obj);
+
+        const std::map<std::string, std::pair<int, float> >& specials = obj->Specials();
+        for (std::map<std::string, std::pair<int, float> >::const_iterator special_it = specials.begin();
+             special_it != specials.end(); ++special_it)
+        { indexes->by_special[special_it->first].push_back(obj); }
+
+        // species of pop centres and ships, and of the planets buildings are on
+        std::string species_name;
+        if (TemporaryPtr<const PopCenter> pop = boost::dynamic_pointer_cast<const PopCenter>(obj)) {
+            species_name = pop->SpeciesName();
+        } else if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(obj)) {
+            species_name = ship->SpeciesName();
+        } else if (TemporaryPtr<const Building> building = boost::dynamic_pointer_cast<const Building>(obj)) {
+            indexes->by_building_type[building->BuildingTypeName()].push_back(obj);
+            if (TemporaryPtr<const Planet> planet = Object<Planet>(building->PlanetID()))
+                species_name = planet->SpeciesName();
+        }
+        if (!species_name.empty())
+            indexes->by_species[species_name].push_back(obj);
+    }
+
+    m_indexes = indexes;
+}
+
+void ObjectMap::ClearIndexes()
+{ m_indexes.reset(); }
+
+bool ObjectMap::IndexesBuilt() const
+{ return m_indexes.get() != 0; }
+
+const std::vector<TemporaryPtr<const UniverseObject> >* ObjectMap::IndexedObjectsOwnedBy(int empire_id) const
+{ return m_indexes ? FindIndexed(m_indexes->by_owner, empire_id) : 0; }
+
+const std::vector<TemporaryPtr<const UniverseObject> >* ObjectMap::IndexedObjectsInSystem(int system_id) const
+{ return m_indexes ? FindIndexed(m_indexes->by_system, system_id) : 0; }
+
+const std::vector<TemporaryPtr<const UniverseObject> >* ObjectMap::IndexedObjectsWithSpecies(const std::string& name) const
+{ return m_indexes ? FindIndexed(m_indexes->by_species, name) : 0; }
+
+const std::vector<TemporaryPtr<const UniverseObject> >* ObjectMap::IndexedObjectsWithTag(const std::string& name) const
+{ return m_indexes ? FindIndexed(m_indexes->by_tag, name) : 0; }
+
+const std::vector<TemporaryPtr<const UniverseObject> >* ObjectMap::IndexedObjectsWithSpecial(const std::string& name) const
+{ return m_indexes ? FindIndexed(m_indexes->by_special, name) : 0; }
+
+const std::vector<TemporaryPtr<const UniverseObject> >* ObjectMap::IndexedBuildingsOfType(const std::string& name) const
+{ return m_indexes ? FindIndexed(m_indexes->by_building_type, name) : 0; }
+
 void ObjectMap::CopyObjectsToSpecializedMaps() {
     FOR_EACH_SPECIALIZED_MAP(ClearMap);
     for (std::map<int, boost::shared_ptr<UniverseObject> >::iterator it = Map<UniverseObject>().begin();
@@ -8,6 +8,7 @@
 #include <string>
 
 #include <boost/smart_ptr.hpp>
+#include <boost/pool/pool_alloc.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/type_traits/remove_const.hpp>
 
@@ -329,6 +330,34 @@ public:
     int NumExistingFields()
     {return m_existing_fields.size(); }
 
+    /** Returns true if BuildIndexes() has been called since the indexes were
+      * last cleared. */
+    bool                    IndexesBuilt() const;
+
+    /** Returns the existing objects owned by empire \a empire_id, or 0 if the
+      * indexes are not built. */
+    const std::vector<TemporaryPtr<const UniverseObject> >* IndexedObjectsOwnedBy(int empire_id) const;
+
+    /** Returns the existing objects in system \a system_id, or 0 if the
+      * indexes are not built. */
+    const std::vector<TemporaryPtr<const UniverseObject> >* IndexedObjectsInSystem(int system_id) const;
+
+    /** Returns the existing pop centres and ships with species \a name, and
+      * the buildings on planets with that species, or 0 if the indexes are
+      * not built. */
+    const std::vector<TemporaryPtr<const UniverseObject> >* IndexedObjectsWithSpecies(const std::string& name) const;
+
+    /** Returns the existing objects that have tag \a name, or 0 if the
+      * indexes are not built. */
+    const std::vector<TemporaryPtr<const UniverseObject> >* IndexedObjectsWithTag(const std::string& name) const;
+
+    /** Returns the existing objects that have special \a name, or 0 if the
+      * indexes are not built. */
+    const std::vector<TemporaryPtr<const UniverseObject> >* IndexedObjectsWithSpecial(const std::string& name) const;
+
+    /** Returns the existing buildings of type \a name, or 0 if the indexes are
+      * not built. */
+    const std::vector<TemporaryPtr<const UniverseObject> >* IndexedBuildingsOfType(const std::string& name) const;
     //@}
 
     /** \name Mutators */ //@{
@@ -394,11 +423,30 @@ public:
       * on what other objects exist in this ObjectMap. Useful to eliminate
       * cases where there are inconsistencies between whan an object thinks it
       * contains, and what other objects think they are contained by the first
-      * object. */
+      * object.  Containers whose contents change are replaced in this map by
+      * updated copies, so objects shared with other maps are not modified. */
     void                AuditContainment(const std::set<int>& destroyed_object_ids);
+
+    /** Indexes the existing objects in this ObjectMap by owner, system,
+      * species, tag, special and building type.  Objects' properties are not
+      * tracked after the indexes are built, so they should only be built
+      * while the objects are not being modified, such as while evaluating
+      * conditions, and cleared afterwards.  Any other mutator also clears
+      * the indexes. */
+    void                BuildIndexes();
+
+    /** Discards the indexes built by BuildIndexes(). */
+    void                ClearIndexes();
     //@}
 
 private:
+    struct Indexes;
+    /** Returns a shared_ptr that owns \a obj, with its reference count
+      * allocated from a pool instead of individually. */
+    template <class T>
+    static boost::shared_ptr<T> MakeShared(T* obj)
+    { return boost::shared_ptr<T>(obj, boost::checked_deleter<T>(), boost::fast_pool_allocator<T>()); }
+
     void                Insert(boost::shared_ptr<UniverseObject> item, int empire_id = ALL_EMPIRES);
     void                CopyObjectsToSpecializedMaps();
     template <class T>
@@ -433,6 +481,7 @@ private:
     std::map<int, TemporaryPtr<UniverseObject> >                m_existing_systems;
     std::map<int, TemporaryPtr<UniverseObject> >                m_existing_buildings;
     std::map<int, TemporaryPtr<UniverseObject> >                m_existing_fields;
+    boost::shared_ptr<const Indexes>                            m_indexes;
 
     friend class boost::serialization::access;
     template <class Archive>
@@ -559,7 +608,7 @@ TemporaryPtr<T> ObjectMap::Insert(T* item, int empire_id /* = ALL_EMPIRES */) {
     if (!item)
         return TemporaryPtr<T>();
 
-    boost::shared_ptr<T> shared_item(item);
+    boost::shared_ptr<T> shared_item = MakeShared(item);
     Insert(shared_item, empire_id);
     return TemporaryPtr<T>(shared_item);
 }
@@ -168,14 +168,14 @@ void Planet::Copy(TemporaryPtr<const UniverseObject> copied_object, int empire_i
 }
 
 std::set<std::string> Planet::Tags() const {
-    const Species* species = GetSpecies(SpeciesName());
+    const Species* species = GetSpeciesManager().GetSpecies(SpeciesNameID());
     if (!species)
         return std::set<std::string>();
     return species->Tags();
 }
 
 bool Planet::HasTag(const std::string& name) const {
-    const Species* species = GetSpecies(SpeciesName());
+    const Species* species = GetSpeciesManager().GetSpecies(SpeciesNameID());
 
     return species && species->Tags().count(name);
 }
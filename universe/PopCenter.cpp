@@ -16,11 +16,13 @@ class Species;
 const Species* GetSpecies(const std::string& name);
 
 PopCenter::PopCenter(const std::string& species_name) :
-    m_species_name(species_name)
+    m_species_name(species_name),
+    m_species_name_id(InternString(species_name))
 {}
 
 PopCenter::PopCenter() :
-    m_species_name()
+    m_species_name(),
+    m_species_name_id(INVALID_STRING_ID)
 {}
 
 PopCenter::~PopCenter()
@@ -36,6 +38,7 @@ void PopCenter::Copy(TemporaryPtr<const PopCenter> copied_object, Visibility vis
 
     if (vis >= VIS_PARTIAL_VISIBILITY) {
         this->m_species_name =      copied_object->m_species_name;
+        this->m_species_name_id =   copied_object->m_species_name_id;
     }
 }
 
@@ -141,6 +144,7 @@ void PopCenter::Reset() {
     GetMeter(METER_HAPPINESS)->Reset();
     GetMeter(METER_TARGET_HAPPINESS)->Reset();
     m_species_name.clear();
+    m_species_name_id = INVALID_STRING_ID;
 }
 
 void PopCenter::Depopulate() {
@@ -154,4 +158,5 @@ void PopCenter::SetSpecies(const std::string& species_name) {
         ErrorLogger() << "PopCenter::SetSpecies couldn't get species with name " << species_name;
     }
     m_species_name = species_name;
+    m_species_name_id = InternString(species_name);
 }
@@ -7,6 +7,7 @@
 #include <boost/serialization/nvp.hpp>
 
 #include "../util/Export.h"
+#include "../util/InternedStrings.h"
 #include "EnableTemporaryFromThis.h"
 #include "TemporaryPtr.h"
 
@@ -29,6 +30,7 @@ public:
 
     /** \name Accessors */ //@{
     const std::string&  SpeciesName() const {return m_species_name;}        ///< returns the name of the species that populates this planet
+    StringID            SpeciesNameID() const {return m_species_name_id;}   ///< returns the interned id of SpeciesName()
 
     std::string         Dump() const;
 
@@ -61,6 +63,7 @@ private:
     virtual void            AddMeter(MeterType meter_type) = 0; ///< implementation should add a meter to the object so that it can be accessed with the GetMeter() functions
 
     std::string m_species_name;                                 ///< the name of the species that occupies this planet
+    StringID    m_species_name_id;                              ///< interned id of m_species_name; not serialized
 
     friend class boost::serialization::access;
     template <class Archive>
@@ -72,6 +75,8 @@ template <class Archive>
 void PopCenter::serialize(Archive& ar, const unsigned int version)
 {
     ar  & BOOST_SERIALIZATION_NVP(m_species_name);
+    if (Archive::is_loading::value)
+        m_species_name_id = InternString(m_species_name);
 }
 
 #endif // _PopCenter_h_
@@ -23,6 +23,7 @@ Ship::Ship() :
     m_ordered_invade_planet_id(INVALID_OBJECT_ID),
     m_ordered_bombard_planet_id(INVALID_OBJECT_ID),
     m_last_turn_active_in_combat(INVALID_GAME_TURN),
+    m_species_name_id(INVALID_STRING_ID),
     m_produced_by_empire_id(ALL_EMPIRES)
 {}
 
@@ -36,6 +37,7 @@ Ship::Ship(int empire_id, int design_id, const std::string& species_name,
     m_ordered_bombard_planet_id(INVALID_OBJECT_ID),
     m_last_turn_active_in_combat(INVALID_GAME_TURN),
     m_species_name(species_name),
+    m_species_name_id(InternString(species_name)),
     m_produced_by_empire_id(produced_by_empire_id)
 {
     if (!GetShipDesign(design_id))
@@ -135,6 +137,7 @@ void Ship::Copy(TemporaryPtr<const UniverseObject> copied_object, int empire_id)
                  it != copied_ship->m_part_meters.end(); ++it)
             { this->m_part_meters[it->first]; }
             this->m_species_name =          copied_ship->m_species_name;
+            this->m_species_name_id =       copied_ship->m_species_name_id;
 
             if (vis >= VIS_FULL_VISIBILITY) {
                 this->m_ordered_scrapped =          copied_ship->m_ordered_scrapped;
@@ -152,25 +155,22 @@ void Ship::Copy(TemporaryPtr<const UniverseObject> copied_object, int empire_id)
 std::set<std::string> Ship::Tags() const {
     std::set<std::string> retval;
 
-    const ShipDesign* design = GetShipDesign(m_design_id);
-    if (!design)
-        return retval;
-
-    const HullType* hull = ::GetHullType(design->Hull());
-    if (!hull)
-        return retval;
-    retval.insert(hull->Tags().begin(), hull->Tags().end());
-
-    const std::vector<std::string>& parts = design->Parts();
-    if (parts.empty())
-        return retval;
+    if (const ShipDesign* design = GetShipDesign(m_design_id)) {
+        if (const HullType* hull = ::GetHullType(design->Hull()))
+            retval.insert(hull->Tags().begin(), hull->Tags().end());
 
-    for (std::vector<std::string>::const_iterator part_it = parts.begin(); part_it != parts.end(); ++part_it) {
-        if (const PartType* part = GetPartType(*part_it)) {
-            retval.insert(part->Tags().begin(), part->Tags().end());
+        const std::vector<std::string>& parts = design->Parts();
+        for (std::vector<std::string>::const_iterator part_it = parts.begin(); part_it != parts.end(); ++part_it) {
+            if (const PartType* part = GetPartType(*part_it)) {
+                retval.insert(part->Tags().begin(), part->Tags().end());
+            }
         }
     }
 
+    // species tags, which HasTag also matches
+    if (const Species* species = GetSpeciesManager().GetSpecies(m_species_name_id))
+        retval.insert(species->Tags().begin(), species->Tags().end());
+
     return retval;
 }
 
@@ -191,7 +191,7 @@ bool Ship::HasTag(const std::string& name) const {
         }
     }
     // check species for tag
-    const Species* species = GetSpecies(SpeciesName());
+    const Species* species = GetSpeciesManager().GetSpecies(m_species_name_id);
     if (species && species->Tags().count(name))
         return true;
 
@@ -251,7 +251,7 @@ bool Ship::IsArmed() const {
 bool Ship::CanColonize() const {
     if (m_species_name.empty())
         return false;
-    const Species* species = GetSpecies(m_species_name);
+    const Species* species = GetSpeciesManager().GetSpecies(m_species_name_id);
     if (!species)
         return false;
     if (!species->CanColonize())
@@ -483,6 +483,7 @@ void Ship::SetSpecies(const std::string& species_name) {
     if (!GetSpecies(species_name))
         ErrorLogger() << "Ship::SetSpecies couldn't get species with name " << species_name;
     m_species_name = species_name;
+    m_species_name_id = InternString(species_name);
 }
 
 void Ship::SetOrderedScrapped(bool b) {
@@ -6,6 +6,7 @@
 #include "Meter.h"
 
 #include "../util/Export.h"
+#include "../util/InternedStrings.h"
 
 class ShipDesign;
 
@@ -39,6 +40,7 @@ public:
     bool                        HasTroops() const;
     bool                        CanBombard() const;
     const std::string&          SpeciesName() const         { return m_species_name; }
+    StringID                    SpeciesNameID() const       { return m_species_name_id; }   ///< returns the interned id of SpeciesName()
     float                       Speed() const;
     float                       ColonyCapacity() const;
     float                       TroopCapacity() const;
@@ -89,6 +91,7 @@ public:
 
 protected:
     friend class Universe;
+    friend class UniverseSnapshot;
     /** \name Structors */ //@{
     Ship();                                         ///< default ctor
     Ship(int empire_id, int design_id, const std::string& species_name,
@@ -115,6 +118,7 @@ private:
     int             m_last_turn_active_in_combat;
     PartMeterMap    m_part_meters;
     std::string     m_species_name;
+    StringID        m_species_name_id;  // not serialized
     int             m_produced_by_empire_id;
 
     friend class boost::serialization::access;
@@ -695,14 +695,10 @@ std::vector<std::string> ShipDesign::Weapons() const {
     return retval;
 }
 
-bool ShipDesign::ProductionLocation(int empire_id, int location_id) const {
-    TemporaryPtr<const UniverseObject> location = GetUniverseObject(location_id);
-    if (!location)
-        return false;
-
+bool ShipDesign::SpeciesCanProduceAt(int location_id) const {
     // currently ships can only be built at planets, and by species that are
     // not planetbound
-    TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(location);
+    TemporaryPtr<const Planet> planet = GetPlanet(location_id);
     if (!planet)
         return false;
     const std::string& species_name = planet->SpeciesName();
@@ -716,6 +712,16 @@ bool ShipDesign::ProductionLocation(int empire_id, int location_id) const {
     // also, species that can't colonize can't produce colony ships
     if (this->CanColonize() && !species->CanColonize())
         return false;
+    return true;
+}
+
+bool ShipDesign::ProductionLocation(int empire_id, int location_id) const {
+    TemporaryPtr<const UniverseObject> location = GetUniverseObject(location_id);
+    if (!location)
+        return false;
+
+    if (!SpeciesCanProduceAt(location_id))
+        return false;
 
     Empire* empire = GetEmpire(empire_id);
     if (!empire) {
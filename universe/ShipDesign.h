@@ -487,6 +487,7 @@ public:
     //@}
 
     bool                            ProductionLocation(int empire_id, int location_id) const;   ///< returns true iff the empire with ID empire_id can produce this design at the location with location_id
+    bool                            SpeciesCanProduceAt(int location_id) const;                 ///< returns true iff the location with id location_id is a planet whose species can produce this design, without checking the hull and parts location conditions
 
     /** \name Mutators */ //@{
     void                            SetID(int id);                          ///< sets the ID number of the design to \a id .  Should only be used by Universe class when inserting new design into Universe.
@@ -299,6 +299,14 @@ SpeciesManager::SpeciesManager() {
         throw std::runtime_error("Attempted to create more than one SpeciesManager.");
     s_instance = this;
     parse::species(GetResourceDir() / "species.txt", m_species);
+    for (std::map<std::string, Species*>::const_iterator it = m_species.begin(); it != m_species.end(); ++it) {
+        StringID name_id = it->second->NameID();
+        if (name_id == INVALID_STRING_ID)
+            continue;
+        if (static_cast<std::size_t>(name_id) >= m_species_by_name_id.size())
+            m_species_by_name_id.resize(name_id + 1, 0);
+        m_species_by_name_id[name_id] = it->second;
+    }
     if (GetOptionsDB().Get<bool>("verbose-logging")) {
         DebugLogger() << "Species:";
         for (iterator it = begin(); it != end(); ++it) {
@@ -327,6 +335,12 @@ Species* SpeciesManager::GetSpecies(const std::string& name) {
     return it != m_species.end() ? it->second : 0;
 }
 
+const Species* SpeciesManager::GetSpecies(StringID name_id) const {
+    if (name_id < 0 || static_cast<std::size_t>(name_id) >= m_species_by_name_id.size())
+        return 0;
+    return m_species_by_name_id[name_id];
+}
+
 int SpeciesManager::GetSpeciesID(const std::string& name) const {
     iterator it = m_species.find(name);
     if (it == m_species.end())
@@ -4,6 +4,7 @@
 
 #include "Enums.h"
 #include "../util/Export.h"
+#include "../util/InternedStrings.h"
 
 #include <boost/algorithm/string/case_conv.hpp>
 #include <boost/shared_ptr.hpp>
@@ -114,6 +115,7 @@ public:
             const std::set<std::string>& tags,
             const std::string& graphic) :
         m_name(strings.name),
+        m_name_id(InternString(strings.name)),
         m_description(strings.desc),
         m_gameplay_description(strings.gameplay_desc),
         m_foci(foci),
@@ -138,6 +140,7 @@ public:
 
     /** \name Accessors */ //@{
     const std::string&              Name() const                        { return m_name; }                  ///< returns the unique name for this type of species
+    StringID                        NameID() const                      { return m_name_id; }               ///< returns the interned id of Name()
     const std::string&              Description() const                 { return m_description; }           ///< returns a text description of this type of species
     const std::string&              GameplayDescription() const         { return m_gameplay_description; }  ///< returns a text description of this type of species
 
@@ -176,6 +179,7 @@ private:
     void    Init();
 
     std::string                             m_name;
+    StringID                                m_name_id;
     std::string                             m_description;
     std::string                             m_gameplay_description;
 
@@ -220,6 +224,11 @@ public:
     const Species*          GetSpecies(const std::string& name) const;
     Species*                GetSpecies(const std::string& name);
 
+    /** returns the species whose name has the interned id \a name_id, or 0 if
+      * there is no such species.  Unlike lookups by name, this does not need
+      * to compare any strings. */
+    const Species*          GetSpecies(StringID name_id) const;
+
     /** returns a unique numeric id for reach species, or -1 for an invalid species name. */
     int                     GetSpeciesID(const std::string& name) const;
 
@@ -314,6 +323,7 @@ private:
     void    SetSpeciesHomeworlds(const std::map<std::string, std::set<int> >& species_homeworld_ids);
 
     std::map<std::string, Species*>                         m_species;
+    std::vector<const Species*>                             m_species_by_name_id;   // indexed by Species::NameID()
     std::map<std::string, std::map<int, float> >            m_species_empire_opinions;
     std::map<std::string, std::map<std::string, float> >    m_species_species_opinions;
 
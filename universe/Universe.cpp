@@ -28,6 +28,7 @@
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <boost/dynamic_bitset.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/breadth_first_search.hpp>
@@ -426,12 +427,13 @@ namespace EmpireStatistics {
 /////////////////////////////////////////////
 Universe::Universe() :
     m_graph_impl(new GraphImpl),
+    m_system_blockades_turn(INVALID_GAME_TURN),
     m_last_allocated_object_id(-1), // this is conicidentally equal to INVALID_OBJECT_ID as of this writing, but the reason for this to be -1 is so that the first object has id 0, and all object ids are non-negative
     m_last_allocated_design_id(-1), // same, but for ShipDesign::INVALID_DESIGN_ID
     m_universe_width(1000.0),
     m_inhibit_universe_object_signals(false),
-    m_encoding_empire(ALL_EMPIRES),
-    m_all_objects_visible(false)
+    m_all_objects_visible(false),
+    m_snapshot(0)
 {}
 
 Universe::~Universe() {
@@ -458,8 +460,10 @@ void Universe::Clear() {
     m_empire_object_visible_specials.clear();
 
     m_system_id_to_graph_index.clear();
+    InvalidateBlockades();
     m_effect_accounting_map.clear();
     m_effect_discrepancy_map.clear();
+    m_effect_targets_by_source.clear();
 
     m_last_allocated_object_id = -1;
     m_last_allocated_design_id = -1;
@@ -1089,6 +1093,89 @@ int Universe::NearestSystemTo(double x, double y) const {
     return min_dist2_sys_id;
 }
 
+const Universe::SystemBlockade* Universe::GetSystemBlockade(int system_id) const {
+    int current_turn = CurrentTurn();
+    if (m_system_blockades_turn == INVALID_GAME_TURN || m_system_blockades_turn != current_turn)
+        UpdateSystemBlockades();
+
+    std::map<int, SystemBlockade>::const_iterator it = m_system_blockades.find(system_id);
+    if (it == m_system_blockades.end())
+        return 0;
+    return &it->second;
+}
+
+void Universe::InvalidateBlockades() {
+    m_system_blockades.clear();
+    m_system_blockades_turn = INVALID_GAME_TURN;
+}
+
+void Universe::UpdateSystemBlockades() const {
+    m_system_blockades.clear();
+
+    for (ObjectMap::const_iterator<System> sys_it = m_objects.const_begin<System>();
+         sys_it != m_objects.const_end<System>(); ++sys_it)
+    {
+        TemporaryPtr<const System> system = *sys_it;
+        if (system->FleetIDs().empty())
+            continue;
+
+        SystemBlockade blockade;
+        float monster_detection = 0.0f;
+
+        std::vector<TemporaryPtr<const Fleet> > fleets = m_objects.FindObjects<const Fleet>(system->FleetIDs());
+        for (std::vector<TemporaryPtr<const Fleet> >::const_iterator fleet_it = fleets.begin();
+             fleet_it != fleets.end(); ++fleet_it)
+        {
+            TemporaryPtr<const Fleet> fleet = *fleet_it;
+
+            // all monsters in system contribute to monster detection, even if moving
+            if (fleet->Unowned()) {
+                std::vector<TemporaryPtr<const Ship> > ships = m_objects.FindObjects<const Ship>(fleet->ShipIDs());
+                for (std::vector<TemporaryPtr<const Ship> >::const_iterator ship_it = ships.begin();
+                     ship_it != ships.end(); ++ship_it)
+                { monster_detection = std::max(monster_detection, (*ship_it)->CurrentMeterValue(METER_DETECTION)); }
+            }
+
+            // fleets trying to leave this turn can't blockade pre-combat.
+            if (fleet->NextSystemID() != INVALID_OBJECT_ID)
+                continue;
+
+            // unrestricted lane access (i.e, (fleet->ArrivalStarlane() == system->ID()) )
+            // is used as a proxy for order of arrival
+            bool unrestricted = (fleet->ArrivalStarlane() == system->ID());
+            if (unrestricted)
+                blockade.unrestricted_owners.insert(fleet->Owner());
+
+            bool aggressive = (fleet->Aggressive() || fleet->Unowned());
+            if (!aggressive || !fleet->HasArmedShips())
+                continue;
+
+            blockade.blockaders[fleet->Owner()] = 0.0f;
+            if (unrestricted)
+                blockade.unrestricted_blockaders.insert(fleet->Owner());
+        }
+
+        if (blockade.unrestricted_owners.empty() && blockade.blockaders.empty())
+            continue;
+
+        // record how well each blockading empire (or monsters) can see fleets here
+        for (std::map<int, float>::iterator it = blockade.blockaders.begin();
+             it != blockade.blockaders.end(); ++it)
+        {
+            if (it->first == ALL_EMPIRES) {
+                it->second = monster_detection;
+            } else if (const Empire* empire = GetEmpire(it->first)) {
+                if (const Meter* meter = empire->GetMeter("METER_DETECTION_STRENGTH"))
+                    it->second = meter->Current();
+            }
+        }
+
+        m_system_blockades[system->ID()] = blockade;
+    }
+
+    m_system_blockades_turn = CurrentTurn();
+}
+
 int Universe::GenerateObjectID() {
     if (m_last_allocated_object_id + 1 < MAX_ID)
         return ++m_last_allocated_object_id;
@@ -1354,8 +1441,10 @@ void Universe::UpdateMeterEstimates()
 void Universe::UpdateMeterEstimates(int object_id, bool update_contained_objects) {
     if (object_id == INVALID_OBJECT_ID) {
         std::vector<int> all_objects_vec = m_objects.FindExistingObjectIDs();
-        for (std::vector< int >::iterator id_it = all_objects_vec.begin(); id_it != all_objects_vec.end(); id_it++)
+        for (std::vector< int >::iterator id_it = all_objects_vec.begin(); id_it != all_objects_vec.end(); id_it++) {
+            RecordSnapshotMeters(*id_it);
             m_effect_accounting_map[*id_it].clear();
+        }
         // update meters for all objects.  Value of updated_contained_objects is irrelivant and is ignored in this case.
         UpdateMeterEstimatesImpl(std::vector<int>());// will cause it to process all existing objects
         return;
@@ -1379,6 +1468,7 @@ void Universe::UpdateMeterEstimates(int object_id, bool update_contained_objects
 
         // add object and clear effect accounting for all its meters
         objects_set.insert(cur_object_id);
+        RecordSnapshotMeters(cur_object_id);
         m_effect_accounting_map[cur_object_id].clear();
 
         // add contained objects to list of objects to process, if requested.
@@ -1395,6 +1485,53 @@ void Universe::UpdateMeterEstimates(int object_id, bool update_contained_objects
         UpdateMeterEstimatesImpl(objects_vec);
 }
 
+void Universe::UpdateMeterEstimatesForChangedObject(int object_id) {
+    // collect the changed object and, recursively, the objects it contains
+    std::vector<int> changed_objects;
+    changed_objects.push_back(object_id);
+    for (std::size_t i = 0; i < changed_objects.size(); ++i) {
+        TemporaryPtr<const UniverseObject> obj = m_objects.Object(changed_objects[i]);
+        if (!obj) {
+            if (changed_objects[i] == object_id) {
+                ErrorLogger() << "Universe::UpdateMeterEstimatesForChangedObject couldn't get object with id " << object_id;
+                return;
+            }
+            continue;
+        }
+        const std::set<int>& contained_objects = obj->ContainedObjectIDs();
+        std::copy(contained_objects.begin(), contained_objects.end(), std::back_inserter(changed_objects));
+    }
+
+    // add the objects that the changed objects' effects acted on
+    std::vector<int> objects_vec(changed_objects);
+    for (std::vector<int>::const_iterator it = changed_objects.begin(); it != changed_objects.end(); ++it) {
+        std::map<int, std::set<int> >::const_iterator targets_it = m_effect_targets_by_source.find(*it);
+        if (targets_it != m_effect_targets_by_source.end())
+            std::copy(targets_it->second.begin(), targets_it->second.end(), std::back_inserter(objects_vec));
+    }
+
+    // the change may also bring objects into the scope of effects that did
+    // not act on them before, such as focus-conditioned effects that target
+    // objects in the same system, or effects of other sources whose scopes
+    // test the changed object.  those are most likely to be in the changed
+    // object's system, so its objects are also updated
+    if (TemporaryPtr<const UniverseObject> obj = m_objects.Object(object_id)) {
+        if (TemporaryPtr<const System> system = GetSystem(obj->SystemID())) {
+            objects_vec.push_back(system->ID());
+            const std::set<int>& system_objects = system->ContainedObjectIDs();
+            for (std::set<int>::const_iterator it = system_objects.begin(); it != system_objects.end(); ++it) {
+                objects_vec.push_back(*it);
+                if (TemporaryPtr<const UniverseObject> system_obj = m_objects.Object(*it)) {
+                    const std::set<int>& contained_objects = system_obj->ContainedObjectIDs();
+                    std::copy(contained_objects.begin(), contained_objects.end(), std::back_inserter(objects_vec));
+                }
+            }
+        }
+    }
+
+    UpdateMeterEstimates(objects_vec);
+}
+
 void Universe::UpdateMeterEstimates(const std::vector<int>& objects_vec) {
     std::set<int> objects_set;  // ensures no duplicates
 
@@ -1403,6 +1540,7 @@ void Universe::UpdateMeterEstimates(const std::vector<int>& objects_vec) {
         // skip destroyed objects
         if (m_destroyed_object_ids.find(object_id) != m_destroyed_object_ids.end())
             continue;
+        RecordSnapshotMeters(object_id);
         m_effect_accounting_map[object_id].clear();
         objects_set.insert(object_id);
     }
@@ -1462,6 +1600,19 @@ void Universe::UpdateMeterEstimatesImpl(const std::vector<int>& objects_vec) {
     Effect::TargetsCauses targets_causes;
     GetEffectsAndTargets(targets_causes, objects_vec);
 
+    // remember which objects each source's effects acted on, so that when a
+    // source changes, only those objects' estimates need to be updated.
+    // updates of some objects can only add to what is known from the last
+    // update of all objects.
+    if (objects_vec.empty())
+        m_effect_targets_by_source.clear();
+    for (Effect::TargetsCauses::const_iterator it = targets_causes.begin(); it != targets_causes.end(); ++it) {
+        std::set<int>& source_targets = m_effect_targets_by_source[it->first.source_object_id];
+        const Effect::TargetSet& targets = it->second.target_set;
+        for (Effect::TargetSet::const_iterator target_it = targets.begin(); target_it != targets.end(); ++target_it)
+            source_targets.insert((*target_it)->ID());
+    }
+
     // Apply and record effect meter adjustments
     ExecuteEffects(targets_causes, true, true, false, false);
 
@@ -1547,6 +1698,114 @@ void Universe::BackPropegateObjectMeters(const std::vector<int>& object_ids) {
 void Universe::BackPropegateObjectMeters()
 { BackPropegateObjectMeters(m_objects.FindObjectIDs()); }
 
+void Universe::RecordSnapshotMeters(int object_id) {
+    for (UniverseSnapshot* snapshot = m_snapshot; snapshot; snapshot = snapshot->m_previous)
+        snapshot->RecordMeters(object_id);
+}
+
+////////////////////////////////////////////////
+// UniverseSnapshot
+////////////////////////////////////////////////
+struct UniverseSnapshot::ObjectState {
+    ObjectState() :
+        meters_recorded(false),
+        had_accounting(false),
+        owner_recorded(false),
+        owner(ALL_EMPIRES)
+    {}
+
+    bool                                                    meters_recorded;
+    std::map<MeterType, Meter>                              meters;
+    Ship::PartMeterMap                                      part_meters;
+    bool                                                    had_accounting;
+    std::map<MeterType, std::vector<Effect::AccountingInfo> >
+                                                            accounting;
+    bool                                                    owner_recorded;
+    int                                                     owner;
+};
+
+UniverseSnapshot::UniverseSnapshot(Universe& universe, bool record_meters/* = true*/) :
+    m_universe(universe),
+    m_previous(universe.m_snapshot),
+    m_record_meters(record_meters)
+{ m_universe.m_snapshot = this; }
+
+UniverseSnapshot::~UniverseSnapshot() {
+    Restore();
+    if (m_universe.m_snapshot != this)
+        ErrorLogger() << "UniverseSnapshot destroyed while a more recent snapshot is still active";
+    m_universe.m_snapshot = m_previous;
+}
+
+void UniverseSnapshot::SetOwner(TemporaryPtr<UniverseObject> obj, int empire_id) {
+    if (!obj)
+        return;
+    for (UniverseSnapshot* snapshot = this; snapshot; snapshot = snapshot->m_previous)
+        snapshot->RecordOwner(obj);
+    obj->SetOwner(empire_id);
+}
+
+void UniverseSnapshot::Restore() {
+    for (ObjectStateMap::iterator it = m_states.begin(); it != m_states.end(); ++it) {
+        int object_id = it->first;
+        const ObjectState& state = *it->second;
+        TemporaryPtr<UniverseObject> obj = m_universe.m_objects.Object(object_id);
+        if (!obj)
+            continue;
+
+        if (state.owner_recorded)
+            obj->SetOwner(state.owner);
+
+        if (state.meters_recorded) {
+            obj->Meters() = state.meters;
+            if (TemporaryPtr<Ship> ship = boost::dynamic_pointer_cast<Ship>(obj))
+                ship->m_part_meters = state.part_meters;
+
+            if (state.had_accounting)
+                m_universe.m_effect_accounting_map[object_id] = state.accounting;
+            else
+                m_universe.m_effect_accounting_map.erase(object_id);
+        }
+    }
+    m_states.clear();
+}
+
+UniverseSnapshot::ObjectState& UniverseSnapshot::State(int object_id) {
+    boost::shared_ptr<ObjectState>& state = m_states[object_id];
+    if (!state)
+        state.reset(new ObjectState());
+    return *state;
+}
+
+void UniverseSnapshot::RecordMeters(int object_id) {
+    if (!m_record_meters)
+        return;
+    TemporaryPtr<const UniverseObject> obj = m_universe.m_objects.Object(object_id);
+    if (!obj)
+        return;
+    ObjectState& state = State(object_id);
+    if (state.meters_recorded)
+        return;
+
+    state.meters_recorded = true;
+    state.meters = obj->Meters();
+    if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(obj))
+        state.part_meters = ship->m_part_meters;
+
+    Effect::AccountingMap::const_iterator accounting_it = m_universe.m_effect_accounting_map.find(object_id);
+    state.had_accounting = (accounting_it != m_universe.m_effect_accounting_map.end());
+    if (state.had_accounting)
+        state.accounting = accounting_it->second;
+}
+
+void UniverseSnapshot::RecordOwner(TemporaryPtr<const UniverseObject> obj) {
+    ObjectState& state = State(obj->ID());
+    if (state.owner_recorded)
+        return;
+    state.owner_recorded = true;
+    state.owner = obj->Owner();
+}
+
 namespace {
     /** Used by GetEffectsAndTargets to process a vector of effects groups.
       * Stores target set of specified \a effects_groups and \a source_object_id
@@ -1564,7 +1823,8 @@ namespace {
             void MarkComplete(std::pair<bool, Effect::TargetSet>* cache_entry);
             void LockShared(boost::shared_lock<boost::shared_mutex>& guard);
         private:
-            std::map<const Condition::ConditionBase*, std::pair<bool, Effect::TargetSet> > m_entries;
+            typedef std::pair<const Condition::ConditionBase*, std::pair<bool, Effect::TargetSet> > Entry;
+            std::multimap<std::size_t, Entry>   m_entries;  ///< indexed by condition's structural hash
             boost::shared_mutex m_mutex;
             boost::condition_variable_any m_state_changed;
         };
@@ -1621,23 +1881,32 @@ namespace {
             m_source_cached_condition_matches       (&the_source_cached_condition_matches),
             m_invariant_cached_condition_matches    (&the_invariant_cached_condition_matches),
             m_global_mutex                          (&the_global_mutex)
-    {}
+    {
+        // work items are created on the main thread, so that the structural
+        // hashes of the scope and its operands can be computed here, before
+        // any concurrent lookup
+        if (m_effects_group->Scope()) {
+            m_effects_group->Scope()->StructuralHash();
+            Condition::ScopedOperandMatchesCache::PrepareCondition(m_effects_group->Scope());
+        }
+    }
 
     std::pair<bool, Effect::TargetSet>* StoreTargetsAndCausesOfEffectsGroupsWorkItem::ConditionCache::Find(
         const Condition::ConditionBase* cond, bool insert) 
     {
-        // have to iterate through cached condition matches, rather than using
-        // find, since there is no operator< for comparing conditions by value
-        // and by pointer is irrelivant.
+        // equal conditions in different effects groups are separate objects,
+        // so look up entries by the conditions' structural hash and then
+        // compare the conditions with the same hash by value
+        std::size_t hash = cond->StructuralHash();
         boost::unique_lock<boost::shared_mutex> unique_guard(m_mutex, boost::defer_lock_t());
         boost::shared_lock<boost::shared_mutex> shared_guard(m_mutex, boost::defer_lock_t());
 
         if (insert) unique_guard.lock(); else shared_guard.lock();
 
-        for (std::map<const Condition::ConditionBase*, std::pair<bool,Effect::TargetSet> >::iterator
-             it = m_entries.begin(); it != m_entries.end(); ++it)
-        {
-            if (*cond == *(it->first)) {
+        std::pair<std::multimap<std::size_t, Entry>::iterator, std::multimap<std::size_t, Entry>::iterator>
+            range = m_entries.equal_range(hash);
+        for (std::multimap<std::size_t, Entry>::iterator it = range.first; it != range.second; ++it) {
+            if (*cond == *(it->second.first)) {
                 //DebugLogger() << "Reused target set!";
 
                 if (insert) {
@@ -1647,17 +1916,17 @@ namespace {
                 }
 
                 // wait for cache fill
-                while (!it->second.first)
+                while (!it->second.second.first)
                     m_state_changed.wait(shared_guard);
 
-                return &it->second;
+                return &it->second.second;
             }
         }
 
         // nothing found
         if (insert)
             // set up storage
-            return &m_entries[cond];
+            return &m_entries.insert(std::make_pair(hash, Entry(cond, std::make_pair(false, Effect::TargetSet()))))->second.second;
 
         return NULL;
     }
@@ -1792,6 +2061,21 @@ namespace {
         }
     }
 
+    /** Keeps the indexes of an ObjectMap built while conditions are being
+      * evaluated, and discards them afterwards, when objects may change. */
+    class ScopedObjectMapIndexes {
+    public:
+        explicit ScopedObjectMapIndexes(ObjectMap& objects) :
+            m_objects(objects)
+        { m_objects.BuildIndexes(); }
+
+        ~ScopedObjectMapIndexes()
+        { m_objects.ClearIndexes(); }
+
+    private:
+        ObjectMap& m_objects;
+    };
+
 } // namespace
 
 void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes) {
@@ -1804,6 +2088,14 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
 {
     ScopedTimer timer("Universe::GetEffectsAndTargets");
 
+    // index objects so that conditions can start from the objects that might
+    // match them; must outlive the run_queue below
+    ScopedObjectMapIndexes object_indexes(m_objects);
+
+    // reuse the matches of structurally equal And operands across effects
+    // groups; must also outlive the run_queue below
+    Condition::ScopedOperandMatchesCache operand_matches_cache;
+
     // transfer target objects from input vector to a set
     Effect::TargetSet all_potential_targets = m_objects.FindObjects(target_objects);
 
@@ -1848,7 +2140,7 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
     type_timer.restart();
 
     // find each species planets in single pass, maintaining object map order per-species
-    std::map<std::string, std::vector<TemporaryPtr<const UniverseObject> > > species_objects;
+    std::map<StringID, std::vector<TemporaryPtr<const UniverseObject> > > species_objects;
     std::vector<TemporaryPtr<Planet> > planets = m_objects.FindObjects<Planet>();
     for (std::vector<TemporaryPtr<Planet> >::const_iterator planet_it = planets.begin();
          planet_it != planets.end(); ++planet_it)
@@ -1856,15 +2148,15 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
         TemporaryPtr<const Planet> planet = *planet_it;
         if (m_destroyed_object_ids.find(planet->ID()) != m_destroyed_object_ids.end())
             continue;
-        const std::string& species_name = planet->SpeciesName();
-        if (species_name.empty())
+        StringID species_name_id = planet->SpeciesNameID();
+        if (species_name_id == INVALID_STRING_ID)
             continue;
-        const Species* species = GetSpecies(species_name);
+        const Species* species = GetSpeciesManager().GetSpecies(species_name_id);
         if (!species) {
-            ErrorLogger() << "GetEffectsAndTargets couldn't get Species " << species_name;
+            ErrorLogger() << "GetEffectsAndTargets couldn't get Species " << planet->SpeciesName();
             continue;
         }
-        species_objects[species_name].push_back(planet);
+        species_objects[species_name_id].push_back(planet);
     }
 
     double planet_species_time = type_timer.elapsed();
@@ -1878,15 +2170,15 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
         TemporaryPtr<const Ship> ship = *ship_it;
         if (m_destroyed_object_ids.find(ship->ID()) != m_destroyed_object_ids.end())
             continue;
-        const std::string& species_name = ship->SpeciesName();
-        if (species_name.empty())
+        StringID species_name_id = ship->SpeciesNameID();
+        if (species_name_id == INVALID_STRING_ID)
             continue;
-        const Species* species = GetSpecies(species_name);
+        const Species* species = GetSpeciesManager().GetSpecies(species_name_id);
         if (!species) {
-            ErrorLogger() << "GetEffectsAndTargets couldn't get Species " << species_name;
+            ErrorLogger() << "GetEffectsAndTargets couldn't get Species " << ship->SpeciesName();
             continue;
         }
-        species_objects[species_name].push_back(ship);
+        species_objects[species_name_id].push_back(ship);
     }
     double ship_species_time = type_timer.elapsed();
 
@@ -1896,8 +2188,8 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
     {
         const std::string& species_name = species_it->first;
         const Species*     species      = species_it->second;
-        std::map<std::string, std::vector<TemporaryPtr<const UniverseObject> > >::iterator species_objects_it =
-            species_objects.find(species_name);
+        std::map<StringID, std::vector<TemporaryPtr<const UniverseObject> > >::iterator species_objects_it =
+            species_objects.find(species->NameID());
 
         if (species_objects_it == species_objects.end())
             continue;
@@ -2225,6 +2517,21 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
                   << " reorder time: " << reorder_time*1000;
 }
 
+namespace {
+    /** Adds the object with id \a object_id to \a object_ids, which has a bit
+      * for each object id, starting from the id of temporary objects.
+      * Returns false if the object was already in the set. */
+    bool InsertObjectID(boost::dynamic_bitset<>& object_ids, int object_id) {
+        std::size_t bit = static_cast<std::size_t>(object_id - TEMPORARY_OBJECT_ID);
+        if (bit >= object_ids.size())
+            object_ids.resize(std::max(bit + 1, 2 * object_ids.size()));
+        if (object_ids.test(bit))
+            return false;
+        object_ids.set(bit);
+        return true;
+    }
+}
+
 void Universe::ExecuteEffects(const Effect::TargetsCauses& targets_causes,
                               bool update_effect_accounting,
                               bool only_meter_effects/* = false*/,
@@ -2235,7 +2542,7 @@ void Universe::ExecuteEffects(const Effect::TargetsCauses& targets_causes,
 
     m_marked_destroyed.clear();
     m_marked_for_victory.clear();
-    std::map< std::string, std::set<int> > executed_nonstacking_effects;
+    std::map< std::string, boost::dynamic_bitset<> > executed_nonstacking_effects;
     bool log_verbose = GetOptionsDB().Get<bool>("verbose-logging");
 
     // grouping targets causes by effects group
@@ -2282,7 +2589,9 @@ void Universe::ExecuteEffects(const Effect::TargetsCauses& targets_causes,
             // targets in the scope of the current EffectsGroup, skip them
             // and add the remaining objects affected by it to executed_nonstacking_effects
             if (!stacking_group.empty()) {
-                std::set<int>& non_stacking_targets = executed_nonstacking_effects[stacking_group];
+                boost::dynamic_bitset<>& non_stacking_targets = executed_nonstacking_effects[stacking_group];
+                if (non_stacking_targets.empty())
+                    non_stacking_targets.resize(static_cast<std::size_t>(m_last_allocated_object_id - TEMPORARY_OBJECT_ID + 1));
 
                 for (Effect::TargetsCauses::iterator targets_it = group_targets_causes.begin();
                      targets_it != group_targets_causes.end();)
@@ -2296,14 +2605,10 @@ void Universe::ExecuteEffects(const Effect::TargetsCauses& targets_causes,
                     for (Effect::TargetSet::iterator object_it = targets.begin();
                          object_it != targets.end(); )
                     {
-                        int object_id                    = (*object_it)->ID();
-                        std::set<int>::const_iterator it = non_stacking_targets.find(object_id);
-
-                        if (it != non_stacking_targets.end()) {
+                        if (!InsertObjectID(non_stacking_targets, (*object_it)->ID())) {
                             *object_it = targets.back();
                             targets.pop_back();
                         } else {
-                            non_stacking_targets.insert(object_id);
                             ++object_it;
                         }
                     }
@@ -3150,6 +3455,38 @@ void Universe::UpdateEmpireObjectVisibilities() {
     SetEmpireSpecialVisibilities(Objects(), m_empire_object_visibility, m_empire_object_visible_specials);
 }
 
+namespace {
+    /** The empire-dependent information that the Copy functions of
+      * UniverseObjects use to limit what is copied of an object.  Copying an
+      * object onto the same previous version of it with equal filters gives
+      * equal results for any two empires. */
+    struct ObjectKnowledgeFilter {
+        ObjectKnowledgeFilter(const Universe& universe, TemporaryPtr<const UniverseObject> obj, int empire_id) :
+            vis(universe.GetObjectVisibilityByEmpire(obj->ID(), empire_id)),
+            visible_specials(universe.GetObjectVisibleSpecialsByEmpire(obj->ID(), empire_id)),
+            visible_contained_ids(obj->VisibleContainedObjectIDs(empire_id))
+        {
+            if (TemporaryPtr<const System> system = boost::dynamic_pointer_cast<const System>(obj))
+                visible_lanes_holes = system->VisibleStarlanesWormholes(empire_id);
+        }
+
+        bool operator<(const ObjectKnowledgeFilter& rhs) const {
+            if (vis != rhs.vis)
+                return vis < rhs.vis;
+            if (visible_specials != rhs.visible_specials)
+                return visible_specials < rhs.visible_specials;
+            if (visible_contained_ids != rhs.visible_contained_ids)
+                return visible_contained_ids < rhs.visible_contained_ids;
+            return visible_lanes_holes < rhs.visible_lanes_holes;
+        }
+
+        Visibility              vis;
+        std::set<std::string>   visible_specials;
+        std::set<int>           visible_contained_ids;
+        std::map<int, bool>     visible_lanes_holes;
+    };
+}
+
 void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
     //DebugLogger() << "Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns()";
 
@@ -3160,10 +3497,18 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
     //          update empire's information about object, based on visibility
     //          update empire's visbilility turn history
 
+    // Empires' latest known objects are shared between empires whose
+    // knowledge of an object is the same.  Empires that had the same
+    // previous version of an object, and that can see the same information
+    // about the object now, are given the same updated version.  A version
+    // that is shared is never modified; updates to it are made on a copy.
+
     int current_turn = CurrentTurn();
     if (current_turn == INVALID_GAME_TURN)
         return;
 
+    typedef std::pair<const UniverseObject*, ObjectKnowledgeFilter> KnowledgeKey;
+
     // for each object in universe
     for (ObjectMap::const_iterator<> it = m_objects.const_begin(); it != m_objects.const_end(); ++it) {
         int object_id = it->ID();
@@ -3173,6 +3518,10 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
             continue;
         }
 
+        // empires that can see the object, grouped by their previous
+        // knowledge of it and by what they can see of it now
+        std::map<KnowledgeKey, std::vector<int> > empires_by_knowledge;
+
         // for each empire with a visibility map
         for (EmpireObjectVisibilityMap::const_iterator empire_it = m_empire_object_visibility.begin();
              empire_it != m_empire_object_visibility.end(); ++empire_it)
@@ -3197,15 +3546,10 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
             VisibilityTurnMap&          vis_turn_map = object_vis_turn_map[object_id];                      // creates empty map if none yet present
 
 
-            // update empire's latest known data about object, based on current visibility and historical visibility and knowledge of object
-
-            // is there already last known version of an UniverseObject stored for this empire?
-            if (TemporaryPtr<UniverseObject> known_obj = known_object_map.Object(object_id)) {
-                known_obj->Copy(full_object, empire_id);                    // already a stored version of this object for this empire.  update it, limited by visibility this empire has for this object this turn
-            } else {
-                if (UniverseObject* new_obj = full_object->Clone(empire_id))    // no previously-recorded version of this object for this empire.  create a new one, copying only the information limtied by visibility, leaving the rest as default values
-                    known_object_map.Insert(new_obj);
-            }
+            // latest known data about object is updated below, once the
+            // empires that can share the updated version are known
+            TemporaryPtr<const UniverseObject> known_obj = known_object_map.Object(object_id);
+            empires_by_knowledge[KnowledgeKey(known_obj.get(), ObjectKnowledgeFilter(*this, full_object, empire_id))].push_back(empire_id);
 
             //DebugLogger() << "Empire " << empire_id << " can see object " << object_id << " with vis level " << vis;
 
@@ -3224,6 +3568,85 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
                 continue;
             }
         }
+
+        if (empires_by_knowledge.empty())
+            continue;
+
+        // count the empires that have each previous version of the object,
+        // including empires that can't see the object this turn
+        std::map<const UniverseObject*, std::size_t> num_holders;
+        for (EmpireObjectMap::const_iterator known_it = m_empire_latest_known_objects.begin();
+             known_it != m_empire_latest_known_objects.end(); ++known_it)
+        {
+            if (TemporaryPtr<const UniverseObject> known_obj = known_it->second.Object(object_id))
+                ++num_holders[known_obj.get()];
+        }
+
+        // update empire's latest known data about object, based on current visibility and historical visibility and knowledge of object
+        for (std::map<KnowledgeKey, std::vector<int> >::const_iterator group_it = empires_by_knowledge.begin();
+             group_it != empires_by_knowledge.end(); ++group_it)
+        {
+            const UniverseObject* previous_obj = group_it->first.first;
+            const std::vector<int>& empire_ids = group_it->second;
+            int first_empire_id = empire_ids.front();
+            ObjectMap& first_known_object_map = m_empire_latest_known_objects[first_empire_id];
+
+            UniverseObject* new_obj = 0;
+            if (!previous_obj) {
+                // no previously-recorded version of this object for these empires.  create a new one, copying only the information limtied by visibility, leaving the rest as default values
+                new_obj = full_object->Clone(first_empire_id);
+
+            } else if (num_holders[previous_obj] == empire_ids.size()) {
+                // no other empire has the previous version, so update it in place, limited by visibility these empires have for this object this turn
+                first_known_object_map.Object(object_id)->Copy(full_object, first_empire_id);
+                continue;
+
+            } else {
+                // previous version is shared with empires whose knowledge
+                // differs, so update a copy of it
+                TemporaryPtr<const UniverseObject> known_obj = first_known_object_map.Object(object_id);
+                new_obj = known_obj->Clone();
+                if (new_obj) {
+                    new_obj->m_specials = known_obj->m_specials;
+                    new_obj->Copy(full_object, first_empire_id);
+                }
+            }
+
+            if (!new_obj)
+                continue;
+            TemporaryPtr<UniverseObject> shared_obj = first_known_object_map.Insert(new_obj);
+            for (std::vector<int>::const_iterator empire_it = empire_ids.begin() + 1; empire_it != empire_ids.end(); ++empire_it)
+                m_empire_latest_known_objects[*empire_it].Insert(shared_obj);
+            if (previous_obj)
+                num_holders[previous_obj] -= empire_ids.size();
+        }
+    }
+}
+
+void Universe::UnshareEmpireLatestKnownObject(int object_id, int empire_id) {
+    EmpireObjectMap::iterator empire_it = m_empire_latest_known_objects.find(empire_id);
+    if (empire_it == m_empire_latest_known_objects.end())
+        return;
+    TemporaryPtr<const UniverseObject> known_obj = empire_it->second.Object(object_id);
+    if (!known_obj)
+        return;
+
+    bool shared = false;
+    for (EmpireObjectMap::const_iterator other_it = m_empire_latest_known_objects.begin();
+         other_it != m_empire_latest_known_objects.end() && !shared; ++other_it)
+    {
+        if (other_it != empire_it && other_it->second.Object(object_id).get() == known_obj.get())
+            shared = true;
+    }
+    if (!shared)
+        return;
+
+    // a complete Clone() takes its specials from the object in the universe,
+    // not from the copied object, so the known specials are restored after
+    // cloning.  the same is done wherever a latest known object is cloned.
+    if (UniverseObject* copy = known_obj->Clone()) {
+        copy->m_specials = known_obj->m_specials;
+        empire_it->second.Insert(copy);
     }
 }
 
@@ -3687,8 +4110,6 @@ void Universe::UpdateEmpireVisibilityFilteredSystemGraphs(int for_empire_id) {
     }
 }
 
-int& Universe::EncodingEmpire()
-{ return m_encoding_empire; }
 
 double Universe::UniverseWidth() const
 { return m_universe_width; }
@@ -32,6 +32,7 @@ struct UniverseObjectVisitor;
 class XMLElement;
 class ShipDesign;
 class System;
+class UniverseSnapshot;
 namespace Condition {
     struct ConditionBase;
     typedef std::vector<TemporaryPtr<const UniverseObject> > ObjectSet;
@@ -76,6 +77,14 @@ public:
     typedef std::map<int, ObjectSpecialsMap>        EmpireObjectSpecialsMap;        ///< map from empire id to ObjectSpecialsMap of known specials for objects for that empire
 
     typedef std::map<int, ShipDesign*>              ShipDesignMap;                  ///< ShipDesigns in universe; keyed by design id
+
+    /** Summary of the stationary fleets at a single system that can restrict
+      * the departure of other fleets from that system. */
+    struct SystemBlockade {
+        std::set<int>           unrestricted_owners;        ///< owners (ALL_EMPIRES for monsters) of stationary fleets here that have unrestricted lane access
+        std::map<int, float>    blockaders;                 ///< owners of stationary, aggressive, armed fleets here, and the detection strength with which those owners see other fleets here
+        std::set<int>           unrestricted_blockaders;    ///< owners in blockaders which have at least one blockading fleet with unrestricted lane access
+    };
     typedef ShipDesignMap::const_iterator           ship_design_iterator;           ///< const iterator over ship designs created by players that are known by this client
 
     /** \name Signal Types */ //@{
@@ -239,6 +248,12 @@ public:
     const std::map<std::string, std::map<int, std::map<int, double> > >&
                                             GetStatRecords() const { return m_stat_records; }
 
+    /** Returns the summary of fleets that could blockade other fleets at the
+      * system with id \a system_id, or 0 if no fleets there are relevant to
+      * blockades.  The summaries for all systems are built together once per
+      * turn when first needed, or again after InvalidateBlockades(). */
+    const SystemBlockade*                   GetSystemBlockade(int system_id) const;
+
     mutable UniverseObjectDeleteSignalType UniverseObjectDeleteSignal; ///< the state changed signal object for this UniverseObject
     //@}
 
@@ -303,6 +318,14 @@ public:
     /** Updates all meters for all (known) objects */
     void            UpdateMeterEstimates();
 
+    /** Updates meter estimates after the object with id \a object_id has
+      * changed, eg. by having its focus set, for only the objects that the
+      * change may affect: the object itself, the objects it contains, the
+      * objects that were targeted by effects of which any of those objects was
+      * the source during previous meter estimate updates, and the objects in
+      * the same system as the changed object. */
+    void            UpdateMeterEstimatesForChangedObject(int object_id);
+
     /** Sets all objects' meters' initial values to their current values. */
     void            BackPropegateObjectMeters();
 
@@ -324,9 +347,16 @@ public:
     /** Stores latest known information about each object for each empire and
       * updates the record of the last turn on which each empire has visibility
       * of object that can be seen on the current turn with the level of
-      * visibility that the empire has this turn. */
+      * visibility that the empire has this turn.  Empires whose knowledge of
+      * an object is the same share a single latest known version of it. */
     void            UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
 
+    /** Ensures that empire \a empire_id's latest known version of object
+      * \a object_id is not shared with any other empire, by replacing it with
+      * a copy if it is, so that it can be modified without changing what
+      * other empires know about the object. */
+    void            UnshareEmpireLatestKnownObject(int object_id, int empire_id);
+
     /** Checks latest known information about each object for each empire and,
       * in cases when the latest known state (stealth and location) suggests
       * that the empire should be able to see the object, but the object can't
@@ -343,6 +373,11 @@ public:
       * graph to account for actual system-starlane connectivity changes. */
     void            UpdateEmpireVisibilityFilteredSystemGraphs(int for_empire_id = ALL_EMPIRES);
 
+    /** Discards the per-system blockade summaries, so that they will be
+      * rebuilt from the current state of fleets when next queried.  Should be
+      * called before fleet movement is processed. */
+    void            InvalidateBlockades();
+
     /** Adds the object ID \a object_id to the set of object ids for the empire
       * with id \a empire_id that the empire knows have been destroyed. */
     void            SetEmpireKnowledgeOfDestroyedObject(int object_id, int empire_id);
@@ -411,13 +446,6 @@ public:
     /** Returns true if UniverseOjbectSignals are inhibited, false otherwise. */
     const bool&     UniverseObjectSignalsInhibited();
 
-    /** HACK! This must be set to the encoding empire's id when serializing a
-      * Universe, so that only the relevant parts of the Universe are
-      * serialized.  The use of this global variable is done just so I don't
-      * have to rewrite any custom boost::serialization classes that implement
-      * empire-dependent visibility. */
-    int&            EncodingEmpire();
-
     double          UniverseWidth() const;
     void            SetUniverseWidth(double width) { m_universe_width = width; }
     bool            AllObjectsVisible() const { return m_all_objects_visible; }
@@ -516,6 +544,14 @@ private:
       * vector is passed, it will instead update all existing objects. */
     void    UpdateMeterEstimatesImpl(const std::vector<int>& objects_vec);
 
+    /** Rebuilds m_system_blockades from the fleets currently in each system. */
+    void    UpdateSystemBlockades() const;
+
+    /** Records the meters and effect accounting of the object with id
+      * \a object_id in the active UniverseSnapshot(s), if any, before meter
+      * estimation changes them. */
+    void    RecordSnapshotMeters(int object_id);
+
     ObjectMap                       m_objects;                          ///< map from object id to UniverseObjects in the universe.  for the server: all of them, up to date and true information about object is stored;  for clients, only limited information based on what the client knows about is sent.
     EmpireObjectMap                 m_empire_latest_known_objects;      ///< map from empire id to (map from object id to latest known information about each object by that empire)
 
@@ -537,8 +573,13 @@ private:
     boost::shared_ptr<GraphImpl>    m_graph_impl;                       ///< a graph in which the systems are vertices and the starlanes are edges
     boost::unordered_map<int, size_t>  m_system_id_to_graph_index;
 
+    mutable std::map<int, SystemBlockade>
+                                    m_system_blockades;                 ///< indexed by system id, summaries of fleets that could blockade other fleets there
+    mutable int                     m_system_blockades_turn;            ///< turn on which m_system_blockades was last built, or INVALID_GAME_TURN if it needs rebuilding
+
     Effect::AccountingMap           m_effect_accounting_map;            ///< map from target object id, to map from target meter, to orderered list of structs with details of an effect and what it does to the meter
     Effect::DiscrepancyMap          m_effect_discrepancy_map;           ///< map from target object id, to map from target meter, to discrepancy between meter's actual initial value, and the initial value that this meter should have as far as the client can tell: the unknown factor affecting the meter
+    std::map<int, std::set<int> >   m_effect_targets_by_source;         ///< map from source object id, to ids of objects targeted by effects of that source during meter estimate updates since the last update of all objects' estimates
 
     int                             m_last_allocated_object_id;
     int                             m_last_allocated_design_id;
@@ -548,8 +589,8 @@ private:
 
     double                          m_universe_width;
     bool                            m_inhibit_universe_object_signals;
-    int                             m_encoding_empire;                  ///< used during serialization to globally set what empire knowledge to use
     bool                            m_all_objects_visible;              ///< flag set to skip visibility tests and make everything visible to all players
+    UniverseSnapshot*               m_snapshot;                         ///< innermost snapshot currently recording changes, or 0
 
     std::map<std::string, std::map<int, std::map<int, double> > >
                                     m_stat_records;                     ///< storage for statistics calculated for empires. Indexed by stat name (string), contains a map indexed by empire id, contains a map from turn number (int) to stat value (double).
@@ -589,10 +630,60 @@ private:
     template <class T>
     TemporaryPtr<T> InsertNewObject(T* object);
 
+    friend class UniverseSnapshot;
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
 };
 
+/** Records the state of objects that speculative calculations change, such
+  * as meter estimates or pretend ownership of planets, and restores that
+  * state when destroyed.  Objects are recorded the first time they are
+  * changed while the snapshot exists, so restoring takes time proportional
+  * to the number of objects changed instead of to the size of the universe,
+  * and no estimate pass is needed to undo the speculation.
+  *
+  * Snapshots can be nested, but must be destroyed in the reverse order of
+  * their creation.  Objects created or deleted while a snapshot exists are
+  * not tracked. */
+class FO_COMMON_API UniverseSnapshot {
+public:
+    /** Starts recording changes to \a universe.  If \a record_meters is
+      * false, only ownership changes made with SetOwner() are recorded and
+      * undone, and meters estimated while the snapshot exists are kept. */
+    explicit UniverseSnapshot(Universe& universe, bool record_meters = true);
+    ~UniverseSnapshot();                            ///< restores the recorded state
+
+    /** Sets the owner of \a obj to \a empire_id, after recording its
+      * current owner. */
+    void    SetOwner(TemporaryPtr<UniverseObject> obj, int empire_id);
+
+    /** Records the meters and effect accounting of the object with id
+      * \a object_id, if not already recorded, so that changes made to its
+      * meters directly rather than by meter estimation are undone too. */
+    void    RecordMeters(int object_id);
+
+    /** Restores all objects changed so far to their recorded state.  The
+      * snapshot continues to record changes afterwards. */
+    void    Restore();
+
+private:
+    struct ObjectState;
+    typedef std::map<int, boost::shared_ptr<ObjectState> > ObjectStateMap;
+
+    UniverseSnapshot(const UniverseSnapshot&);              // disabled
+    UniverseSnapshot& operator=(const UniverseSnapshot&);   // disabled
+
+    ObjectState&    State(int object_id);
+    void            RecordOwner(TemporaryPtr<const UniverseObject> obj);
+
+    Universe&           m_universe;
+    UniverseSnapshot*   m_previous;         ///< snapshot that was active when this one was created
+    bool                m_record_meters;
+    ObjectStateMap      m_states;           ///< recorded state of changed objects, indexed by object id
+
+    friend class Universe;
+};
+
 
 #endif // _Universe_h_
@@ -29,23 +29,56 @@ namespace {
     const double        PI                          = 3.141592653589793;
     const int           MAX_ATTEMPTS_PLACE_SYSTEM   = 100;
 
-    double CalcNewPosNearestNeighbour(double x, double y, const std::vector<SystemPosition>& positions)
-    {
-        if (positions.size() == 0) // means that we are placing the first star, return a max val to not reject placement
-            return 1e6;
-
-        unsigned int j;
-        double lowest_dist=  (positions[0].x  - x ) * (positions[0].x  - x ) 
-            + (positions[0].y - y) * (positions[0].y - y),distance=0.0;
-
-        for (j = 1; j < positions.size(); ++j) {
-            distance =  (positions[j].x  - x ) * (positions[j].x  - x ) 
-                + (positions[j].y - y) * (positions[j].y - y);
-            if(lowest_dist>distance)
-                lowest_dist = distance;
+    /** Buckets already-placed system positions into square cells of side
+      * MIN_SYSTEM_SEPARATION, so that a candidate position only needs to be
+      * compared against the positions in its own and the eight surrounding
+      * cells, instead of against every position placed so far. */
+    class SystemPositionGrid {
+    public:
+        SystemPositionGrid(const std::vector<SystemPosition>& positions, double width, double height) :
+            m_columns(std::max(1, static_cast<int>(width / MIN_SYSTEM_SEPARATION) + 1)),
+            m_rows(std::max(1, static_cast<int>(height / MIN_SYSTEM_SEPARATION) + 1)),
+            m_cells(m_columns * m_rows)
+        {
+            for (std::vector<SystemPosition>::const_iterator it = positions.begin(); it != positions.end(); ++it)
+                Add(it->x, it->y);
         }
-        return lowest_dist;
-    }
+
+        void Add(double x, double y)
+        { m_cells[Row(y) * m_columns + Column(x)].push_back(SystemPosition(x, y)); }
+
+        /** Returns the squared distance from (\a x, \a y) to the nearest
+          * added position if that is closer than MIN_SYSTEM_SEPARATION, or a
+          * value no smaller than MIN_SYSTEM_SEPARATION squared otherwise. */
+        double NearestDistanceSquared(double x, double y) const {
+            double lowest_dist = 1e6;   // nothing nearby; return a max val to not reject placement
+            int column = Column(x), row = Row(y);
+            for (int r = std::max(0, row - 1); r <= std::min(m_rows - 1, row + 1); ++r) {
+                for (int c = std::max(0, column - 1); c <= std::min(m_columns - 1, column + 1); ++c) {
+                    const std::vector<SystemPosition>& cell = m_cells[r * m_columns + c];
+                    for (std::vector<SystemPosition>::const_iterator it = cell.begin(); it != cell.end(); ++it) {
+                        double distance = (it->x - x) * (it->x - x) + (it->y - y) * (it->y - y);
+                        if (distance < lowest_dist)
+                            lowest_dist = distance;
+                    }
+                }
+            }
+            return lowest_dist;
+        }
+
+    private:
+        // positions outside the galaxy (which callers may pass in) are
+        // clamped to the border cells, which keeps neighbouring positions in
+        // neighbouring cells
+        int Column(double x) const
+        { return std::max(0, std::min(m_columns - 1, static_cast<int>(std::floor(x / MIN_SYSTEM_SEPARATION)))); }
+        int Row(double y) const
+        { return std::max(0, std::min(m_rows - 1, static_cast<int>(std::floor(y / MIN_SYSTEM_SEPARATION)))); }
+
+        int                                         m_columns;
+        int                                         m_rows;
+        std::vector<std::vector<SystemPosition> >   m_cells;
+    };
 }
 
 double CalcTypicalUniverseWidth(int size)
@@ -68,6 +101,8 @@ void SpiralGalaxyCalcPositions(std::vector<SystemPosition>& positions,
     DoubleDistType    random_angle    = DoubleDist  (0.0,2.0*PI);
     DoubleDistType    random_radius   = DoubleDist  (0.0,  1.0);
     
+    SystemPositionGrid grid(positions, width, height);
+    
     for (i = 0, attempts = 0; i < static_cast<int>(stars) && attempts < MAX_ATTEMPTS_PLACE_SYSTEM; ++i, ++attempts) {
         double radius = random_radius();
         
@@ -90,7 +125,7 @@ void SpiralGalaxyCalcPositions(std::vector<SystemPosition>& positions,
             continue;
         
         // See if new star is too close to any existing star.
-        double lowest_dist = CalcNewPosNearestNeighbour(x, y, positions);
+        double lowest_dist = grid.NearestDistanceSquared(x, y);
         
         // If so, we try again or give up.
         if (lowest_dist < MIN_SYSTEM_SEPARATION * MIN_SYSTEM_SEPARATION) {
@@ -105,6 +140,7 @@ void SpiralGalaxyCalcPositions(std::vector<SystemPosition>& positions,
         
         // Add the new star location.
         positions.push_back(SystemPosition(x, y));
+        grid.Add(x, y);
         
         // Note that attempts is reset for every star.
         attempts = 0;
@@ -125,6 +161,8 @@ void EllipticalGalaxyCalcPositions(std::vector<SystemPosition>& positions,
     DoubleDistType radius_dist = DoubleDist(0.0, gap_constant);
     DoubleDistType random_angle  = DoubleDist(0.0, 2.0 * PI);
     
+    SystemPositionGrid grid(positions, width, height);
+    
     // Used to give up when failing to place a star too often.
     int attempts = 0;
     
@@ -152,7 +190,7 @@ void EllipticalGalaxyCalcPositions(std::vector<SystemPosition>& positions,
             continue;
         
         // See if new star is too close to any existing star.
-        double lowest_dist = CalcNewPosNearestNeighbour(x, y, positions);
+        double lowest_dist = grid.NearestDistanceSquared(x, y);
         
         // If so, we try again or give up.
         if (lowest_dist < MIN_SYSTEM_SEPARATION * MIN_SYSTEM_SEPARATION) {
@@ -167,6 +205,7 @@ void EllipticalGalaxyCalcPositions(std::vector<SystemPosition>& positions,
         
         // Add the new star location.
         positions.push_back(SystemPosition(x, y));
+        grid.Add(x, y);
         
         // Note that attempts is reset for every star.
         attempts = 0;
@@ -221,6 +260,8 @@ void ClusterGalaxyCalcPositions(std::vector<SystemPosition>& positions, unsigned
         clusters_position.push_back(std::pair<std::pair<double,double>,std::pair<double,double> >(std::pair<double,double>(x,y),std::pair<double,double>(sin(rotation),cos(rotation))));
     }
     
+    SystemPositionGrid grid(positions, width, height);
+    
     for (i = 0, attempts = 0; i < stars && attempts<100; i++, attempts++) {
         double x,y;
         if (random_zero_to_one() < system_noise) {
@@ -248,7 +289,7 @@ void ClusterGalaxyCalcPositions(std::vector<SystemPosition>& positions, unsigned
             continue;
         
         // See if new star is too close to any existing star.
-        double lowest_dist = CalcNewPosNearestNeighbour(x, y, positions);
+        double lowest_dist = grid.NearestDistanceSquared(x, y);
         
         // If so, we try again or give up.
         if (lowest_dist < MIN_SYSTEM_SEPARATION * MIN_SYSTEM_SEPARATION) {
@@ -263,6 +304,7 @@ void ClusterGalaxyCalcPositions(std::vector<SystemPosition>& positions, unsigned
         
         // Add the new star location.
         positions.push_back(SystemPosition(x, y));
+        grid.Add(x, y);
         
         // Note that attempts is reset for every star.
         attempts = 0;
@@ -278,6 +320,8 @@ void RingGalaxyCalcPositions(std::vector<SystemPosition>& positions, unsigned in
     DoubleDistType   theta_dist = DoubleDist(0.0, 2.0 * PI);
     GaussianDistType radius_dist = GaussianDist(RING_RADIUS, RING_WIDTH / 3.0);
     
+    SystemPositionGrid grid(positions, width, height);
+    
     for (unsigned int i = 0, attempts = 0; i < stars && static_cast<int>(attempts) < MAX_ATTEMPTS_PLACE_SYSTEM; ++i, ++attempts) {
         double theta = theta_dist();
         double radius = radius_dist();
@@ -289,7 +333,7 @@ void RingGalaxyCalcPositions(std::vector<SystemPosition>& positions, unsigned in
             continue;
         
         // See if new star is too close to any existing star.
-        double lowest_dist=CalcNewPosNearestNeighbour(x, y,positions);
+        double lowest_dist = grid.NearestDistanceSquared(x, y);
         
         // If so, we try again or give up.
         if (lowest_dist < MIN_SYSTEM_SEPARATION * MIN_SYSTEM_SEPARATION) {
@@ -304,6 +348,7 @@ void RingGalaxyCalcPositions(std::vector<SystemPosition>& positions, unsigned in
         
         // Add the new star location.
         positions.push_back(SystemPosition(x, y));
+        grid.Add(x, y);
         
         // Note that attempts is reset for every star.
         attempts = 0;
@@ -315,6 +360,8 @@ void IrregularGalaxyPositions(std::vector<SystemPosition>& positions, unsigned i
 {
     DebugLogger() << "IrregularGalaxyPositions";
 
+    SystemPositionGrid grid(positions, width, height);
+
     unsigned int positions_placed = 0;
     for (unsigned int i = 0, attempts = 0; i < stars && static_cast<int>(attempts) < MAX_ATTEMPTS_PLACE_SYSTEM; ++i, ++attempts) {
 
@@ -329,7 +376,7 @@ void IrregularGalaxyPositions(std::vector<SystemPosition>& positions, unsigned i
             continue;
 
         // See if new star is too close to any existing star.
-        double lowest_dist = CalcNewPosNearestNeighbour(x, y, positions);
+        double lowest_dist = grid.NearestDistanceSquared(x, y);
 
         // If so, we try again or give up.
         if (lowest_dist < MIN_SYSTEM_SEPARATION * MIN_SYSTEM_SEPARATION) {
@@ -344,6 +391,7 @@ void IrregularGalaxyPositions(std::vector<SystemPosition>& positions, unsigned i
 
         // Add the new star location.
         positions.push_back(SystemPosition(x, y));
+        grid.Add(x, y);
 
         DebugLogger() << "... added system at (" << x << ", " << y << ") after " << attempts << " attempts";
 
@@ -375,20 +423,6 @@ namespace Delauney {
         double  y;
     };
 
-    /* simple class for an integer that has an associated "sorting value",
-     * so the integer can be stored in a list sorted by something other than
-     * the value of the integer */
-    class SortValInt {
-    public:
-        SortValInt(int num_, double sort_val_) :
-            num(num_),
-            sortVal(sort_val_)
-        {}
-        int     num;
-        double  sortVal;
-    };
-
-
     /** list of three interger array indices, and some additional info about
       * the triangle that the corresponding points make up, such as the
       * circumcentre and radius, and a function to find if another point is in
@@ -473,20 +507,80 @@ namespace Delauney {
 
 
 
+    /** triangle in the triangulation that is being built, with the indices
+      * of the triangles adjacent to it.  vertices are stored in
+      * counterclockwise order, and neighbours[i] is the triangle across the
+      * edge opposite verts[i], or -1 if that edge is on the covering
+      * triangle's boundary */
+    struct DTMeshTriangle {
+        DTMeshTriangle(int vert1, int vert2, int vert3, std::vector<Delauney::DTPoint>& points) :
+            triangle(vert1, vert2, vert3, points),
+            alive(true),
+            cavity_mark(-1),
+            rejected_mark(-1)
+        {
+            verts[0] = vert1;   verts[1] = vert2;   verts[2] = vert3;
+            neighbours[0] = neighbours[1] = neighbours[2] = -1;
+        }
+
+        Delauney::DTTriangle    triangle;
+        int                     verts[3];
+        int                     neighbours[3];
+        bool                    alive;
+        int                     cavity_mark;    ///< index of last point for which this triangle was found to be in the cavity
+        int                     rejected_mark;  ///< index of last point for which this triangle was found to be outside the cavity
+    };
+
+    /** edge of the region of triangles removed by the insertion of a point,
+      * with the triangle outside of the region across that edge */
+    struct DTCavityEdge {
+        DTCavityEdge(int vert1_, int vert2_, int outside_) :
+            vert1(vert1_),
+            vert2(vert2_),
+            outside(outside_)
+        {}
+        int vert1;
+        int vert2;
+        int outside;    ///< triangle across the edge, or -1
+    };
+
+    /** twice the signed area of triangle abc; positive if a, b and c are in
+      * counterclockwise order */
+    double Orientation(const Delauney::DTPoint& a, const Delauney::DTPoint& b, const Delauney::DTPoint& c)
+    { return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x); }
+
+    /** orders points along alternating-direction horizontal strips, so that
+      * consecutively inserted points are usually close to each other */
+    struct DTStripOrder {
+        DTStripOrder(const std::vector<Delauney::DTPoint>& points, double strip_height) :
+            m_points(points),
+            m_strip_height(strip_height)
+        {}
+
+        bool operator()(int lhs, int rhs) const {
+            int lhs_strip = static_cast<int>(m_points[lhs].y / m_strip_height);
+            int rhs_strip = static_cast<int>(m_points[rhs].y / m_strip_height);
+            if (lhs_strip != rhs_strip)
+                return lhs_strip < rhs_strip;
+            if (lhs_strip % 2)
+                return m_points[lhs].x > m_points[rhs].x;
+            return m_points[lhs].x < m_points[rhs].x;
+        }
+
+        const std::vector<Delauney::DTPoint>&   m_points;
+        double                                  m_strip_height;
+    };
+
     /** runs a Delauney Triangulation routine on a set of 2D points extracted
-      * from an array of systems returns the list of triangles produced */
+      * from an array of systems returns the list of triangles produced.
+      * points are inserted one at a time (Bowyer-Watson).  the triangle
+      * containing each new point is found by walking across the mesh from the
+      * most recently created triangle, and the triangles whose circumcircles
+      * contain the new point are found by searching outward from there, so
+      * that each insertion only visits triangles near the inserted point. */
     std::list<Delauney::DTTriangle>* DelauneyTriangulate(std::vector<TemporaryPtr<System> > &systems) {
-
-        int n, c, theSize, num, num2; // loop counters, storage for retreived size of a vector, temp storage
-        std::list<Delauney::DTTriangle>::iterator itCur, itEnd;
-        std::list<Delauney::SortValInt>::iterator itCur2, itEnd2;
         // vector of x and y positions of stars
         std::vector<Delauney::DTPoint> points;
-        // pointer to main list of triangles algorithm works with.
-        std::list<Delauney::DTTriangle> *triList;
-        // list of indices in vector of points extracted from removed triangles that need to be retriangulated
-        std::list<Delauney::SortValInt> pointNumList;
-        double vx, vy, mag;  // vector components, magnitude
 
         // ensure a useful list of systems was passed...
         if (systems.empty())
@@ -494,110 +588,165 @@ namespace Delauney {
 
         // extract systems positions, and store in vector.  Can't use actual systems data since
         // systems have position limitations which would interfere with algorithm
-        theSize = static_cast<int>(systems.size());
-        for (n = 0; n < theSize; n++) {
+        int num_systems = static_cast<int>(systems.size());
+        for (int n = 0; n < num_systems; n++) {
             points.push_back(Delauney::DTPoint(systems[n]->X(), systems[n]->Y()));
         }
 
         // add points for covering triangle.  the point positions should be big enough to form a triangle
         // that encloses all the systems of the galaxy (or at least one whose circumcircle covers all points)
+        double universe_width = GetUniverse().UniverseWidth();
         points.push_back(Delauney::DTPoint(-1.0, -1.0));
-        points.push_back(Delauney::DTPoint(2.0 * (GetUniverse().UniverseWidth() + 1.0), -1.0));
-        points.push_back(Delauney::DTPoint(-1.0, 2.0 * (GetUniverse().UniverseWidth() + 1.0)));
+        points.push_back(Delauney::DTPoint(2.0 * (universe_width + 1.0), -1.0));
+        points.push_back(Delauney::DTPoint(-1.0, 2.0 * (universe_width + 1.0)));
+
+        // insert points in an order that keeps successive points near each
+        // other, so that walks to find the triangle containing each are short
+        std::vector<int> insertion_order(num_systems);
+        for (int n = 0; n < num_systems; ++n)
+            insertion_order[n] = n;
+        double strip_height = std::max(1.0, universe_width / std::sqrt(static_cast<double>(num_systems)));
+        std::sort(insertion_order.begin(), insertion_order.end(), DTStripOrder(points, strip_height));
 
-        // initialize triList.  algorithm adds and removes triangles from this list, and the resulting
-        // list is returned (so should be deleted externally)
-        triList = new std::list<Delauney::DTTriangle>;
+        // triangles of the mesh.  slots of removed triangles are reused.
+        std::vector<Delauney::DTMeshTriangle> mesh;
+        std::vector<int> free_slots;
 
         // add last three points into the first triangle, the "covering triangle"
-        theSize = static_cast<int>(points.size());
-        triList->push_front(Delauney::DTTriangle(theSize-1, theSize-2, theSize-3, points));
-
-        // loop through "real" points (from systems, not the last three added to make the covering triangle)
-        for (n = 0; n < theSize - 3; n++) {
-            pointNumList.clear();
-
-            // check each triangle in list, to see if the new point lies in its circumcircle.  if so, delete
-            // the triangle and add its vertices to a list 
-            itCur = triList->begin();
-            itEnd = triList->end();
-            while (itCur != itEnd) {
-                // get current triangle
-                Delauney::DTTriangle& tri = *itCur;
-
-                // check if point to be added to triangulation is within the circumcircle for the current triangle
-                if (tri.PointInCircumCircle(points[n])) {
-                    // if so, insert the triangle's vertices' indices into the list.  add in sorted position
-                    // based on angle of direction to current point n being inserted.  don't add if doing
-                    // so would duplicate an index already in the list
-                    for (c = 0; c < 3; c++) {
-                        num = (tri.Verts())[c];  // store "current point"
-
-                        // get sorting value to order points clockwise circumferentially around point n
-                        // vector from point n to current point
-                        vx = points[num].x - points[n].x;
-                        vy = points[num].y - points[n].y;
-                        mag = sqrt(vx*vx + vy*vy);
-                        // normalize
-                        vx /= mag;
-                        vy /= mag;
-                        // dot product with (0, 1) is vy, magnitude of cross product is vx
-                        // this gives a range of "sortValue" from -2 to 2, around the circle
-                        if (vx >= 0) mag = vy + 1; else mag = -vy - 1;
-                        // sorting value in "mag"
-
-                        // iterate through list, finding insert spot and verifying uniqueness (or add if list is empty)
-                        itCur2 = pointNumList.begin();
-                        itEnd2 = pointNumList.end();
-                        if (itCur2 == itEnd2) {
-                            // list is empty
-                            pointNumList.push_back(Delauney::SortValInt(num, mag));
-                        } else {
-                            while (itCur2 != itEnd2) {
-                                if (itCur2->num == num) 
-                                    break;
-                                if (itCur2->sortVal > mag) {
-                                    pointNumList.insert(itCur2, Delauney::SortValInt(num, mag));
-                                    break;
-                                }
-                                itCur2++;
-                            }
-                            if (itCur2 == itEnd2) {
-                                // point wasn't added, so should go at end
-                                pointNumList.push_back(Delauney::SortValInt(num, mag));
+        mesh.push_back(Delauney::DTMeshTriangle(num_systems, num_systems + 1, num_systems + 2, points));
+        int last_triangle = 0;
+
+        std::vector<int> cavity;
+        std::vector<Delauney::DTCavityEdge> cavity_edges;
+        std::vector<int> new_triangles;
+
+        for (std::vector<int>::const_iterator order_it = insertion_order.begin();
+             order_it != insertion_order.end(); ++order_it)
+        {
+            int n = *order_it;
+            Delauney::DTPoint& point = points[n];
+
+            // walk towards the point until reaching a triangle that contains it.
+            // if the walk takes suspiciously long, fall back to checking every
+            // triangle
+            int current = last_triangle;
+            std::size_t steps = 0;
+            while (true) {
+                const Delauney::DTMeshTriangle& tri = mesh[current];
+                int next = -1;
+                for (int i = 0; i < 3; ++i) {
+                    if (tri.neighbours[i] != -1 &&
+                        Orientation(points[tri.verts[(i + 1) % 3]], points[tri.verts[(i + 2) % 3]], point) < 0.0)
+                    {
+                        next = tri.neighbours[i];
+                        break;
+                    }
+                }
+                if (next == -1)
+                    break;
+                current = next;
+                if (++steps > mesh.size()) {
+                    for (current = 0; current < static_cast<int>(mesh.size()); ++current) {
+                        const Delauney::DTMeshTriangle& candidate = mesh[current];
+                        if (candidate.alive &&
+                            Orientation(points[candidate.verts[0]], points[candidate.verts[1]], point) >= 0.0 &&
+                            Orientation(points[candidate.verts[1]], points[candidate.verts[2]], point) >= 0.0 &&
+                            Orientation(points[candidate.verts[2]], points[candidate.verts[0]], point) >= 0.0)
+                        { break; }
+                    }
+                    if (current == static_cast<int>(mesh.size()))
+                        throw std::runtime_error("Delauney Triangulation couldn't find triangle containing point");
+                    break;
+                }
+            }
+
+            // find the connected set of triangles whose circumcircles contain
+            // the point, starting from the triangle that contains it, and the
+            // edges that bound that set
+            cavity.clear();
+            cavity_edges.clear();
+            cavity.push_back(current);
+            mesh[current].cavity_mark = n;
+            for (std::size_t c = 0; c < cavity.size(); ++c) {
+                int cavity_tri = cavity[c];
+                for (int i = 0; i < 3; ++i) {
+                    int neighbour = mesh[cavity_tri].neighbours[i];
+                    if (neighbour != -1) {
+                        Delauney::DTMeshTriangle& neighbour_tri = mesh[neighbour];
+                        if (neighbour_tri.cavity_mark == n)
+                            continue;
+                        if (neighbour_tri.rejected_mark != n) {
+                            if (neighbour_tri.triangle.PointInCircumCircle(point)) {
+                                neighbour_tri.cavity_mark = n;
+                                cavity.push_back(neighbour);
+                                continue;
                             }
+                            neighbour_tri.rejected_mark = n;
                         }
-                    } // end for c
-
-                    // remove current triangle from list of triangles
-                    itCur = triList->erase(itCur);
-                } else {
-                    // point not in circumcircle for this triangle
-                    // to go next triangle in list
-                    ++itCur;
+                    }
+                    cavity_edges.push_back(Delauney::DTCavityEdge(mesh[cavity_tri].verts[(i + 1) % 3],
+                                                                  mesh[cavity_tri].verts[(i + 2) % 3],
+                                                                  neighbour));
                 }
-            } // end while
-
-            // go through list of points, making new triangles out of them
-            itCur2 = pointNumList.begin();
-            itEnd2 = pointNumList.end();
-            assert(itCur2 != itEnd2);
+            }
 
-            // add triangle for last and first points and n
-            triList->push_front(Delauney::DTTriangle(n, (pointNumList.front()).num, (pointNumList.back()).num, points));
+            // remove the triangles in the cavity
+            for (std::vector<int>::const_iterator it = cavity.begin(); it != cavity.end(); ++it) {
+                mesh[*it].alive = false;
+                free_slots.push_back(*it);
+            }
 
-            num = itCur2->num;
-            ++itCur2;
-            while (itCur2 != itEnd2) {
-                num2 = num;
-                num = itCur2->num;
+            // fill the cavity with triangles connecting the point to each of
+            // its bounding edges
+            new_triangles.clear();
+            for (std::vector<Delauney::DTCavityEdge>::const_iterator it = cavity_edges.begin();
+                 it != cavity_edges.end(); ++it)
+            {
+                Delauney::DTMeshTriangle new_tri(n, it->vert1, it->vert2, points);
+                new_tri.neighbours[0] = it->outside;
+                int slot;
+                if (free_slots.empty()) {
+                    slot = static_cast<int>(mesh.size());
+                    mesh.push_back(new_tri);
+                } else {
+                    slot = free_slots.back();
+                    free_slots.pop_back();
+                    mesh[slot] = new_tri;
+                }
+                new_triangles.push_back(slot);
+
+                // point the triangle across the edge to the new triangle.  the
+                // edge is identified by its vertices, as the removed
+                // triangle's slot may already have been reused.
+                if (it->outside != -1) {
+                    Delauney::DTMeshTriangle& outside_tri = mesh[it->outside];
+                    for (int i = 0; i < 3; ++i)
+                        if (outside_tri.verts[i] != it->vert1 && outside_tri.verts[i] != it->vert2)
+                            outside_tri.neighbours[i] = slot;
+                }
+            }
 
-                triList->push_front(Delauney::DTTriangle(n, num2, num, points));
+            // link the new triangles to each other.  new triangle (n, a, b)
+            // shares edge (b, n) with the new triangle (n, b, c) and edge
+            // (n, a) with the new triangle (n, z, a)
+            for (std::vector<int>::const_iterator it = new_triangles.begin(); it != new_triangles.end(); ++it) {
+                Delauney::DTMeshTriangle& tri = mesh[*it];
+                for (std::vector<int>::const_iterator it2 = new_triangles.begin(); it2 != new_triangles.end(); ++it2) {
+                    if (mesh[*it2].verts[1] == tri.verts[2])
+                        tri.neighbours[1] = *it2;
+                    if (mesh[*it2].verts[2] == tri.verts[1])
+                        tri.neighbours[2] = *it2;
+                }
+            }
 
-                ++itCur2;
-            } // end while
+            last_triangle = new_triangles.back();
+        }
 
-        } // end for
+        // the resulting list is returned (so should be deleted externally)
+        std::list<Delauney::DTTriangle>* triList = new std::list<Delauney::DTTriangle>;
+        for (std::vector<Delauney::DTMeshTriangle>::const_iterator it = mesh.begin(); it != mesh.end(); ++it)
+            if (it->alive)
+                triList->push_back(it->triangle);
         return triList;
     } // end function
 }
@@ -11,6 +11,8 @@
 
 #include <stdexcept>
 #include <boost/lexical_cast.hpp>
+#include <boost/pool/pool.hpp>
+#include <boost/thread/mutex.hpp>
 
 
 // static(s)
@@ -21,6 +23,54 @@ const double    UniverseObject::INVALID_POSITION  = -100000.0;
 const int       UniverseObject::INVALID_OBJECT_AGE = -(1 << 30) - 1;  // using big negative number to allow for potential negative object ages, which might be useful in the event of time travel.
 const int       UniverseObject::SINCE_BEFORE_TIME_AGE = (1 << 30) + 1;
 
+namespace {
+    /** Pools from which UniverseObjects are allocated, one per object size. */
+    class UniverseObjectPools {
+    public:
+        void* Allocate(std::size_t size) {
+            boost::mutex::scoped_lock lock(m_mutex);
+            boost::shared_ptr<boost::pool<> >& pool = m_pools[size];
+            if (!pool)
+                pool.reset(new boost::pool<>(size, OBJECTS_PER_CHUNK));
+            void* retval = pool->malloc();
+            if (!retval)
+                throw std::bad_alloc();
+            return retval;
+        }
+
+        void Free(void* p, std::size_t size) {
+            boost::mutex::scoped_lock lock(m_mutex);
+            std::map<std::size_t, boost::shared_ptr<boost::pool<> > >::iterator it = m_pools.find(size);
+            if (it != m_pools.end())
+                it->second->free(p);
+        }
+
+    private:
+        static const std::size_t OBJECTS_PER_CHUNK = 256;
+
+        boost::mutex                                                m_mutex;
+        std::map<std::size_t, boost::shared_ptr<boost::pool<> > >  m_pools;
+    };
+
+    UniverseObjectPools& GetUniverseObjectPools() {
+        // never destroyed, as objects may still be deleted during static
+        // destruction, after a static pools object would have been destroyed
+        static UniverseObjectPools* pools = new UniverseObjectPools();
+        return *pools;
+    }
+
+    // ensure the pools exist before any threads could first use them
+    UniverseObjectPools& s_universe_object_pools = GetUniverseObjectPools();
+}
+
+void* UniverseObject::operator new(std::size_t size)
+{ return GetUniverseObjectPools().Allocate(size); }
+
+void UniverseObject::operator delete(void* p, std::size_t size) {
+    if (p)
+        GetUniverseObjectPools().Free(p, size);
+}
+
 UniverseObject::UniverseObject() :
     StateChangedSignal(blocking_combiner<boost::signals2::optional_last_value<void> >(GetUniverse().UniverseObjectSignalsInhibited())),
     m_name(""),
@@ -14,6 +14,7 @@
 #include <boost/signals2/signal.hpp>
 #include <boost/signals2/optional_last_value.hpp>
 
+#include <cstddef>
 #include <set>
 #include <string>
 #include <vector>
@@ -161,6 +162,16 @@ public:
     virtual void            PopGrowthProductionResearchPhase() {};
     //@}
 
+    /** \name Allocation */ //@{
+    /** UniverseObjects are allocated from pools segregated by object size,
+      * which in practice is one pool per UniverseObject subclass, so that
+      * objects of the same type are packed together and the many objects
+      * created and destroyed while processing turns or loading games don't
+      * fragment the heap. */
+    static void*                operator new(std::size_t size);
+    static void                 operator delete(void* p, std::size_t size);
+    //@}
+
     static const double         INVALID_POSITION;       ///< the position in x and y at which default-constructed objects are placed
     static const int            INVALID_OBJECT_AGE;     ///< the age returned by UniverseObject::AgeInTurns() if the current turn is INVALID_GAME_TURN, or if the turn on which an object was created is INVALID_GAME_TURN
     static const int            SINCE_BEFORE_TIME_AGE;  ///< the age returned by UniverseObject::AgeInTurns() if an object was created on turn BEFORE_FIRST_TURN
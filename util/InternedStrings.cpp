@@ -0,0 +1,59 @@
+#include "InternedStrings.h"
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <deque>
+
+
+namespace {
+    struct InternedStringTable {
+        boost::unordered_map<std::string, StringID> ids;
+        std::deque<std::string>                     strings;    // indexed by id; a deque so that references to strings remain valid as more are added
+        boost::shared_mutex                         mutex;
+    };
+
+    InternedStringTable& GetInternedStringTable() {
+        static InternedStringTable table;
+        return table;
+    }
+
+    const std::string EMPTY_STRING;
+}
+
+StringID InternString(const std::string& str) {
+    if (str.empty())
+        return INVALID_STRING_ID;
+
+    StringID retval = InternedStringID(str);
+    if (retval != INVALID_STRING_ID)
+        return retval;
+
+    InternedStringTable& table = GetInternedStringTable();
+    boost::unique_lock<boost::shared_mutex> lock(table.mutex);
+    // another thread may have interned str since it was looked up above
+    std::pair<boost::unordered_map<std::string, StringID>::iterator, bool> inserted =
+        table.ids.insert(std::make_pair(str, static_cast<StringID>(table.strings.size())));
+    if (inserted.second)
+        table.strings.push_back(str);
+    return inserted.first->second;
+}
+
+StringID InternedStringID(const std::string& str) {
+    if (str.empty())
+        return INVALID_STRING_ID;
+
+    InternedStringTable& table = GetInternedStringTable();
+    boost::shared_lock<boost::shared_mutex> lock(table.mutex);
+    boost::unordered_map<std::string, StringID>::const_iterator it = table.ids.find(str);
+    return it != table.ids.end() ? it->second : INVALID_STRING_ID;
+}
+
+const std::string& InternedString(StringID id) {
+    InternedStringTable& table = GetInternedStringTable();
+    boost::shared_lock<boost::shared_mutex> lock(table.mutex);
+    if (id < 0 || id >= static_cast<StringID>(table.strings.size()))
+        return EMPTY_STRING;
+    return table.strings[id];
+}
@@ -0,0 +1,35 @@
+// -*- C++ -*-
+#ifndef _InternedStrings_h_
+#define _InternedStrings_h_
+
+#include "Export.h"
+
+#include <string>
+
+/** \file InternedStrings.h
+    Content names, such as those of species, are interned when content is
+    loaded or objects are given them, so that code that repeatedly looks up or
+    compares such names can use small integer ids instead.  Ids are only valid
+    within one run of a program; the names themselves are still used for
+    display and serialization.  All functions are thread-safe. */
+
+typedef int StringID;
+
+/** Id of the empty string, and the id returned for strings that have not been
+  * interned. */
+const StringID INVALID_STRING_ID = -1;
+
+/** Returns the id of \a str, assigning a new id if \a str was not already
+  * interned.  Returns INVALID_STRING_ID for the empty string. */
+FO_COMMON_API StringID InternString(const std::string& str);
+
+/** Returns the id of \a str if it has already been interned, or
+  * INVALID_STRING_ID otherwise.  Unlike InternString(), this never grows the
+  * table of interned strings, so is suitable for lookups of names that may
+  * not refer to any content. */
+FO_COMMON_API StringID InternedStringID(const std::string& str);
+
+/** Returns the string with id \a id, or an empty string if there is none. */
+FO_COMMON_API const std::string& InternedString(StringID id);
+
+#endif // _InternedStrings_h_
@@ -96,6 +96,7 @@ void OptionsDB::Option::SetFromString(const std::string& str) {
         value = validator->Validate(str);
     else
         value = boost::lexical_cast<bool>(str);
+    (*option_changed_sig_ptr)();
 }
 
 std::string OptionsDB::Option::ValueToString() const {
@@ -10,8 +10,10 @@
 #include "Logger.h"
 #include "MultiplayerCommon.h"
 #include "EnumText.h"
+#include "SaveGameSections.h"
 #include "Serialize.h"
 #include "Serialize.ipp"
+#include "RunQueue.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/filesystem.hpp>
@@ -21,7 +23,13 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/graph/graph_concepts.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <fstream>
+#include <map>
+#include <set>
 
 namespace fs = boost::filesystem;
 
@@ -55,7 +63,15 @@ namespace {
             throw std::runtime_error ( UNABLE_TO_OPEN_FILE );
         bool use_binary = GetOptionsDB().Get<bool>("binary-serialization") ^ alternate_serialization;
         try {
-            if (use_binary) {
+            SaveGameSectionReader reader ( ifs );
+            if (reader.Valid()) {
+                // sectioned save files record their own serialization format,
+                // so there is nothing to gain from trying the alternate one
+                alternate_serialization = true;
+                DebugLogger() << "LoadSaveGamePreviewData: Loading preview sections from:" << path.string();
+                ReadSaveGameSection ( reader, "save_preview_data", full.preview );
+                ReadSaveGameSection ( reader, "galaxy_setup_data", full.galaxy );
+            } else if (use_binary) {
                 freeorion_bin_iarchive ia ( ifs );
                 DebugLogger() << "LoadSaveGamePreviewData: Loading preview from:" << path.string();
                 ia >> BOOST_SERIALIZATION_NVP ( full.preview );
@@ -195,13 +211,202 @@ std::string ColumnInPreview ( const FullPreview& full, const std::string& name,
     }
 }
 
+namespace {
+    const std::string PREVIEW_INDEX_FILENAME ( "save-preview-index.bin" );
+
+    /// The preview of a save file, together with the size and modification
+    /// time the file had when the preview was read from it.
+    struct PreviewIndexEntry {
+        PreviewIndexEntry() :
+            file_size ( 0 ),
+            last_write_time ( 0 ),
+            valid ( false )
+        {}
+
+        unsigned long long  file_size;
+        long long           last_write_time;
+        /// False if no preview could be read from the file
+        bool                valid;
+        FullPreview         preview;
+
+        template <class Archive>
+        void serialize ( Archive& ar, const unsigned int version ) {
+            ar  & BOOST_SERIALIZATION_NVP ( file_size )
+                & BOOST_SERIALIZATION_NVP ( last_write_time )
+                & BOOST_SERIALIZATION_NVP ( valid )
+                & BOOST_SERIALIZATION_NVP ( preview );
+        }
+    };
+
+    /// Reads the preview of one save file into its index entry.
+    class PreviewScanWorkItem {
+    public:
+        PreviewScanWorkItem ( const fs::path& path, PreviewIndexEntry& entry ) :
+            m_path ( path ),
+            m_entry ( entry )
+        {}
+
+        void operator()() {
+            try {
+                m_entry.valid = LoadSaveGamePreviewData ( m_path, m_entry.preview );
+            } catch ( const std::exception& e ) {
+                ErrorLogger() << "PreviewScanWorkItem: Failed loading preview from " << m_path << " because: " << e.what();
+                m_entry.valid = false;
+            }
+        }
+
+    private:
+        fs::path            m_path;
+        PreviewIndexEntry&  m_entry;
+    };
+
+    /// Previews of all save files seen so far, keyed by the files' absolute
+    /// paths.  The index is kept in the user directory between runs, so that
+    /// only save files that were added or changed since they were last seen
+    /// have to be opened.
+    class PreviewIndex {
+    public:
+        PreviewIndex() :
+            m_loaded ( false )
+        {}
+
+        /// Appends the valid previews of the files in \a directory with
+        /// extension \a extension to \a previews, scanning the files that are
+        /// not in the index or have changed since they were indexed.
+        void Previews ( const fs::path& directory, const std::string& extension, std::vector<FullPreview>& previews ) {
+            boost::mutex::scoped_lock lock ( m_mutex );
+            if ( !m_loaded ) {
+                Load();
+                m_loaded = true;
+            }
+
+            const fs::path abs_directory = fs::absolute ( directory );
+            std::vector<std::string> keys;
+            std::vector<fs::path> paths_to_scan;
+            std::vector<PreviewIndexEntry*> entries_to_scan;
+
+            fs::directory_iterator end_it;
+            for ( fs::directory_iterator it ( abs_directory ); it != end_it; ++it ) {
+                try {
+                    if ( it->path().filename().extension() != extension || fs::is_directory ( it->path() ) )
+                        continue;
+
+                    std::string key = PathString ( it->path() );
+                    unsigned long long file_size = fs::file_size ( it->path() );
+                    long long last_write_time = fs::last_write_time ( it->path() );
+
+                    std::pair<std::map<std::string, PreviewIndexEntry>::iterator, bool> inserted =
+                        m_entries.insert ( std::make_pair ( key, PreviewIndexEntry() ) );
+                    PreviewIndexEntry& entry = inserted.first->second;
+                    if ( inserted.second || entry.file_size != file_size || entry.last_write_time != last_write_time ) {
+                        entry = PreviewIndexEntry();
+                        entry.file_size = file_size;
+                        entry.last_write_time = last_write_time;
+                        paths_to_scan.push_back ( it->path() );
+                        entries_to_scan.push_back ( &entry );
+                    }
+                    keys.push_back ( key );
+                } catch ( const std::exception& e ) {
+                    ErrorLogger() << "PreviewIndex::Previews: Failed to index " << it->path() << " because: " << e.what();
+                }
+            }
+
+            bool changed = !paths_to_scan.empty();
+
+            if ( !paths_to_scan.empty() ) {
+                DebugLogger() << "PreviewIndex::Previews: Scanning " << paths_to_scan.size() << " new or changed save files in " << abs_directory;
+                unsigned int num_threads = std::max ( 1u, std::min ( boost::thread::hardware_concurrency(),
+                                                                     static_cast<unsigned int> ( paths_to_scan.size() ) ) );
+                RunQueue<PreviewScanWorkItem> run_queue ( num_threads );
+                boost::shared_mutex global_mutex;
+                boost::unique_lock<boost::shared_mutex> global_lock ( global_mutex ); // create after run_queue, destroy before run_queue
+                for ( std::size_t i = 0; i < paths_to_scan.size(); ++i )
+                    run_queue.AddWork ( new PreviewScanWorkItem ( paths_to_scan[i], *entries_to_scan[i] ) );
+                run_queue.Wait ( global_lock );
+            }
+
+            // forget files in this directory that no longer exist
+            std::set<std::string> present_keys ( keys.begin(), keys.end() );
+            for ( std::map<std::string, PreviewIndexEntry>::iterator it = m_entries.begin(); it != m_entries.end(); ) {
+                fs::path indexed_path = FilenameToPath ( it->first );
+                if ( indexed_path.parent_path() == abs_directory &&
+                     indexed_path.extension() == extension &&
+                     !present_keys.count ( it->first ) )
+                {
+                    m_entries.erase ( it++ );
+                    changed = true;
+                } else {
+                    ++it;
+                }
+            }
+
+            for ( std::vector<std::string>::const_iterator it = keys.begin(); it != keys.end(); ++it ) {
+                const PreviewIndexEntry& entry = m_entries[*it];
+                if ( entry.valid )
+                    previews.push_back ( entry.preview );
+            }
+
+            if ( changed )
+                Save();
+        }
+
+    private:
+        static fs::path IndexPath()
+        { return GetUserDir() / PREVIEW_INDEX_FILENAME; }
+
+        void Load() {
+            const fs::path path = IndexPath();
+            if ( !fs::exists ( path ) )
+                return;
+            try {
+                fs::ifstream ifs ( path, std::ios_base::binary );
+                freeorion_bin_iarchive ia ( ifs );
+                ia >> boost::serialization::make_nvp ( "entries", m_entries );
+                DebugLogger() << "PreviewIndex::Load: Loaded " << m_entries.size() << " save file previews from " << path;
+            } catch ( const std::exception& e ) {
+                ErrorLogger() << "PreviewIndex::Load: Discarding unreadable save file preview index " << path << " because: " << e.what();
+                m_entries.clear();
+            }
+        }
+
+        void Save() const {
+            // write to a temporary file and rename it, so that a process
+            // reading the index concurrently never sees a partial file.  the
+            // temporary file's name is unique, so that processes saving
+            // concurrently don't write to the same file.
+            const fs::path path = IndexPath();
+            const fs::path temp_path = path.parent_path() / fs::unique_path ( "%%%%-%%%%.tmp" );
+            try {
+                {
+                    fs::ofstream ofs ( temp_path, std::ios_base::binary );
+                    if ( !ofs )
+                        throw std::runtime_error ( UNABLE_TO_OPEN_FILE );
+                    freeorion_bin_oarchive oa ( ofs );
+                    oa << boost::serialization::make_nvp ( "entries", m_entries );
+                }
+                fs::rename ( temp_path, path );
+            } catch ( const std::exception& e ) {
+                ErrorLogger() << "PreviewIndex::Save: Failed to write save file preview index " << path << " because: " << e.what();
+                boost::system::error_code ec;
+                fs::remove ( temp_path, ec );
+            }
+        }
+
+        std::map<std::string, PreviewIndexEntry>    m_entries;
+        bool                                        m_loaded;
+        boost::mutex                                m_mutex;
+    };
+
+    PreviewIndex& GetPreviewIndex() {
+        static PreviewIndex index;
+        return index;
+    }
+}
+
 /// Loads preview data on all save files in a directory specidifed by path.
 /// @param [in] path The path of the directory
 /// @param [out] previews The preview datas indexed by file names
 void LoadSaveGamePreviews ( const fs::path& orig_path, const std::string& extension, std::vector<FullPreview>& previews ) {
-    FullPreview data;
-    fs::directory_iterator end_it;
-    
     fs::path path = orig_path;
     // Relative path relative to the save directory
     if(path.is_relative()){
@@ -217,18 +422,10 @@ void LoadSaveGamePreviews ( const fs::path& orig_path, const std::string& extens
         return;
     }
 
-    for ( fs::directory_iterator it ( path ); it != end_it; ++it ) {
-        try {
-            std::string filename = PathString ( it->path().filename() );
-            if ( it->path().filename().extension() == extension & !fs::is_directory ( it->path() ) ) {
-                if ( LoadSaveGamePreviewData ( *it, data ) ) {
-                    // Add preview entry to list
-                    previews.push_back ( data );
-                }
-            }
-        } catch ( const std::exception& e ) {
-            ErrorLogger() << "SaveFileListBox::LoadSaveGamePreviews: Failed loading preview from " << it->path() << " because: " << e.what();
-        }
+    try {
+        GetPreviewIndex().Previews ( path, extension, previews );
+    } catch ( const std::exception& e ) {
+        ErrorLogger() << "SaveFileListBox::LoadSaveGamePreviews: Failed loading previews from " << path << " because: " << e.what();
     }
 }
 
@@ -85,7 +85,9 @@ private:
 /// \param thin If true, tries to make the value less wide
 FO_COMMON_API std::string ColumnInPreview(const FullPreview& full, const std::string& name, bool thin = true);
 
-/// Load previews from files
+/// Load previews from files.  Previews are kept in an index in the user
+/// directory, so only files that are new or changed since they were last
+/// indexed are opened; those are read concurrently.
 /// \param path Directory where to look for files
 /// \param extension File name extension to filter by
 /// \param [out] previews The previews will be put here
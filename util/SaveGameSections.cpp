@@ -0,0 +1,371 @@
+#include "SaveGameSections.h"
+
+#include "Logger.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <vector>
+
+
+namespace {
+    const char              SAVE_FILE_MAGIC[8] = { 'F', 'O', 'S', 'A', 'V', 'E', '\r', '\n' };
+    const boost::uint32_t   SAVE_FILE_VERSION = 1;
+    const std::size_t       HEADER_SIZE = sizeof(SAVE_FILE_MAGIC) + 4 + 8;
+
+    const unsigned char     SECTION_BINARY = 0x01;
+    const unsigned char     SECTION_COMPRESSED = 0x02;
+
+    const std::size_t       ZLIB_BUFFER_SIZE = 64 * 1024;
+
+    // integers in the header and table of contents are little-endian, regardless of platform
+    void WriteUInt(std::ostream& os, boost::uint64_t value, std::size_t bytes) {
+        char buf[8];
+        for (std::size_t i = 0; i < bytes; ++i)
+            buf[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        os.write(buf, bytes);
+    }
+
+    boost::uint64_t ReadUInt(std::istream& is, std::size_t bytes) {
+        char buf[8];
+        if (!is.read(buf, bytes))
+            throw std::runtime_error("Unexpected end of save file header");
+        boost::uint64_t retval = 0;
+        for (std::size_t i = 0; i < bytes; ++i)
+            retval |= static_cast<boost::uint64_t>(static_cast<unsigned char>(buf[i])) << (8 * i);
+        return retval;
+    }
+
+    /** Compresses everything written to it, and writes the result to a sink
+      * stream. */
+    class DeflateStreamBuf : public std::streambuf {
+    public:
+        explicit DeflateStreamBuf(std::ostream& sink) :
+            m_sink(sink),
+            m_in(ZLIB_BUFFER_SIZE),
+            m_out(ZLIB_BUFFER_SIZE)
+        {
+            m_stream.zalloc = Z_NULL;
+            m_stream.zfree = Z_NULL;
+            m_stream.opaque = Z_NULL;
+            if (deflateInit(&m_stream, Z_DEFAULT_COMPRESSION) != Z_OK)
+                throw std::runtime_error("Unable to initialize save file compression");
+            setp(&m_in[0], &m_in[0] + m_in.size());
+        }
+
+        ~DeflateStreamBuf()
+        { deflateEnd(&m_stream); }
+
+        /** Compresses any pending input and terminates the zlib stream. */
+        void Finish()
+        { Deflate(Z_FINISH); }
+
+    protected:
+        virtual int_type overflow(int_type c) {
+            Deflate(Z_NO_FLUSH);
+            if (!traits_type::eq_int_type(c, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(c);
+                pbump(1);
+            }
+            return traits_type::not_eof(c);
+        }
+
+        virtual int sync() {
+            Deflate(Z_NO_FLUSH);
+            return 0;
+        }
+
+    private:
+        void Deflate(int flush) {
+            m_stream.next_in = reinterpret_cast<Bytef*>(pbase());
+            m_stream.avail_in = static_cast<uInt>(pptr() - pbase());
+            int result = Z_OK;
+            do {
+                m_stream.next_out = reinterpret_cast<Bytef*>(&m_out[0]);
+                m_stream.avail_out = static_cast<uInt>(m_out.size());
+                result = deflate(&m_stream, flush);
+                if (result == Z_STREAM_ERROR)
+                    throw std::runtime_error("Save file compression failed");
+                m_sink.write(&m_out[0], m_out.size() - m_stream.avail_out);
+            } while (m_stream.avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+            setp(&m_in[0], &m_in[0] + m_in.size());
+        }
+
+        std::ostream&       m_sink;
+        std::vector<char>   m_in;
+        std::vector<char>   m_out;
+        z_stream            m_stream;
+    };
+
+    /** Decompresses at most \a size bytes of a zlib stream read from a source
+      * stream. */
+    class InflateStreamBuf : public std::streambuf {
+    public:
+        InflateStreamBuf(std::istream& source, boost::uint64_t size) :
+            m_source(source),
+            m_remaining(size),
+            m_in(ZLIB_BUFFER_SIZE),
+            m_out(ZLIB_BUFFER_SIZE),
+            m_done(false)
+        {
+            m_stream.zalloc = Z_NULL;
+            m_stream.zfree = Z_NULL;
+            m_stream.opaque = Z_NULL;
+            m_stream.next_in = Z_NULL;
+            m_stream.avail_in = 0;
+            if (inflateInit(&m_stream) != Z_OK)
+                throw std::runtime_error("Unable to initialize save file decompression");
+            setg(&m_out[0], &m_out[0], &m_out[0]);
+        }
+
+        ~InflateStreamBuf()
+        { inflateEnd(&m_stream); }
+
+    protected:
+        virtual int_type underflow() {
+            if (gptr() < egptr())
+                return traits_type::to_int_type(*gptr());
+
+            while (!m_done) {
+                if (m_stream.avail_in == 0) {
+                    if (m_remaining == 0)
+                        break;
+                    std::streamsize to_read = static_cast<std::streamsize>(
+                        std::min<boost::uint64_t>(m_remaining, m_in.size()));
+                    m_source.read(&m_in[0], to_read);
+                    std::streamsize count = m_source.gcount();
+                    if (count <= 0)
+                        break;
+                    m_remaining -= count;
+                    m_stream.next_in = reinterpret_cast<Bytef*>(&m_in[0]);
+                    m_stream.avail_in = static_cast<uInt>(count);
+                }
+
+                m_stream.next_out = reinterpret_cast<Bytef*>(&m_out[0]);
+                m_stream.avail_out = static_cast<uInt>(m_out.size());
+                int result = inflate(&m_stream, Z_NO_FLUSH);
+                if (result == Z_STREAM_END) {
+                    m_done = true;
+                } else if (result != Z_OK && result != Z_BUF_ERROR) {
+                    ErrorLogger() << "InflateStreamBuf: corrupt compressed save file section";
+                    m_done = true;
+                    break;
+                }
+
+                std::size_t produced = m_out.size() - m_stream.avail_out;
+                if (produced) {
+                    setg(&m_out[0], &m_out[0], &m_out[0] + produced);
+                    return traits_type::to_int_type(*gptr());
+                }
+            }
+            return traits_type::eof();
+        }
+
+    private:
+        std::istream&       m_source;
+        boost::uint64_t     m_remaining;
+        std::vector<char>   m_in;
+        std::vector<char>   m_out;
+        z_stream            m_stream;
+        bool                m_done;
+    };
+}
+
+////////////////////////////////////////////////
+// SaveGameSection
+////////////////////////////////////////////////
+SaveGameSection::SaveGameSection() :
+    offset(0),
+    size(0),
+    binary(true),
+    compressed(false)
+{}
+
+////////////////////////////////////////////////
+// SaveGameSectionWriter
+////////////////////////////////////////////////
+class SaveGameSectionWriter::Compressor {
+public:
+    explicit Compressor(std::ostream& sink) :
+        m_buf(sink),
+        m_stream(&m_buf)
+    {}
+
+    std::ostream& Stream()
+    { return m_stream; }
+
+    void Finish() {
+        m_stream.flush();
+        m_buf.Finish();
+    }
+
+private:
+    DeflateStreamBuf    m_buf;
+    std::ostream        m_stream;
+};
+
+SaveGameSectionWriter::SaveGameSectionWriter(std::ostream& os) :
+    m_os(os),
+    m_header_offset(static_cast<boost::uint64_t>(os.tellp())),
+    m_in_section(false)
+{
+    m_os.write(SAVE_FILE_MAGIC, sizeof(SAVE_FILE_MAGIC));
+    WriteUInt(m_os, SAVE_FILE_VERSION, 4);
+    WriteUInt(m_os, 0, 8);  // table of contents offset, filled in by Finish()
+}
+
+SaveGameSectionWriter::~SaveGameSectionWriter()
+{}
+
+std::ostream& SaveGameSectionWriter::BeginSection(const std::string& name, bool binary, bool compressed) {
+    if (m_in_section)
+        throw std::runtime_error("SaveGameSectionWriter::BeginSection called before previous section was ended");
+
+    SaveGameSection section;
+    section.name = name;
+    section.offset = static_cast<boost::uint64_t>(m_os.tellp()) - m_header_offset;
+    section.binary = binary;
+    section.compressed = compressed;
+    m_sections.push_back(section);
+    m_in_section = true;
+
+    if (!compressed)
+        return m_os;
+    m_compressor.reset(new Compressor(m_os));
+    return m_compressor->Stream();
+}
+
+void SaveGameSectionWriter::EndSection() {
+    if (!m_in_section)
+        return;
+    if (m_compressor) {
+        m_compressor->Finish();
+        m_compressor.reset();
+    }
+    SaveGameSection& section = m_sections.back();
+    section.size = static_cast<boost::uint64_t>(m_os.tellp()) - m_header_offset - section.offset;
+    m_in_section = false;
+
+    if (!m_os)
+        throw std::runtime_error("Error writing save file section " + section.name);
+}
+
+void SaveGameSectionWriter::Finish() {
+    EndSection();
+
+    boost::uint64_t toc_offset = static_cast<boost::uint64_t>(m_os.tellp()) - m_header_offset;
+    WriteUInt(m_os, m_sections.size(), 4);
+    for (std::vector<SaveGameSection>::const_iterator it = m_sections.begin(); it != m_sections.end(); ++it) {
+        WriteUInt(m_os, it->name.size(), 4);
+        m_os.write(it->name.data(), it->name.size());
+        WriteUInt(m_os, it->offset, 8);
+        WriteUInt(m_os, it->size, 8);
+        unsigned char flags = (it->binary ? SECTION_BINARY : 0) | (it->compressed ? SECTION_COMPRESSED : 0);
+        WriteUInt(m_os, flags, 1);
+    }
+    std::streampos end = m_os.tellp();
+
+    m_os.seekp(static_cast<std::streamoff>(m_header_offset + sizeof(SAVE_FILE_MAGIC) + 4));
+    WriteUInt(m_os, toc_offset, 8);
+    m_os.seekp(end);
+    m_os.flush();
+
+    if (!m_os)
+        throw std::runtime_error("Error writing save file table of contents");
+}
+
+////////////////////////////////////////////////
+// SaveGameSectionReader
+////////////////////////////////////////////////
+class SaveGameSectionReader::Decompressor {
+public:
+    Decompressor(std::istream& source, boost::uint64_t size) :
+        m_buf(source, size),
+        m_stream(&m_buf)
+    {}
+
+    std::istream& Stream()
+    { return m_stream; }
+
+private:
+    InflateStreamBuf    m_buf;
+    std::istream        m_stream;
+};
+
+SaveGameSectionReader::SaveGameSectionReader(std::istream& is) :
+    m_is(is),
+    m_valid(false)
+{
+    std::streampos start = m_is.tellg();
+
+    char magic[sizeof(SAVE_FILE_MAGIC)];
+    if (!m_is.read(magic, sizeof(magic)) ||
+        !std::equal(magic, magic + sizeof(magic), SAVE_FILE_MAGIC))
+    {
+        m_is.clear();
+        m_is.seekg(start);
+        return;
+    }
+
+    boost::uint64_t version = ReadUInt(m_is, 4);
+    if (version > SAVE_FILE_VERSION)
+        throw std::runtime_error("Save file was written by a newer version of FreeOrion");
+
+    boost::uint64_t toc_offset = ReadUInt(m_is, 8);
+    if (toc_offset < HEADER_SIZE)
+        throw std::runtime_error("Save file has no table of contents; it may be incomplete");
+    m_is.seekg(start + static_cast<std::streamoff>(toc_offset));
+
+    boost::uint64_t num_sections = ReadUInt(m_is, 4);
+    for (boost::uint64_t i = 0; i < num_sections; ++i) {
+        SaveGameSection section;
+        std::size_t name_length = static_cast<std::size_t>(ReadUInt(m_is, 4));
+        std::vector<char> name(name_length);
+        if (name_length && !m_is.read(&name[0], name_length))
+            throw std::runtime_error("Unexpected end of save file table of contents");
+        section.name.assign(name.begin(), name.end());
+        section.offset = static_cast<boost::uint64_t>(start) + ReadUInt(m_is, 8);
+        section.size = ReadUInt(m_is, 8);
+        unsigned char flags = static_cast<unsigned char>(ReadUInt(m_is, 1));
+        section.binary = flags & SECTION_BINARY;
+        section.compressed = flags & SECTION_COMPRESSED;
+        m_sections.push_back(section);
+    }
+
+    m_valid = true;
+}
+
+SaveGameSectionReader::~SaveGameSectionReader()
+{}
+
+bool SaveGameSectionReader::Valid() const
+{ return m_valid; }
+
+const SaveGameSection* SaveGameSectionReader::Section(const std::string& name) const {
+    for (std::vector<SaveGameSection>::const_iterator it = m_sections.begin(); it != m_sections.end(); ++it)
+        if (it->name == name)
+            return &*it;
+    return 0;
+}
+
+const std::vector<SaveGameSection>& SaveGameSectionReader::Sections() const
+{ return m_sections; }
+
+std::istream& SaveGameSectionReader::OpenSection(const std::string& name) {
+    const SaveGameSection* section = Section(name);
+    if (!section)
+        throw std::runtime_error("Save file has no section " + name);
+
+    m_decompressor.reset();
+    m_is.clear();
+    m_is.seekg(static_cast<std::streamoff>(section->offset));
+
+    if (!section->compressed)
+        return m_is;
+    m_decompressor.reset(new Decompressor(m_is, section->size));
+    return m_decompressor->Stream();
+}
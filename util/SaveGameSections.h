@@ -0,0 +1,140 @@
+// -*- C++ -*-
+#ifndef _SaveGameSections_h_
+#define _SaveGameSections_h_
+
+#include "Export.h"
+#include "Serialize.h"
+
+#include <boost/cstdint.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/serialization/nvp.hpp>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/** Save files are containers of independently serialized, named sections.
+  * A file starts with a fixed header that holds the offset of a table of
+  * contents, which is written after the last section.  Each table of contents
+  * entry records where its section is in the file and whether it is a binary
+  * or xml archive and whether it is zlib-compressed, so that readers can seek
+  * directly to the sections they need instead of deserializing everything
+  * before them.  Files written before sections were introduced have no
+  * header; SaveGameSectionReader::Valid() is false for those. */
+struct FO_COMMON_API SaveGameSection {
+    SaveGameSection();
+
+    std::string     name;
+    boost::uint64_t offset;     ///< position of the section's first byte in the file
+    boost::uint64_t size;       ///< number of bytes the section occupies in the file
+    bool            binary;     ///< true for binary archives, false for xml archives
+    bool            compressed; ///< true if the section's bytes are a zlib stream
+};
+
+/** Writes a sectioned save file to a seekable output stream.  Sections are
+  * written one at a time, between BeginSection() and EndSection(), directly
+  * to the underlying stream or through a compressor, so that no section
+  * needs to be held in memory in its entirety. */
+class FO_COMMON_API SaveGameSectionWriter {
+public:
+    /** Writes the file header to \a os, which must remain valid until this
+      * writer is destroyed. */
+    explicit SaveGameSectionWriter(std::ostream& os);
+    ~SaveGameSectionWriter();
+
+    /** Starts a new section named \a name, and returns the stream to which
+      * its archive should be written.  The returned stream is valid until
+      * EndSection() is called. */
+    std::ostream&   BeginSection(const std::string& name, bool binary, bool compressed);
+
+    /** Finishes the current section.  Any archive writing to the stream
+      * returned by BeginSection() must have been destroyed already. */
+    void            EndSection();
+
+    /** Writes the table of contents and updates the file header to refer to
+      * it.  No further sections may be written afterwards. */
+    void            Finish();
+
+private:
+    class Compressor;
+
+    SaveGameSectionWriter(const SaveGameSectionWriter&);            // disabled
+    SaveGameSectionWriter& operator=(const SaveGameSectionWriter&); // disabled
+
+    std::ostream&                   m_os;
+    boost::uint64_t                 m_header_offset;
+    std::vector<SaveGameSection>    m_sections;
+    boost::scoped_ptr<Compressor>   m_compressor;
+    bool                            m_in_section;
+};
+
+/** Reads sections from a save file written by SaveGameSectionWriter. */
+class FO_COMMON_API SaveGameSectionReader {
+public:
+    /** Reads the header and table of contents from \a is, which must remain
+      * valid until this reader is destroyed.  If \a is does not contain a
+      * sectioned save file, the reader is not Valid() and the read position
+      * of \a is is restored. */
+    explicit SaveGameSectionReader(std::istream& is);
+    ~SaveGameSectionReader();
+
+    /** Returns true if the stream contains a sectioned save file. */
+    bool                            Valid() const;
+
+    /** Returns the table of contents entry for section \a name, or 0 if
+      * there is no such section. */
+    const SaveGameSection*          Section(const std::string& name) const;
+
+    const std::vector<SaveGameSection>& Sections() const;
+
+    /** Positions the reader at the start of section \a name, and returns
+      * the stream from which its archive can be read.  The returned stream is
+      * valid until the next call to OpenSection().  Throws
+      * std::runtime_error if there is no such section. */
+    std::istream&                   OpenSection(const std::string& name);
+
+private:
+    class Decompressor;
+
+    SaveGameSectionReader(const SaveGameSectionReader&);            // disabled
+    SaveGameSectionReader& operator=(const SaveGameSectionReader&); // disabled
+
+    std::istream&                   m_is;
+    std::vector<SaveGameSection>    m_sections;
+    boost::scoped_ptr<Decompressor> m_decompressor;
+    bool                            m_valid;
+};
+
+/** Writes \a data to \a writer as a section named \a name.  \a name is also
+  * used as the name of the archive's top-level element, so it must be a valid
+  * xml element name. */
+template <class T>
+void WriteSaveGameSection(SaveGameSectionWriter& writer, const std::string& name,
+                          const T& data, bool binary, bool compressed)
+{
+    std::ostream& os = writer.BeginSection(name, binary, compressed);
+    if (binary) {
+        freeorion_bin_oarchive oa(os);
+        oa << boost::serialization::make_nvp(name.c_str(), data);
+    } else {
+        freeorion_xml_oarchive oa(os);
+        oa << boost::serialization::make_nvp(name.c_str(), data);
+    }
+    writer.EndSection();
+}
+
+/** Reads section \a name from \a reader into \a data.  Throws if there is no
+  * such section or it cannot be deserialized. */
+template <class T>
+void ReadSaveGameSection(SaveGameSectionReader& reader, const std::string& name, T& data) {
+    std::istream& is = reader.OpenSection(name);
+    if (reader.Section(name)->binary) {
+        freeorion_bin_iarchive ia(is);
+        ia >> boost::serialization::make_nvp(name.c_str(), data);
+    } else {
+        freeorion_xml_iarchive ia(is);
+        ia >> boost::serialization::make_nvp(name.c_str(), data);
+    }
+}
+
+#endif // _SaveGameSections_h_
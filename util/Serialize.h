@@ -22,6 +22,28 @@ typedef boost::archive::binary_oarchive freeorion_bin_oarchive;
 typedef boost::archive::xml_iarchive freeorion_xml_iarchive;
 typedef boost::archive::xml_oarchive freeorion_xml_oarchive;
 
+/** Returns the id of the empire for which objects are currently being
+  * serialized on this thread, or ALL_EMPIRES if no ScopedEncodingEmpire is
+  * active.  Serialization code that implements empire-dependent visibility
+  * consults this to decide what to write. */
+FO_COMMON_API int GetEncodingEmpire();
+
+/** Sets the encoding empire of the current thread for the lifetime of this
+  * object, restoring the previous value on destruction.  Each thread has its
+  * own encoding empire, so that gamestates for several empires can be
+  * serialized concurrently. */
+class FO_COMMON_API ScopedEncodingEmpire {
+public:
+    explicit ScopedEncodingEmpire(int empire_id);
+    ~ScopedEncodingEmpire();
+
+private:
+    ScopedEncodingEmpire(const ScopedEncodingEmpire&);              // disabled
+    ScopedEncodingEmpire& operator=(const ScopedEncodingEmpire&);   // disabled
+
+    int m_previous_empire_id;
+};
+
 // NB: Do not try to serialize types that contain longs, since longs are different sizes on 32- and 64-bit
 // architectures.  Replace your longs with long longs for portability.  See longer note in Serialize.cpp for more info.
 
@@ -112,8 +112,8 @@ void Empire::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_resource_supply_groups);
 
     if (GetUniverse().AllObjectsVisible() ||
-        GetUniverse().EncodingEmpire() == ALL_EMPIRES ||
-        m_id == GetUniverse().EncodingEmpire())
+        GetEncodingEmpire() == ALL_EMPIRES ||
+        m_id == GetEncodingEmpire())
     {
         ar  & BOOST_SERIALIZATION_NVP(m_ship_designs)
             & BOOST_SERIALIZATION_NVP(m_sitrep_entries)
@@ -163,7 +163,7 @@ void EmpireManager::serialize(Archive& ar, const unsigned int version)
 
     std::map<std::pair<int, int>, DiplomaticMessage> messages;
     if (Archive::is_saving::value)
-        GetDiplomaticMessagesToSerialize(messages, GetUniverse().EncodingEmpire());
+        GetDiplomaticMessagesToSerialize(messages, GetEncodingEmpire());
 
     ar  & BOOST_SERIALIZATION_NVP(m_empire_map)
         & BOOST_SERIALIZATION_NVP(m_eliminated_empires)
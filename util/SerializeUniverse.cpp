@@ -13,6 +13,8 @@
 #include "../universe/Field.h"
 #include "../universe/Universe.h"
 
+#include <boost/thread/tss.hpp>
+
 BOOST_CLASS_EXPORT(System)
 BOOST_CLASS_EXPORT(Field)
 BOOST_CLASS_EXPORT(Planet)
@@ -22,6 +24,207 @@ BOOST_CLASS_EXPORT(Ship)
 BOOST_CLASS_VERSION(Ship, 1)
 //BOOST_CLASS_EXPORT(ShipDesign)
 //BOOST_CLASS_VERSION(ShipDesign, 1)
+BOOST_CLASS_VERSION(UniverseObject, 1)
+BOOST_CLASS_VERSION(Universe, 1)
+
+namespace {
+    // heap-allocated per thread on first use; null means ALL_EMPIRES
+    boost::thread_specific_ptr<int>& EncodingEmpireTSS() {
+        static boost::thread_specific_ptr<int> s_encoding_empire;
+        return s_encoding_empire;
+    }
+
+    void SetEncodingEmpire(int empire_id) {
+        boost::thread_specific_ptr<int>& tss = EncodingEmpireTSS();
+        if (int* current = tss.get())
+            *current = empire_id;
+        else
+            tss.reset(new int(empire_id));
+    }
+}
+
+int GetEncodingEmpire() {
+    if (const int* current = EncodingEmpireTSS().get())
+        return *current;
+    return ALL_EMPIRES;
+}
+
+ScopedEncodingEmpire::ScopedEncodingEmpire(int empire_id) :
+    m_previous_empire_id(GetEncodingEmpire())
+{ SetEncodingEmpire(empire_id); }
+
+ScopedEncodingEmpire::~ScopedEncodingEmpire()
+{ SetEncodingEmpire(m_previous_empire_id); }
+
+namespace {
+    // From class version 1, Universe and UniverseObject write their largest
+    // nested containers as a few flat arrays of primitives, which binary
+    // archives read and write in bulk, rather than element by element with
+    // per-element archive bookkeeping.  The counts arrays give the number of
+    // entries in each inner container, in the same order as the outer keys.
+
+    void ThrowMalformedFlatContainer()
+    { throw boost::archive::archive_exception(boost::archive::archive_exception::input_stream_error); }
+
+    /** Per-empire object visibilities. */
+    template <class Archive>
+    void SerializeFlat(Archive& ar, std::map<int, std::map<int, Visibility> >& empire_object_vis) {
+        typedef std::map<int, Visibility> ObjectVisMap;
+        std::vector<int> empire_ids, object_counts, object_ids, visibilities;
+
+        if (Archive::is_saving::value) {
+            for (std::map<int, ObjectVisMap>::const_iterator empire_it = empire_object_vis.begin();
+                 empire_it != empire_object_vis.end(); ++empire_it)
+            {
+                empire_ids.push_back(empire_it->first);
+                object_counts.push_back(static_cast<int>(empire_it->second.size()));
+                for (ObjectVisMap::const_iterator obj_it = empire_it->second.begin();
+                     obj_it != empire_it->second.end(); ++obj_it)
+                {
+                    object_ids.push_back(obj_it->first);
+                    visibilities.push_back(obj_it->second);
+                }
+            }
+        }
+
+        ar  & BOOST_SERIALIZATION_NVP(empire_ids)
+            & BOOST_SERIALIZATION_NVP(object_counts)
+            & BOOST_SERIALIZATION_NVP(object_ids)
+            & BOOST_SERIALIZATION_NVP(visibilities);
+
+        if (Archive::is_loading::value) {
+            empire_object_vis.clear();
+            if (empire_ids.size() != object_counts.size() || object_ids.size() != visibilities.size())
+                ThrowMalformedFlatContainer();
+            std::size_t pos = 0;
+            for (std::size_t i = 0; i < empire_ids.size(); ++i) {
+                ObjectVisMap& object_vis = empire_object_vis[empire_ids[i]];
+                for (int n = 0; n < object_counts[i]; ++n, ++pos) {
+                    if (pos >= object_ids.size())
+                        ThrowMalformedFlatContainer();
+                    // keys were written in order, so hinted insertion at the end is constant time
+                    object_vis.insert(object_vis.end(), std::make_pair(object_ids[pos], Visibility(visibilities[pos])));
+                }
+            }
+        }
+    }
+
+    /** Per-empire, per-object latest turns at which each visibility was had. */
+    template <class Archive>
+    void SerializeFlat(Archive& ar, std::map<int, std::map<int, std::map<Visibility, int> > >& empire_object_vis_turns) {
+        typedef std::map<Visibility, int> VisTurnMap;
+        typedef std::map<int, VisTurnMap> ObjectVisTurnMap;
+        std::vector<int> empire_ids, object_counts, object_ids, turn_counts, visibilities, turns;
+
+        if (Archive::is_saving::value) {
+            for (std::map<int, ObjectVisTurnMap>::const_iterator empire_it = empire_object_vis_turns.begin();
+                 empire_it != empire_object_vis_turns.end(); ++empire_it)
+            {
+                empire_ids.push_back(empire_it->first);
+                object_counts.push_back(static_cast<int>(empire_it->second.size()));
+                for (ObjectVisTurnMap::const_iterator obj_it = empire_it->second.begin();
+                     obj_it != empire_it->second.end(); ++obj_it)
+                {
+                    object_ids.push_back(obj_it->first);
+                    turn_counts.push_back(static_cast<int>(obj_it->second.size()));
+                    for (VisTurnMap::const_iterator vis_it = obj_it->second.begin();
+                         vis_it != obj_it->second.end(); ++vis_it)
+                    {
+                        visibilities.push_back(vis_it->first);
+                        turns.push_back(vis_it->second);
+                    }
+                }
+            }
+        }
+
+        ar  & BOOST_SERIALIZATION_NVP(empire_ids)
+            & BOOST_SERIALIZATION_NVP(object_counts)
+            & BOOST_SERIALIZATION_NVP(object_ids)
+            & BOOST_SERIALIZATION_NVP(turn_counts)
+            & BOOST_SERIALIZATION_NVP(visibilities)
+            & BOOST_SERIALIZATION_NVP(turns);
+
+        if (Archive::is_loading::value) {
+            empire_object_vis_turns.clear();
+            if (empire_ids.size() != object_counts.size() || object_ids.size() != turn_counts.size() ||
+                visibilities.size() != turns.size())
+            { ThrowMalformedFlatContainer(); }
+            std::size_t obj_pos = 0, turn_pos = 0;
+            for (std::size_t i = 0; i < empire_ids.size(); ++i) {
+                ObjectVisTurnMap& object_vis_turns = empire_object_vis_turns[empire_ids[i]];
+                for (int n = 0; n < object_counts[i]; ++n, ++obj_pos) {
+                    if (obj_pos >= object_ids.size())
+                        ThrowMalformedFlatContainer();
+                    VisTurnMap& vis_turns = object_vis_turns.insert(object_vis_turns.end(),
+                                                                    std::make_pair(object_ids[obj_pos], VisTurnMap()))->second;
+                    for (int m = 0; m < turn_counts[obj_pos]; ++m, ++turn_pos) {
+                        if (turn_pos >= turns.size())
+                            ThrowMalformedFlatContainer();
+                        vis_turns.insert(vis_turns.end(), std::make_pair(Visibility(visibilities[turn_pos]), turns[turn_pos]));
+                    }
+                }
+            }
+        }
+    }
+
+    /** Sets of ids keyed by id, such as the empires that know of each destroyed object. */
+    template <class Archive>
+    void SerializeFlat(Archive& ar, std::map<int, std::set<int> >& id_sets) {
+        std::vector<int> keys, counts, ids;
+
+        if (Archive::is_saving::value) {
+            for (std::map<int, std::set<int> >::const_iterator it = id_sets.begin(); it != id_sets.end(); ++it) {
+                keys.push_back(it->first);
+                counts.push_back(static_cast<int>(it->second.size()));
+                ids.insert(ids.end(), it->second.begin(), it->second.end());
+            }
+        }
+
+        ar  & BOOST_SERIALIZATION_NVP(keys)
+            & BOOST_SERIALIZATION_NVP(counts)
+            & BOOST_SERIALIZATION_NVP(ids);
+
+        if (Archive::is_loading::value) {
+            id_sets.clear();
+            if (keys.size() != counts.size())
+                ThrowMalformedFlatContainer();
+            std::size_t pos = 0;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (counts[i] < 0 || pos + counts[i] > ids.size())
+                    ThrowMalformedFlatContainer();
+                id_sets.insert(id_sets.end(), std::make_pair(keys[i], std::set<int>(ids.begin() + pos, ids.begin() + pos + counts[i])));
+                pos += counts[i];
+            }
+        }
+    }
+
+    /** An object's meters. */
+    template <class Archive>
+    void SerializeFlat(Archive& ar, std::map<MeterType, Meter>& meters) {
+        std::vector<int> meter_types;
+        std::vector<float> current_values, initial_values;
+
+        if (Archive::is_saving::value) {
+            for (std::map<MeterType, Meter>::const_iterator it = meters.begin(); it != meters.end(); ++it) {
+                meter_types.push_back(it->first);
+                current_values.push_back(it->second.Current());
+                initial_values.push_back(it->second.Initial());
+            }
+        }
+
+        ar  & BOOST_SERIALIZATION_NVP(meter_types)
+            & BOOST_SERIALIZATION_NVP(current_values)
+            & BOOST_SERIALIZATION_NVP(initial_values);
+
+        if (Archive::is_loading::value) {
+            meters.clear();
+            if (meter_types.size() != current_values.size() || meter_types.size() != initial_values.size())
+                ThrowMalformedFlatContainer();
+            for (std::size_t i = 0; i < meter_types.size(); ++i)
+                meters.insert(meters.end(), std::make_pair(MeterType(meter_types[i]), Meter(current_values[i], initial_values[i])));
+        }
+    }
+}
 
 template <class Archive>
 void ObjectMap::serialize(Archive& ar, const unsigned int version)
@@ -49,15 +252,16 @@ void Universe::serialize(Archive& ar, const unsigned int version)
     ar.template register_type<System>();
 
     if (Archive::is_saving::value) {
+        int encoding_empire = GetEncodingEmpire();
         DebugLogger() << "Universe::serialize : Getting gamestate data";
-        GetObjectsToSerialize(              objects,                            m_encoding_empire);
-        GetDestroyedObjectsToSerialize(     destroyed_object_ids,               m_encoding_empire);
-        GetEmpireKnownObjectsToSerialize(   empire_latest_known_objects,        m_encoding_empire);
-        GetEmpireObjectVisibilityMap(       empire_object_visibility,           m_encoding_empire);
-        GetEmpireObjectVisibilityTurnMap(   empire_object_visibility_turns,     m_encoding_empire);
-        GetEmpireKnownDestroyedObjects(     empire_known_destroyed_object_ids,  m_encoding_empire);
-        GetEmpireStaleKnowledgeObjects(     empire_stale_knowledge_object_ids,  m_encoding_empire);
-        GetShipDesignsToSerialize(          ship_designs,                       m_encoding_empire);
+        GetObjectsToSerialize(              objects,                            encoding_empire);
+        GetDestroyedObjectsToSerialize(     destroyed_object_ids,               encoding_empire);
+        GetEmpireKnownObjectsToSerialize(   empire_latest_known_objects,        encoding_empire);
+        GetEmpireObjectVisibilityMap(       empire_object_visibility,           encoding_empire);
+        GetEmpireObjectVisibilityTurnMap(   empire_object_visibility_turns,     encoding_empire);
+        GetEmpireKnownDestroyedObjects(     empire_known_destroyed_object_ids,  encoding_empire);
+        GetEmpireStaleKnowledgeObjects(     empire_stale_knowledge_object_ids,  encoding_empire);
+        GetShipDesignsToSerialize(          ship_designs,                       encoding_empire);
     }
 
     if (Archive::is_loading::value) {
@@ -70,10 +274,17 @@ void Universe::serialize(Archive& ar, const unsigned int version)
     ar  & BOOST_SERIALIZATION_NVP(ship_designs);
     ar  & BOOST_SERIALIZATION_NVP(m_empire_known_ship_design_ids);
     DebugLogger() << "Universe::serialize : (de)serializing empire object visibility";
-    ar  & BOOST_SERIALIZATION_NVP(empire_object_visibility);
-    ar  & BOOST_SERIALIZATION_NVP(empire_object_visibility_turns);
-    ar  & BOOST_SERIALIZATION_NVP(empire_known_destroyed_object_ids);
-    ar  & BOOST_SERIALIZATION_NVP(empire_stale_knowledge_object_ids);
+    if (version >= 1) {
+        SerializeFlat(ar, empire_object_visibility);
+        SerializeFlat(ar, empire_object_visibility_turns);
+        SerializeFlat(ar, empire_known_destroyed_object_ids);
+        SerializeFlat(ar, empire_stale_knowledge_object_ids);
+    } else {
+        ar  & BOOST_SERIALIZATION_NVP(empire_object_visibility);
+        ar  & BOOST_SERIALIZATION_NVP(empire_object_visibility_turns);
+        ar  & BOOST_SERIALIZATION_NVP(empire_known_destroyed_object_ids);
+        ar  & BOOST_SERIALIZATION_NVP(empire_stale_knowledge_object_ids);
+    }
     DebugLogger() << "Universe::serialize : (de)serializing actual objects";
     ar  & BOOST_SERIALIZATION_NVP(objects)
         & BOOST_SERIALIZATION_NVP(destroyed_object_ids);
@@ -97,7 +308,7 @@ void Universe::serialize(Archive& ar, const unsigned int version)
 
     if (Archive::is_loading::value) {
         DebugLogger() << "Universe::serialize : Swapping old/new data, with Encoding Empire "
-                               << EncodingEmpire();
+                               << GetEncodingEmpire();
         m_objects.swap(objects);
         m_destroyed_object_ids.swap(destroyed_object_ids);
         m_empire_latest_known_objects.swap(empire_latest_known_objects);
@@ -128,9 +339,12 @@ void UniverseObject::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_y)
         & BOOST_SERIALIZATION_NVP(m_owner_empire_id)
         & BOOST_SERIALIZATION_NVP(m_system_id)
-        & BOOST_SERIALIZATION_NVP(m_specials)
-        & BOOST_SERIALIZATION_NVP(m_meters)
-        & BOOST_SERIALIZATION_NVP(m_created_on_turn);
+        & BOOST_SERIALIZATION_NVP(m_specials);
+    if (version >= 1)
+        SerializeFlat(ar, m_meters);
+    else
+        ar  & BOOST_SERIALIZATION_NVP(m_meters);
+    ar  & BOOST_SERIALIZATION_NVP(m_created_on_turn);
 }
 
 template <class Archive>
@@ -219,6 +433,8 @@ void Ship::serialize(Archive& ar, const unsigned int version)
     if (version >= 1) {
         ar  & BOOST_SERIALIZATION_NVP(m_last_turn_active_in_combat);
     }
+    if (Archive::is_loading::value)
+        m_species_name_id = InternString(m_species_name);
 }
 
 template <class Archive>
@@ -266,11 +482,12 @@ void SpeciesManager::serialize(Archive& ar, const unsigned int version)
     std::map<std::string, std::map<std::string, int> >      species_ships_destroyed;
 
     if (Archive::is_saving::value) {
-        species_homeworlds =        GetSpeciesHomeworldsMap(GetUniverse().EncodingEmpire());
-        empire_opinions =           GetSpeciesEmpireOpinionsMap(GetUniverse().EncodingEmpire());
-        other_species_opinions =    GetSpeciesSpeciesOpinionsMap(GetUniverse().EncodingEmpire());
-        species_object_populations =SpeciesObjectPopulations(GetUniverse().EncodingEmpire());
-        species_ships_destroyed =   SpeciesShipsDestroyed(GetUniverse().EncodingEmpire());
+        int encoding_empire = GetEncodingEmpire();
+        species_homeworlds =        GetSpeciesHomeworldsMap(encoding_empire);
+        empire_opinions =           GetSpeciesEmpireOpinionsMap(encoding_empire);
+        other_species_opinions =    GetSpeciesSpeciesOpinionsMap(encoding_empire);
+        species_object_populations =SpeciesObjectPopulations(encoding_empire);
+        species_ships_destroyed =   SpeciesShipsDestroyed(encoding_empire);
     }
 
     ar  & BOOST_SERIALIZATION_NVP(species_homeworlds)
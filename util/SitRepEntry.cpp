@@ -29,33 +29,23 @@ SitRepEntry::SitRepEntry(const std::string& template_string, int turn, const std
 {}
 
 int SitRepEntry::GetDataIDNumber(const std::string& tag) const {
-    if (!m_variables.ContainsChild(tag))
+    const Variable* variable = FindVariable(tag);
+    if (!variable || !variable->is_id)
         return -1;
-    const XMLElement& token_elem = m_variables.Child(tag);
-    try {
-        const std::string& text = token_elem.Attribute("value");
-        return boost::lexical_cast<int>(text);
-    } catch (...) {
-        return -1;
-    }
-    return -1;
+    return variable->id;
 }
 
-const std::string& SitRepEntry::GetDataString(const std::string& tag) const {
-    static const std::string EMPTY_STRING;
-    if (!m_variables.ContainsChild(tag))
-        return EMPTY_STRING;
-    const XMLElement& token_elem = m_variables.Child(tag);
-    return token_elem.Attribute("value");
-    return EMPTY_STRING;
+std::string SitRepEntry::GetDataString(const std::string& tag) const {
+    const Variable* variable = FindVariable(tag);
+    if (!variable)
+        return "";
+    return variable->ValueString();
 }
 
 std::string SitRepEntry::Dump() const {
     std::string retval = "SitRep template_string = \"" + m_template_string + "\"";
-    if (m_variables.NumChildren() > 0) {
-        for (XMLElement::const_child_iterator it = m_variables.child_begin(); it != m_variables.child_end(); ++it)
-            retval += " " + it->Tag() + " = " + it->Attribute("value");
-    }
+    for (std::vector<Variable>::const_iterator it = m_variables.begin(); it != m_variables.end(); ++it)
+        retval += " " + it->tag + " = " + it->ValueString();
     retval += " turn = " + boost::lexical_cast<std::string>(m_turn);
     retval += " icon = " + m_icon;
     return retval;
@@ -69,24 +59,24 @@ SitRepEntry CreateTechResearchedSitRep(const std::string& tech_name) {
 
 SitRepEntry CreateShipBuiltSitRep(int ship_id, int system_id, int shipdesign_id) {
     SitRepEntry sitrep(UserStringNop("SITREP_SHIP_BUILT"), "icons/sitrep/ship_produced.png");
-    sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(system_id));
-    sitrep.AddVariable(VarText::SHIP_ID_TAG,       boost::lexical_cast<std::string>(ship_id));
-    sitrep.AddVariable(VarText::DESIGN_ID_TAG,     boost::lexical_cast<std::string>(shipdesign_id));
+    sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     system_id);
+    sitrep.AddVariable(VarText::SHIP_ID_TAG,       ship_id);
+    sitrep.AddVariable(VarText::DESIGN_ID_TAG,     shipdesign_id);
     return sitrep;
 }
 
 SitRepEntry CreateShipBlockBuiltSitRep(int system_id, int shipdesign_id, int number) {
     SitRepEntry sitrep(UserStringNop("SITREP_SHIP_BATCH_BUILT"), "icons/sitrep/ship_produced.png");
-    sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(system_id));
-    sitrep.AddVariable(VarText::DESIGN_ID_TAG,     boost::lexical_cast<std::string>(shipdesign_id));
-    sitrep.AddVariable(VarText::RAW_TEXT_TAG,      boost::lexical_cast<std::string>(number));
+    sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     system_id);
+    sitrep.AddVariable(VarText::DESIGN_ID_TAG,     shipdesign_id);
+    sitrep.AddVariable(VarText::RAW_TEXT_TAG,      number);
     return sitrep;
 }
 
 SitRepEntry CreateBuildingBuiltSitRep(int building_id, int planet_id) {
     SitRepEntry sitrep(UserStringNop("SITREP_BUILDING_BUILT"), "icons/sitrep/building_produced.png");
-    sitrep.AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(planet_id));
-    sitrep.AddVariable(VarText::BUILDING_ID_TAG,   boost::lexical_cast<std::string>(building_id));
+    sitrep.AddVariable(VarText::PLANET_ID_TAG,     planet_id);
+    sitrep.AddVariable(VarText::BUILDING_ID_TAG,   building_id);
     return sitrep;
 }
 
@@ -117,37 +107,37 @@ SitRepEntry CreateShipPartUnlockedSitRep(const std::string& ship_part_name) {
 SitRepEntry CreateCombatSitRep(int system_id, int log_id, int enemy_id) {
     SitRepEntry sitrep(enemy_id == ALL_EMPIRES ? UserStringNop("SITREP_COMBAT_SYSTEM") : UserStringNop("SITREP_COMBAT_SYSTEM_ENEMY"),
                        "icons/sitrep/combat.png");
-    sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  boost::lexical_cast<std::string>(system_id));
-    sitrep.AddVariable(VarText::COMBAT_ID_TAG,  boost::lexical_cast<std::string>(log_id));
-    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,  boost::lexical_cast<std::string>(enemy_id));
+    sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  system_id);
+    sitrep.AddVariable(VarText::COMBAT_ID_TAG,  log_id);
+    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,  enemy_id);
     return sitrep;
 }
 
 SitRepEntry CreateGroundCombatSitRep(int planet_id, int enemy_id) {
     SitRepEntry sitrep(enemy_id == ALL_EMPIRES ? UserStringNop("SITREP_GROUND_BATTLE") : UserStringNop("SITREP_GROUND_BATTLE_ENEMY"),
                        "icons/sitrep/ground_combat.png");
-    sitrep.AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(planet_id));
-    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(enemy_id));
+    sitrep.AddVariable(VarText::PLANET_ID_TAG,     planet_id);
+    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     enemy_id);
     return sitrep;
 }
 
 SitRepEntry CreatePlanetCapturedSitRep(int planet_id, int empire_id) {
     SitRepEntry sitrep(UserStringNop("SITREP_PLANET_CAPTURED"), "icons/sitrep/planet_captured.png");
-    sitrep.AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(planet_id));
-    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(empire_id));
+    sitrep.AddVariable(VarText::PLANET_ID_TAG,     planet_id);
+    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     empire_id);
     return sitrep;
 }
 
 namespace {
     SitRepEntry GenericCombatDamagedObjectSitrep(int combat_system_id) {
         SitRepEntry sitrep(UserStringNop("SITREP_OBJECT_DAMAGED_AT_SYSTEM"), "icons/sitrep/combat_damage.png");
-        sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(combat_system_id));
+        sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     combat_system_id);
         return sitrep;
     }
 
     SitRepEntry GenericCombatDestroyedObjectSitrep(int combat_system_id) {
         SitRepEntry sitrep(UserStringNop("SITREP_OBJECT_DESTROYED_AT_SYSTEM"), "icons/sitrep/combat_destroyed.png");
-        sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(combat_system_id));
+        sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     combat_system_id);
         return sitrep;
     }
 }
@@ -164,22 +154,22 @@ SitRepEntry CreateCombatDamagedObjectSitRep(int object_id, int combat_system_id,
             sitrep = SitRepEntry(UserStringNop("SITREP_UNOWNED_SHIP_DAMAGED_AT_SYSTEM"), "icons/sitrep/combat_damage.png");
         else
             sitrep = SitRepEntry(UserStringNop("SITREP_SHIP_DAMAGED_AT_SYSTEM"), "icons/sitrep/combat_damage.png");
-        sitrep.AddVariable(VarText::SHIP_ID_TAG,       boost::lexical_cast<std::string>(object_id));
-        sitrep.AddVariable(VarText::DESIGN_ID_TAG,     boost::lexical_cast<std::string>(ship->DesignID()));
+        sitrep.AddVariable(VarText::SHIP_ID_TAG,       object_id);
+        sitrep.AddVariable(VarText::DESIGN_ID_TAG,     ship->DesignID());
 
     } else if (TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(obj)) {
         if (planet->Unowned())
             sitrep = SitRepEntry(UserStringNop("SITREP_UNOWNED_PLANET_BOMBARDED_AT_SYSTEM"), "icons/sitrep/colony_bombarded.png");
         else
             sitrep = SitRepEntry(UserStringNop("SITREP_PLANET_BOMBARDED_AT_SYSTEM"), "icons/sitrep/colony_bombarded_own.png");
-        sitrep.AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(object_id));
+        sitrep.AddVariable(VarText::PLANET_ID_TAG,     object_id);
 
     } else {
         sitrep = GenericCombatDestroyedObjectSitrep(combat_system_id);
     }
 
-    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(obj->Owner()));
-    sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(combat_system_id));
+    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     obj->Owner());
+    sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     combat_system_id);
 
     return sitrep;
 }
@@ -200,49 +190,49 @@ SitRepEntry CreateCombatDestroyedObjectSitRep(int object_id, int combat_system_i
             sitrep = SitRepEntry(UserStringNop("SITREP_OWN_SHIP_DESTROYED_AT_SYSTEM"), "icons/sitrep/combat_destroyed.png");
         else
             sitrep = SitRepEntry(UserStringNop("SITREP_SHIP_DESTROYED_AT_SYSTEM"), "icons/sitrep/combat_destroyed.png");
-        sitrep.AddVariable(VarText::SHIP_ID_TAG,       boost::lexical_cast<std::string>(object_id));
-        sitrep.AddVariable(VarText::DESIGN_ID_TAG,     boost::lexical_cast<std::string>(ship->DesignID()));
+        sitrep.AddVariable(VarText::SHIP_ID_TAG,       object_id);
+        sitrep.AddVariable(VarText::DESIGN_ID_TAG,     ship->DesignID());
 
     } else if (TemporaryPtr<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(obj)) {
         if (fleet->Unowned())
             sitrep = SitRepEntry(UserStringNop("SITREP_UNOWNED_FLEET_DESTROYED_AT_SYSTEM"), "icons/sitrep/combat_destroyed.png");
         else
             sitrep = SitRepEntry(UserStringNop("SITREP_FLEET_DESTROYED_AT_SYSTEM"), "icons/sitrep/combat_destroyed.png");
-        sitrep.AddVariable(VarText::FLEET_ID_TAG,      boost::lexical_cast<std::string>(object_id));
+        sitrep.AddVariable(VarText::FLEET_ID_TAG,      object_id);
 
     } else if (TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(obj)) {
         if (planet->Unowned())
             sitrep = SitRepEntry(UserStringNop("SITREP_UNOWNED_PLANET_DESTROYED_AT_SYSTEM"), "icons/sitrep/combat_destroyed.png");
         else
             sitrep = SitRepEntry(UserStringNop("SITREP_PLANET_DESTROYED_AT_SYSTEM"), "icons/sitrep/combat_destroyed.png");
-        sitrep.AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(object_id));
+        sitrep.AddVariable(VarText::PLANET_ID_TAG,     object_id);
 
     } else if (TemporaryPtr<const Building> building = boost::dynamic_pointer_cast<const Building>(obj)) {
         if (building->Unowned())
             sitrep = SitRepEntry(UserStringNop("SITREP_UNOWNED_BUILDING_DESTROYED_ON_PLANET_AT_SYSTEM"), "icons/sitrep/combat_destroyed.png");
         else
             sitrep = SitRepEntry(UserStringNop("SITREP_BUILDING_DESTROYED_ON_PLANET_AT_SYSTEM"), "icons/sitrep/combat_destroyed.png");
-        sitrep.AddVariable(VarText::BUILDING_ID_TAG,   boost::lexical_cast<std::string>(object_id));
-        sitrep.AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(building->PlanetID()));
+        sitrep.AddVariable(VarText::BUILDING_ID_TAG,   object_id);
+        sitrep.AddVariable(VarText::PLANET_ID_TAG,     building->PlanetID());
     } else {
         sitrep = GenericCombatDestroyedObjectSitrep(combat_system_id);
     }
 
-    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(obj->Owner()));
-    sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(combat_system_id));
+    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     obj->Owner());
+    sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     combat_system_id);
 
     return sitrep;
 }
 
 SitRepEntry CreatePlanetStarvedToDeathSitRep(int planet_id) {
     SitRepEntry sitrep(UserStringNop("SITREP_PLANET_LOST_STARVED_TO_DEATH"), "icons/sitrep/planet_starved.png");
-    sitrep.AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(planet_id));
+    sitrep.AddVariable(VarText::PLANET_ID_TAG,     planet_id);
     return sitrep;
 }
 
 SitRepEntry CreatePlanetColonizedSitRep(int planet_id) {
     SitRepEntry sitrep(UserStringNop("SITREP_PLANET_COLONIZED"), "icons/sitrep/planet_colonized.png");
-    sitrep.AddVariable(VarText::PLANET_ID_TAG,     boost::lexical_cast<std::string>(planet_id));
+    sitrep.AddVariable(VarText::PLANET_ID_TAG,     planet_id);
     return sitrep;
 }
 
@@ -271,68 +261,68 @@ SitRepEntry CreateFleetArrivedAtDestinationSitRep(int system_id, int fleet_id, i
     //a system description, and a message template into which both are substituted.
     if (!fleet) {
         SitRepEntry sitrep(UserStringNop("SITREP_FLEET_ARRIVED_AT_SYSTEM"), "icons/sitrep/fleet_arrived.png");
-        sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  boost::lexical_cast<std::string>(system_id));
-        sitrep.AddVariable(VarText::FLEET_ID_TAG,   boost::lexical_cast<std::string>(fleet_id));
+        sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  system_id);
+        sitrep.AddVariable(VarText::FLEET_ID_TAG,   fleet_id);
         return sitrep;
     } else if (fleet->Unowned() && fleet->HasMonsters()) {
         if (fleet->NumShips() == 1) {
             SitRepEntry sitrep(UserStringNop("SITREP_MONSTER_SHIP_ARRIVED_AT_DESTINATION"), "icons/sitrep/fleet_arrived.png");
-            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(system_id));
-            sitrep.AddVariable(VarText::FLEET_ID_TAG,      boost::lexical_cast<std::string>(fleet_id));
+            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     system_id);
+            sitrep.AddVariable(VarText::FLEET_ID_TAG,      fleet_id);
             int ship_id = *fleet->ShipIDs().begin();
-            sitrep.AddVariable(VarText::SHIP_ID_TAG,       boost::lexical_cast<std::string>(ship_id));
+            sitrep.AddVariable(VarText::SHIP_ID_TAG,       ship_id);
             if (TemporaryPtr<const Ship> ship = GetShip(ship_id))
-                sitrep.AddVariable(VarText::DESIGN_ID_TAG, boost::lexical_cast<std::string>(ship->DesignID()));
+                sitrep.AddVariable(VarText::DESIGN_ID_TAG, ship->DesignID());
             return sitrep;
         } else {
             SitRepEntry sitrep(UserStringNop("SITREP_MONSTER_FLEET_ARRIVED_AT_DESTINATION"), "icons/sitrep/fleet_arrived.png");
-            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  boost::lexical_cast<std::string>(system_id));
-            sitrep.AddVariable(VarText::FLEET_ID_TAG,   boost::lexical_cast<std::string>(fleet_id));
-            sitrep.AddVariable(VarText::RAW_TEXT_TAG,   boost::lexical_cast<std::string>(fleet->NumShips()));
+            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  system_id);
+            sitrep.AddVariable(VarText::FLEET_ID_TAG,   fleet_id);
+            sitrep.AddVariable(VarText::RAW_TEXT_TAG,   fleet->NumShips());
             return sitrep;
         }
     } else if (fleet->Unowned()) {
         SitRepEntry sitrep(UserStringNop("SITREP_FLEET_ARRIVED_AT_DESTINATION"), "icons/sitrep/fleet_arrived.png");
-        sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  boost::lexical_cast<std::string>(system_id));
-        sitrep.AddVariable(VarText::FLEET_ID_TAG,   boost::lexical_cast<std::string>(fleet_id));
-        sitrep.AddVariable(VarText::RAW_TEXT_TAG,   boost::lexical_cast<std::string>(fleet->NumShips()));
+        sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  system_id);
+        sitrep.AddVariable(VarText::FLEET_ID_TAG,   fleet_id);
+        sitrep.AddVariable(VarText::RAW_TEXT_TAG,   fleet->NumShips());
         return sitrep;
     } else if (fleet->OwnedBy(recipient_empire_id)) {
         if (fleet->NumShips() == 1) {
             SitRepEntry sitrep(UserStringNop("SITREP_OWN_SHIP_ARRIVED_AT_DESTINATION"), "icons/sitrep/fleet_arrived.png");
-            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(system_id));
-            sitrep.AddVariable(VarText::FLEET_ID_TAG,      boost::lexical_cast<std::string>(fleet_id));
-            sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(fleet->Owner()));
+            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     system_id);
+            sitrep.AddVariable(VarText::FLEET_ID_TAG,      fleet_id);
+            sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     fleet->Owner());
             int ship_id = *fleet->ShipIDs().begin();
-            sitrep.AddVariable(VarText::SHIP_ID_TAG,       boost::lexical_cast<std::string>(ship_id));
+            sitrep.AddVariable(VarText::SHIP_ID_TAG,       ship_id);
             if (TemporaryPtr<const Ship> ship = GetShip(ship_id))
-                sitrep.AddVariable(VarText::DESIGN_ID_TAG, boost::lexical_cast<std::string>(ship->DesignID()));
+                sitrep.AddVariable(VarText::DESIGN_ID_TAG, ship->DesignID());
             return sitrep;
         } else {
             SitRepEntry sitrep(UserStringNop("SITREP_OWN_FLEET_ARRIVED_AT_DESTINATION"), "icons/sitrep/fleet_arrived.png");
-            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  boost::lexical_cast<std::string>(system_id));
-            sitrep.AddVariable(VarText::FLEET_ID_TAG,   boost::lexical_cast<std::string>(fleet_id));
-            sitrep.AddVariable(VarText::EMPIRE_ID_TAG,  boost::lexical_cast<std::string>(fleet->Owner()));
-            sitrep.AddVariable(VarText::RAW_TEXT_TAG,   boost::lexical_cast<std::string>(fleet->NumShips()));
+            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  system_id);
+            sitrep.AddVariable(VarText::FLEET_ID_TAG,   fleet_id);
+            sitrep.AddVariable(VarText::EMPIRE_ID_TAG,  fleet->Owner());
+            sitrep.AddVariable(VarText::RAW_TEXT_TAG,   fleet->NumShips());
             return sitrep;
         }
     } else {
         if (fleet->NumShips() == 1) {
             SitRepEntry sitrep(UserStringNop("SITREP_FOREIGN_SHIP_ARRIVED_AT_DESTINATION"), "icons/sitrep/fleet_arrived.png");
-            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     boost::lexical_cast<std::string>(system_id));
-            sitrep.AddVariable(VarText::FLEET_ID_TAG,      boost::lexical_cast<std::string>(fleet_id));
-            sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(fleet->Owner()));
+            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,     system_id);
+            sitrep.AddVariable(VarText::FLEET_ID_TAG,      fleet_id);
+            sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     fleet->Owner());
             int ship_id = *fleet->ShipIDs().begin();
-            sitrep.AddVariable(VarText::SHIP_ID_TAG,       boost::lexical_cast<std::string>(ship_id));
+            sitrep.AddVariable(VarText::SHIP_ID_TAG,       ship_id);
             if (TemporaryPtr<const Ship> ship = GetShip(ship_id))
-                sitrep.AddVariable(VarText::DESIGN_ID_TAG, boost::lexical_cast<std::string>(ship->DesignID()));
+                sitrep.AddVariable(VarText::DESIGN_ID_TAG, ship->DesignID());
             return sitrep;
         } else {
             SitRepEntry sitrep(UserStringNop("SITREP_FOREIGN_FLEET_ARRIVED_AT_DESTINATION"), "icons/sitrep/fleet_arrived.png");
-            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  boost::lexical_cast<std::string>(system_id));
-            sitrep.AddVariable(VarText::FLEET_ID_TAG,   boost::lexical_cast<std::string>(fleet_id));
-            sitrep.AddVariable(VarText::EMPIRE_ID_TAG,  boost::lexical_cast<std::string>(fleet->Owner()));
-            sitrep.AddVariable(VarText::RAW_TEXT_TAG,   boost::lexical_cast<std::string>(fleet->NumShips()));
+            sitrep.AddVariable(VarText::SYSTEM_ID_TAG,  system_id);
+            sitrep.AddVariable(VarText::FLEET_ID_TAG,   fleet_id);
+            sitrep.AddVariable(VarText::EMPIRE_ID_TAG,  fleet->Owner());
+            sitrep.AddVariable(VarText::RAW_TEXT_TAG,   fleet->NumShips());
             return sitrep;
         }
     }
@@ -340,14 +330,14 @@ SitRepEntry CreateFleetArrivedAtDestinationSitRep(int system_id, int fleet_id, i
 
 SitRepEntry CreateEmpireEliminatedSitRep(int empire_id) {
     SitRepEntry sitrep(UserStringNop("SITREP_EMPIRE_ELIMINATED"), "icons/sitrep/empire_eliminated.png");
-    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(empire_id));
+    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     empire_id);
     return sitrep;
 }
 
 SitRepEntry CreateVictorySitRep(const std::string& reason_string, int empire_id) {
     SitRepEntry sitrep(UserStringNop("SITREP_VICTORY"), "icons/sitrep/victory.png");
     sitrep.AddVariable(VarText::TEXT_TAG,          reason_string);
-    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     boost::lexical_cast<std::string>(empire_id));
+    sitrep.AddVariable(VarText::EMPIRE_ID_TAG,     empire_id);
     return sitrep;
 }
 
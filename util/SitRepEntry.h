@@ -20,7 +20,7 @@ public:
 
     /** Accessors */ //@{
     int                 GetDataIDNumber(const std::string& tag) const;
-    const std::string&  GetDataString(const std::string& tag) const;
+    std::string         GetDataString(const std::string& tag) const;
     int                 GetTurn() const { return m_turn; }
     const std::string&  GetIcon() const { return m_icon; }
     std::string         Dump() const;
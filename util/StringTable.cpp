@@ -10,6 +10,7 @@
 #include <boost/algorithm/string/replace.hpp>
 
 #include <iostream>
+#include <map>
 
 
 // static(s)
@@ -23,7 +24,14 @@ StringTable_::StringTable_():
 
 StringTable_::StringTable_(const std::string& filename, const StringTable_* lookups_fallback_table /* = 0 */):
     m_filename(filename)
-{ Load(lookups_fallback_table); }
+{
+    Load(lookups_fallback_table);
+    // merge in fallback strings for indices not defined by this table's file,
+    // so that lookups don't need to fall back to another table.  insert does
+    // not replace existing entries.
+    if (lookups_fallback_table)
+        m_strings.insert(lookups_fallback_table->GetStrings().begin(), lookups_fallback_table->GetStrings().end());
+}
 
 StringTable_::~StringTable_()
 {}
@@ -36,7 +44,7 @@ bool StringTable_::Empty() const
 
 const std::string& StringTable_::operator[] (const std::string& index) const {
     static std::string error_retval;
-    std::map<std::string, std::string>::const_iterator it = m_strings.find(index);
+    boost::unordered_map<std::string, std::string>::const_iterator it = m_strings.find(index);
     return it == m_strings.end() ? error_retval = S_ERROR_STRING + index : it->second;
 }
 
@@ -73,7 +81,7 @@ void StringTable_::Load(const StringTable_* lookups_fallback_table /* = 0 */) {
         ErrorLogger() << "StringTable_::Load failed to read file at path: " << path.string();
         return;
     }
-    std::map<std::string, std::string> fallback_lookup_strings;
+    boost::unordered_map<std::string, std::string> fallback_lookup_strings;
     std::string fallback_table_file;
     if (lookups_fallback_table) {
         fallback_table_file = lookups_fallback_table->Filename();
@@ -160,7 +168,7 @@ void StringTable_::Load(const StringTable_* lookups_fallback_table /* = 0 */) {
 
     if (well_formed) {
         // recursively expand keys -- replace [[KEY]] by the text resulting from expanding everything in the definition for KEY
-        for (std::map<std::string, std::string>::iterator map_it = m_strings.begin();
+        for (boost::unordered_map<std::string, std::string>::iterator map_it = m_strings.begin();
              map_it != m_strings.end(); ++map_it)
         {
             //DebugLogger() << "Checking key expansion for: " << map_it->first;
@@ -196,7 +204,7 @@ void StringTable_::Load(const StringTable_* lookups_fallback_table /* = 0 */) {
                 if (cyclic_reference_check.find(match[1]) == cyclic_reference_check.end()) {
                     //DebugLogger() << "Pushing to cyclic ref check: " << match[1];
                     cyclic_reference_check[match[1]] = position + match.length();
-                    std::map<std::string, std::string>::iterator map_lookup_it = m_strings.find(match[1]);
+                    boost::unordered_map<std::string, std::string>::iterator map_lookup_it = m_strings.find(match[1]);
                     bool foundmatch = map_lookup_it != m_strings.end();
                     if (!foundmatch && lookups_fallback_table) {
                         DebugLogger() << "Key expansion: " << match[1] << " not found in primary stringtable: " << m_filename 
@@ -231,14 +239,14 @@ void StringTable_::Load(const StringTable_* lookups_fallback_table /* = 0 */) {
         }
 
         // nonrecursively replace references -- convert [[type REF]] to <type REF>string for REF</type>
-        for (std::map<std::string, std::string>::iterator map_it = m_strings.begin();
+        for (boost::unordered_map<std::string, std::string>::iterator map_it = m_strings.begin();
              map_it != m_strings.end(); ++map_it)
         {
             std::size_t position = 0; // position in the definition string, past the already processed part
             smatch match;
             while (regex_search(map_it->second.begin() + position, map_it->second.end(), match, REFERENCE)) {
                 position += match.position();
-                std::map<std::string, std::string>::iterator map_lookup_it = m_strings.find(match[2]);
+                boost::unordered_map<std::string, std::string>::iterator map_lookup_it = m_strings.find(match[2]);
                 bool foundmatch = map_lookup_it != m_strings.end();
                 if (!foundmatch && lookups_fallback_table) {
                     DebugLogger() << "Key reference: " << match[2] << " not found in primary stringtable: " << m_filename 
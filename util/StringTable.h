@@ -3,8 +3,9 @@
 #ifndef StringTable__h_
 #define StringTable__h_
 
+#include <boost/unordered_map.hpp>
+
 #include <string>
-#include <map>
 
 // HACK! StringTable is renamed to StringTable_ because freeimage defines
 // a class StringTable too. If both are named identically, static linking
@@ -52,7 +53,9 @@ public:
     StringTable_();  //!< default construction, uses S_DEFAULT_FILENAME
 
     //! @param filename A file containing the data for this StringTable_
-    //! @param lookups_fallback_table A StringTable_ to be used as fallback expansions lookup
+    //! @param lookups_fallback_table A StringTable_ to be used as fallback expansions lookup.
+    //!        Its strings are also copied into this table for any index this table's file does
+    //!        not define, so that lookups never need to consult the fallback table.
     StringTable_(const std::string& filename, const StringTable_* lookups_fallback_table = 0);   //!< construct a StringTable_ from the given filename
 
     ~StringTable_();                             //!< default destructor
@@ -90,7 +93,7 @@ private:
     //! @param lookups_fallback_table A StringTable_ to be used as fallback expansions lookup
     void Load(const StringTable_* lookups_fallback_table = 0);    //!< Loads the String table file from m_filename
 
-    const std::map<std::string, std::string>& GetStrings() const {return m_strings;}    //!< returns a const reference to the strings in this table
+    const boost::unordered_map<std::string, std::string>& GetStrings() const {return m_strings;}    //!< returns a const reference to the strings in this table
 
     //!@}
 
@@ -98,7 +101,7 @@ private:
     //!@{
     std::string m_filename;    //!< the name of the file this StringTable_ was constructed with
     std::string m_language;    //!< A string containing the name of the language used
-    std::map<std::string, std::string> m_strings;  //!< The strings in the table
+    boost::unordered_map<std::string, std::string> m_strings;  //!< The strings in the table
     //!@}
 };
 
@@ -9,7 +9,7 @@
 #include "Logger.h"
 
 #include <boost/static_assert.hpp>
-#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/spirit/include/classic.hpp>
 
 #include <map>
@@ -36,41 +36,34 @@ namespace {
     ////////////////////////////////////////
 
     /// Surround content with approprite tags based on tag_of
-    std::string WithTags(const std::string& content, const std::string& tag, const XMLElement& data) {
-        std::string open_tag = "<" + tag + " " + data.Attribute("value") + ">";
+    std::string WithTags(const std::string& content, const std::string& tag, const VarText::Variable& data) {
+        std::string open_tag = "<" + tag + " " + data.ValueString() + ">";
         std::string close_tag = "</" + tag + ">";
         return open_tag + content + close_tag;
     }
 
     /// The signature of functions that generate substitution strings for
     /// tags.
-    typedef std::string (*TagString)(const XMLElement& data, const std::string& tag, bool& valid);
+    typedef std::string (*TagString)(const VarText::Variable& data, const std::string& tag, bool& valid);
 
     /// Get string substitute for a translated text tag
-    std::string TextString(const XMLElement& data, const std::string& tag, bool& valid) {
-        const std::string& text = data.Attribute("value");
-        return UserString(text);
-    }
+    std::string TextString(const VarText::Variable& data, const std::string& tag, bool& valid)
+    { return UserString(data.ValueString()); }
 
     /// Get string substitute for a raw text tag
-    std::string RawTextString(const XMLElement& data, const std::string& tag, bool& valid) {
-        const std::string& text = data.Attribute("value");
-        return text;
-    }
+    std::string RawTextString(const VarText::Variable& data, const std::string& tag, bool& valid)
+    { return data.ValueString(); }
 
     ///Get string substitute for a tag that is a universe object
-    std::string UniverseObjectString(const XMLElement& data, const std::string& tag, bool& valid) {
-        int object_id = INVALID_OBJECT_ID;
-        try {
-            object_id = boost::lexical_cast<int>(data.Attribute("value"));
-        } catch (const std::exception&) {
-            ErrorLogger() << "UniverseObjectString couldn't cast \"" << data.Attribute("value") << "\" to int for object ID.";
+    std::string UniverseObjectString(const VarText::Variable& data, const std::string& tag, bool& valid) {
+        if (!data.is_id) {
+            ErrorLogger() << "UniverseObjectString couldn't cast \"" << data.text << "\" to int for object ID.";
             valid = false;
             return UserString("ERROR");
         }
-        TemporaryPtr<const UniverseObject> obj = GetUniverseObject(object_id);
+        TemporaryPtr<const UniverseObject> obj = GetUniverseObject(data.id);
         if (!obj) {
-            //ErrorLogger() << "UniverseObjectString couldn't get object with ID " << object_id;
+            //ErrorLogger() << "UniverseObjectString couldn't get object with ID " << data.id;
             valid = false;
             return UserString("ERROR");
         }
@@ -79,22 +72,19 @@ namespace {
     }
 
     /// combat links always just labelled "Combat"; don't need to look up details
-    std::string CombatLogString(const XMLElement& data, const std::string& tag, bool& valid)
+    std::string CombatLogString(const VarText::Variable& data, const std::string& tag, bool& valid)
     { return WithTags(UserString("COMBAT"), tag, data); }
 
     /// Returns substitution string for a ship design tag
-    std::string ShipDesignString(const XMLElement& data, const std::string& tag, bool& valid) {
-        int design_id = ShipDesign::INVALID_DESIGN_ID;
-        try {
-            design_id = boost::lexical_cast<int>(data.Attribute("value"));
-        } catch (const std::exception&) {
-            ErrorLogger() << "SubstituteAndAppend couldn't cast \"" << data.Attribute("value") << "\" to int for ship design ID.";
+    std::string ShipDesignString(const VarText::Variable& data, const std::string& tag, bool& valid) {
+        if (!data.is_id) {
+            ErrorLogger() << "SubstituteAndAppend couldn't cast \"" << data.text << "\" to int for ship design ID.";
             valid = false;
             return UserString("ERROR");
         }
-        const ShipDesign* design = GetShipDesign(design_id);
+        const ShipDesign* design = GetShipDesign(data.id);
         if (!design) {
-            ErrorLogger() << "SubstituteAndAppend couldn't get ship design with ID " << design_id;
+            ErrorLogger() << "SubstituteAndAppend couldn't get ship design with ID " << data.id;
             valid = false;
             return UserString("ERROR");
         }
@@ -102,8 +92,8 @@ namespace {
     }
 
     /// Returns substitution string for a predefined ship design tag
-    std::string PredefinedShipDesignString(const XMLElement& data, const std::string& tag, bool& valid) {
-        const std::string& design_name = data.Attribute("value");
+    std::string PredefinedShipDesignString(const VarText::Variable& data, const std::string& tag, bool& valid) {
+        std::string design_name = data.ValueString();
         const ShipDesign* design = GetPredefinedShipDesign(design_name);
         if (!design) {
             ErrorLogger() << "SubstituteAndAppend couldn't get predefined ship design with name " << design_name;
@@ -114,18 +104,15 @@ namespace {
     }
 
     /// Returns substitution string for an empire tag
-    std::string EmpireString(const XMLElement& data, const std::string& tag, bool& valid) {
-        int empire_id = ALL_EMPIRES;
-        try {
-            empire_id = boost::lexical_cast<int>(data.Attribute("value"));
-        } catch (const std::exception&) {
-            ErrorLogger() << "SubstituteAndAppend couldn't cast \"" << data.Attribute("value") << "\" to int for empire ID.";
+    std::string EmpireString(const VarText::Variable& data, const std::string& tag, bool& valid) {
+        if (!data.is_id) {
+            ErrorLogger() << "SubstituteAndAppend couldn't cast \"" << data.text << "\" to int for empire ID.";
             valid = false;
             return UserString("ERROR");
         }
-        const Empire* empire = GetEmpire(empire_id);
+        const Empire* empire = GetEmpire(data.id);
         if (!empire) {
-            ErrorLogger() << "SubstituteAndAppend couldn't get empire with ID " << empire_id;
+            ErrorLogger() << "SubstituteAndAppend couldn't get empire with ID " << data.id;
             valid = false;
             return UserString("ERROR");
         }
@@ -136,8 +123,8 @@ namespace {
     /// Returns translation of name, if Get says
     /// that a thing by that name exists, otherwise ERROR.
     template <typename T,const T* (*GetByName)(const std::string&)>
-    std::string NameString(const XMLElement& data, const std::string& tag, bool& valid) {
-        std::string name = data.Attribute("value");
+    std::string NameString(const VarText::Variable& data, const std::string& tag, bool& valid) {
+        std::string name = data.ValueString();
         if (!GetByName(name)) {
             valid = false;
             return UserString("ERROR");
@@ -182,8 +169,8 @@ namespace {
     /** Converts (first, last) to a string, looks up its value in the Universe,
       * then appends this to the end of a std::string. */
     struct SubstituteAndAppend {
-        SubstituteAndAppend(const XMLElement& variables, std::string& str, bool& valid) :
-            m_variables(variables),
+        SubstituteAndAppend(const VarText& var_text, std::string& str, bool& valid) :
+            m_var_text(var_text),
             m_str(str),
             m_valid(valid)
         {}
@@ -198,33 +185,30 @@ namespace {
             }
 
             // Labelled tokens have the form %tag:label%,  unlabelled are just %tag%
-            std::vector<std::string> pieces;
-            boost::split(pieces, token, boost::is_any_of(LABEL_SEPARATOR));
-
             std::string tag; //< The tag of the token (the type)
             std::string label; //< The label of the token (the kay to fetch data by)
-            if (pieces.size() == 1) {
+            std::string::size_type separator_pos = token.find(LABEL_SEPARATOR);
+            if (separator_pos == std::string::npos) {
                 // No separator. There is only a tag. The tag is the default label
                 tag = token;
                 label = token;
-            } else if(pieces.size() == 2) {
+            } else if (token.find(LABEL_SEPARATOR, separator_pos + 1) == std::string::npos) {
                 // Had a separator
-                tag = pieces[0];
-                label = pieces[1];
+                tag = token.substr(0, separator_pos);
+                label = token.substr(separator_pos + 1);
             }
 
-            // look up child
-            if (!m_variables.ContainsChild(label)) {
+            // look up variable
+            const VarText::Variable* variable = label.empty() ? 0 : m_var_text.FindVariable(label);
+            if (!variable) {
                 m_str += UserString("ERROR");
                 m_valid = false;
                 return;
             }
 
-            const XMLElement& token_elem = m_variables.Child(label);
-
             std::map<std::string, TagString>::const_iterator substituter = SubstitutionMap().find(tag);
             if (substituter != SubstitutionMap().end()) {
-                m_str += substituter->second(token_elem, tag, m_valid);
+                m_str += substituter->second(*variable, tag, m_valid);
             } else {
                 ErrorLogger() << "SubstituteAndAppend::operator(): No substitution scheme defined for tag: " << tag << " from token: " << token;
                 m_str += UserString("ERROR");
@@ -232,7 +216,7 @@ namespace {
             }
         }
 
-        const XMLElement&   m_variables;
+        const VarText&      m_var_text;
         std::string&        m_str;
         bool&               m_valid;
     };
@@ -247,6 +231,18 @@ namespace {
         { m_str += std::string(first, last); }
         std::string& m_str;
     };
+
+    // returns true iff \a str is an optionally signed sequence of decimal
+    // digits, which lexical_cast can convert to an int unless it overflows
+    bool IsIntegerString(const std::string& str) {
+        std::string::size_type start = (!str.empty() && (str[0] == '-' || str[0] == '+')) ? 1 : 0;
+        if (start == str.size())
+            return false;
+        for (std::string::size_type i = start; i < str.size(); ++i)
+            if (str[i] < '0' || str[i] > '9')
+                return false;
+        return true;
+    }
 }
 
 // static(s)
@@ -275,6 +271,47 @@ const std::string VarText::SPECIES_TAG = "species";
 const std::string VarText::FIELD_TYPE_TAG = "fieldtype";
 
 
+VarText::Variable::Variable() :
+    tag(),
+    text(),
+    id(0),
+    is_id(false)
+{}
+
+VarText::Variable::Variable(const std::string& tag_, const std::string& value) :
+    tag(tag_),
+    text(),
+    id(0),
+    is_id(false)
+{
+    // only values that convert back to exactly the same string are stored as
+    // ids, so that ValueString() always returns the original value.  most
+    // values are names rather than numbers, so are checked before converting
+    // to avoid the cost of a failed lexical_cast.
+    try {
+        if (value.size() <= 11 && IsIntegerString(value)) {
+            id = boost::lexical_cast<int>(value);
+            is_id = boost::lexical_cast<std::string>(id) == value;
+        }
+    } catch (const boost::bad_lexical_cast&) {
+        is_id = false;
+    }
+    if (!is_id) {
+        id = 0;
+        text = value;
+    }
+}
+
+VarText::Variable::Variable(const std::string& tag_, int id_) :
+    tag(tag_),
+    text(),
+    id(id_),
+    is_id(true)
+{}
+
+std::string VarText::Variable::ValueString() const
+{ return is_id ? boost::lexical_cast<std::string>(id) : text; }
+
 VarText::VarText() :
     m_template_string(""),
     m_stringtable_lookup_flag(false),
@@ -310,21 +347,28 @@ void VarText::SetTemplateString(const std::string& text, bool stringtable_lookup
 
 std::vector<std::string> VarText::GetVariableTags() const {
     std::vector<std::string> retval;
-    for (XMLElement::const_child_iterator it = m_variables.child_begin(); it != m_variables.child_end(); ++it)
-        retval.push_back(it->Tag());
+    for (std::vector<Variable>::const_iterator it = m_variables.begin(); it != m_variables.end(); ++it)
+        retval.push_back(it->tag);
     return retval;
 }
 
-void VarText::AddVariable(const std::string& tag, const std::string& data) {
-    XMLElement elem(tag);
-    elem.SetAttribute("value", data);
-    m_variables.AppendChild(elem);
+void VarText::AddVariable(const std::string& tag, const std::string& data)
+{ m_variables.push_back(Variable(tag, data)); }
+
+void VarText::AddVariable(const std::string& tag, int id)
+{ m_variables.push_back(Variable(tag, id)); }
+
+const VarText::Variable* VarText::FindVariable(const std::string& tag) const {
+    for (std::vector<Variable>::const_iterator it = m_variables.begin(); it != m_variables.end(); ++it)
+        if (it->tag == tag)
+            return &*it;
+    return 0;
 }
 
 void VarText::GenerateVarText() const {
     // generate a string complete with substituted variables and hyperlinks
     // the procedure here is to replace any tokens within %% with variables of
-    // the same name in the SitRep XML data
+    // the same name in the SitRep data
     m_text.clear();
     m_validated = true;
     if (m_template_string.empty())
@@ -336,7 +380,7 @@ void VarText::GenerateVarText() const {
     // set up parser
     using namespace boost::spirit::classic;
     rule<> token = *(anychar_p - space_p - END_VAR.c_str());
-    rule<> var = START_VAR.c_str() >> token[SubstituteAndAppend(m_variables, m_text, m_validated)] >> END_VAR.c_str();
+    rule<> var = START_VAR.c_str() >> token[SubstituteAndAppend(*this, m_text, m_validated)] >> END_VAR.c_str();
     rule<> non_var = anychar_p - START_VAR.c_str();
 
     // parse and substitute variables
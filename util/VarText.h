@@ -8,13 +8,17 @@
 
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 
 #include <string>
+#include <vector>
 
 #include "Export.h"
 
 /** VarText is a string tagged with variable names which are substituded with
-  * actual data at runtime. The variables are stored in a XML element tree.
+  * actual data at runtime. The variables are stored as a list of tagged ids
+  * and strings.
   * 
   * The format for the VarText template string is as follows:
   * use % as delimiters for the variable. For example: The planet %planet% has
@@ -25,7 +29,7 @@
   * 
   * If you need to use more than one item of the same type, you must label
   * the tags. For example: %planet:my_planet% crashed into %planet:other_planet%.
-  * That will look for the xml elements "my_planet" and "other_planet" and
+  * That will look for the variables "my_planet" and "other_planet" and
   * do the planet lookup for them.
   *
   * An example of VarText implementation are SitReps. They are created by the
@@ -34,6 +38,8 @@
   */
 class FO_COMMON_API VarText {
 public:
+    struct Variable;
+
     /** \name Structors */ //@{
     VarText();
     explicit VarText(const std::string& template_string, bool stringtable_lookup_template = true);
@@ -44,11 +50,13 @@ public:
     bool                        Validate() const;       //!< Does text generation succeed without any errors occurring?
     const std::string&          GetTemplateString() const   { return m_template_string; }
     std::vector<std::string>    GetVariableTags() const;//!< returns a list of tags for the variables this vartext has
+    const Variable*             FindVariable(const std::string& tag) const; //!< returns the variable with tag \a tag, or 0 if there is none
     //@}
 
     /** \name Mutators */ //@{
     void                        SetTemplateString(const std::string& text, bool stringtable_lookup_template = true);
     void                        AddVariable(const std::string& tag, const std::string& data);
+    void                        AddVariable(const std::string& tag, int id);    //!< adds a variable whose value is the id of an object, empire, design, etc.
     //@}
 
     /** Tag strings that are recognized and replaced in VarText. */
@@ -76,6 +84,27 @@ public:
     static const std::string SPECIES_TAG;
     static const std::string FIELD_TYPE_TAG;
 
+    /** A variable to be substituted into the template string.  Values that
+      * are integers, such as object or empire ids, are stored as such, so
+      * that rendering the text doesn't need to convert them from strings. */
+    struct FO_COMMON_API Variable {
+        Variable();
+        Variable(const std::string& tag_, const std::string& value);    ///< stores \a value as an id if it is the decimal representation of one
+        Variable(const std::string& tag_, int id_);
+
+        std::string ValueString() const;    ///< returns the value as a string, whether or not it is an id
+
+        std::string tag;
+        std::string text;   ///< the value of non-id variables
+        int         id;     ///< the value of id variables
+        bool        is_id;
+
+    private:
+        friend class boost::serialization::access;
+        template <class Archive>
+        void serialize(Archive& ar, const unsigned int version);
+    };
+
 protected:
     /** Combines the template with the variables contained in object to
       * create a string with variables replaced with text. */
@@ -83,7 +112,7 @@ protected:
 
     std::string         m_template_string;          ///< the template string for this VarText, into which variables are substituted to render the text as user-readable
     bool                m_stringtable_lookup_flag;  ///< should the template string be looked up in the stringtable prior to substitution for variables?
-    XMLElement          m_variables;                ///< the data about variables to be substitued into the template string to render the VarText
+    std::vector<Variable>   m_variables;            ///< the data about variables to be substitued into the template string to render the VarText
     mutable std::string m_text;                     ///< the user-readable rendered text with substitutions made
     mutable bool        m_validated;                ///< did vartext generation succeed without problems?
 
@@ -93,24 +122,34 @@ private:
     void serialize(Archive& ar, const unsigned int version);
 };
 
+BOOST_CLASS_VERSION(VarText, 1);
+
 // template implementations
+template <class Archive>
+void VarText::Variable::serialize(Archive& ar, const unsigned int version)
+{
+    ar  & BOOST_SERIALIZATION_NVP(tag)
+        & BOOST_SERIALIZATION_NVP(is_id);
+    if (is_id)
+        ar  & BOOST_SERIALIZATION_NVP(id);
+    else
+        ar  & BOOST_SERIALIZATION_NVP(text);
+}
+
 template <class Archive>
 void VarText::serialize(Archive& ar, const unsigned int version)
 {
     ar  & BOOST_SERIALIZATION_NVP(m_template_string)
         & BOOST_SERIALIZATION_NVP(m_stringtable_lookup_flag);
 
-
-    std::vector<std::pair<std::string, std::string> > variables;
-
-    if (Archive::is_saving::value) {
-        for (XMLElement::child_iterator it = m_variables.child_begin(); it != m_variables.child_end(); ++it) {
-            variables.push_back(std::make_pair(it->Tag(), it->Attribute("value")));
-        }
+    if (version >= 1) {
+        ar  & BOOST_SERIALIZATION_NVP(m_variables);
+        return;
     }
 
+    // older archives store all variables as tag and value strings
+    std::vector<std::pair<std::string, std::string> > variables;
     ar  & BOOST_SERIALIZATION_NVP(variables);
-
     if (Archive::is_loading::value) {
         for (unsigned int i = 0; i < variables.size(); ++i) {
             AddVariable(variables[i].first, variables[i].second);
@@ -19,6 +19,20 @@ namespace {
 
     std::map<std::string, const StringTable_*> stringtables;
 
+    // the option-configured stringtable, or 0 if it needs to be looked up
+    // again because the option has changed or the tables were flushed
+    const StringTable_* current_stringtable = 0;
+    boost::signals2::connection stringtable_filename_connection;
+
+    // incremented whenever the current stringtable may have changed, so that
+    // UserStringKeys know to look up their strings again
+    unsigned int stringtable_generation = 1;
+
+    void ResetCurrentStringTable() {
+        current_stringtable = 0;
+        ++stringtable_generation;
+    }
+
     const StringTable_& GetStringTable(std::string stringtable_filename = "") {
         // get option-configured stringtable if no filename specified
         if (stringtable_filename.empty())
@@ -47,17 +61,46 @@ namespace {
         return *table;
     }
 
-    const StringTable_& GetDefaultStringTable()
-    { return GetStringTable(GetDefaultStringTableFileName()); }
+    /** Returns the option-configured stringtable.  Unlike GetStringTable(),
+      * this does not read options, build any paths or search the loaded
+      * tables, unless the configured filename has changed or the tables were
+      * flushed since the last call. */
+    const StringTable_& GetCurrentStringTable() {
+        if (!current_stringtable) {
+            current_stringtable = &GetStringTable();
+            if (!stringtable_filename_connection.connected())
+                stringtable_filename_connection = GetOptionsDB().OptionChangedSignal("stringtable-filename").connect(
+                    &ResetCurrentStringTable);
+        }
+        return *current_stringtable;
+    }
 }
 
-void FlushLoadedStringTables()
-{ stringtables.clear(); }
+void FlushLoadedStringTables() {
+    stringtables.clear();
+    ResetCurrentStringTable();
+}
 
-const std::string& UserString(const std::string& str) {
-    if (GetStringTable().StringExists(str))
-        return GetStringTable().String(str);
-    return GetDefaultStringTable().String(str);
+// The current stringtable includes the default stringtable's strings for any
+// keys it does not define, so only one lookup is needed.
+const std::string& UserString(const std::string& str)
+{ return GetCurrentStringTable().String(str); }
+
+UserStringKey::UserStringKey(const std::string& key) :
+    m_key(key),
+    m_string(0),
+    m_generation(0)
+{}
+
+const std::string& UserString(const UserStringKey& key) {
+    const StringTable_& table = GetCurrentStringTable();
+    if (key.m_generation != stringtable_generation) {
+        // missing keys aren't remembered, as the table's error string for
+        // them is not stable
+        key.m_string = table.StringExists(key.m_key) ? &table.String(key.m_key) : 0;
+        key.m_generation = stringtable_generation;
+    }
+    return key.m_string ? *key.m_string : table.String(key.m_key);
 }
 
 void UserStringList(const std::string& str_list, std::list<std::string>& strings) {
@@ -68,11 +111,8 @@ void UserStringList(const std::string& str_list, std::list<std::string>& strings
     }
 }
 
-bool UserStringExists(const std::string& str) {
-    if (GetStringTable().StringExists(str))
-        return true;
-    return GetDefaultStringTable().StringExists(str);
-}
+bool UserStringExists(const std::string& str)
+{ return GetCurrentStringTable().StringExists(str); }
 
 boost::format FlexibleFormat(const std::string &string_to_format) {
     try {
@@ -88,7 +128,7 @@ boost::format FlexibleFormat(const std::string &string_to_format) {
 }
 
 const std::string& Language()
-{ return GetStringTable().Language(); }
+{ return GetCurrentStringTable().Language(); }
 
 std::string RomanNumber(unsigned int n) {
     //letter pattern (N) and the associated values (V)
@@ -135,8 +175,10 @@ std::string DoubleToString(double val, int digits, bool always_show_sign) {
     digits = std::max(digits, 2);
 
     // default result for sentinel value
-    if (val == UNKNOWN_UI_DISPLAY_VALUE)
-        return UserString("UNKNOWN_VALUE_SYMBOL");
+    if (val == UNKNOWN_UI_DISPLAY_VALUE) {
+        static const UserStringKey UNKNOWN_VALUE_SYMBOL_KEY("UNKNOWN_VALUE_SYMBOL");
+        return UserString(UNKNOWN_VALUE_SYMBOL_KEY);
+    }
 
     double mag = std::abs(val);
 
@@ -12,6 +12,32 @@
 /** Returns a language-specific string for the key-string \a str */
 FO_COMMON_API const std::string& UserString(const std::string& str);
 
+/** A key-string for UserString() whose string is looked up once for each
+  * stringtable, rather than on every call.  Intended for constant keys that
+  * are used often, declared as statics:
+  * <pre>
+  * static const UserStringKey OK_KEY("OK");
+  * const std::string& ok_text = UserString(OK_KEY);
+  * </pre>
+  * The looked up string is remembered in the key without synchronization,
+  * so a key must only be used from the main thread. */
+class FO_COMMON_API UserStringKey {
+public:
+    explicit UserStringKey(const std::string& key);
+
+    const std::string&  Key() const { return m_key; }
+
+private:
+    std::string                 m_key;
+    mutable const std::string*  m_string;       ///< string for m_key in the stringtable of m_generation, or 0 if none
+    mutable unsigned int        m_generation;
+
+    friend FO_COMMON_API const std::string& UserString(const UserStringKey& key);
+};
+
+/** Returns a language-specific string for the key-string \a key */
+FO_COMMON_API const std::string& UserString(const UserStringKey& key);
+
 /** Returns a language-specific list of strings for the key-string \a str_list */
 FO_COMMON_API void UserStringList(const std::string& str_list, std::list<std::string>& strings);
 